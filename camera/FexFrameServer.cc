@@ -15,6 +15,7 @@
 
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
 #include <sys/uio.h>
@@ -46,6 +47,18 @@ FexFrameServer::FexFrameServer(const Src& src) :
 #ifdef DBUG
   _tinput.tv_sec = _tinput.tv_nsec = 0;
 #endif
+  //
+  //  The rows of large frames may be split among a few threads for the
+  //  moments; off unless asked for, since the fetch thread usually keeps up
+  //
+  const char* env = getenv("PDS_FEX_MOMENT_THREADS");
+  if (env) {
+    unsigned n = strtoul(env,NULL,0);
+    if (n != TwoDMoments::threads()) {
+      TwoDMoments::setThreads(n);
+      printf("FexFrameServer computing moments in %u threads\n",TwoDMoments::threads());
+    }
+  }
 }
 
 FexFrameServer::~FexFrameServer()
@@ -1,33 +1,160 @@
 #include "TwoDMoments.hh"
 
+#include "pds/service/Task.hh"
+#include "pds/service/TaskObject.hh"
+#include "pds/service/Routine.hh"
+#include "pds/service/Semaphore.hh"
+
+#include <vector>
+
 using namespace Pds;
 
+static bool cpu_has_avx2()
+{
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+static bool _has_avx2 = cpu_has_avx2();
+static bool _use_simd = _has_avx2;
+
+static TwoDMoments moments(unsigned cols,
+			   unsigned colStart, unsigned colEnd,
+			   unsigned rowStart, unsigned rowEnd,
+			   unsigned short offset,
+			   unsigned short threshold,
+			   const unsigned short* src)
+{
+#if defined(__x86_64__)
+  if (_use_simd)
+    return twoDMoments_avx2(cols, colStart, colEnd, rowStart, rowEnd, offset, threshold, src);
+#endif
+  return twoDMoments_ref(cols, colStart, colEnd, rowStart, rowEnd, offset, threshold, src);
+}
+
+namespace {
+  //
+  //  The rows of one frame split into bands to be summed concurrently
+  //
+  class RowBatch {
+  public:
+    enum { MaxBands = 64 };
+    RowBatch(unsigned cols, unsigned colStart, unsigned colEnd,
+	     unsigned rowStart, unsigned rowEnd, unsigned nbands,
+	     unsigned short offset, unsigned short threshold,
+	     const unsigned short* src) :
+      _cols(cols), _colStart(colStart), _colEnd(colEnd),
+      _rowStart(rowStart), _rowEnd(rowEnd), _nbands(nbands),
+      _offset(offset), _threshold(threshold), _src(src),
+      _next(0), _sem(Semaphore::EMPTY) {}
+  public:
+    //  Sums bands until none remain
+    void run() {
+      unsigned i;
+      while( (i = __sync_fetch_and_add(&_next,1)) < _nbands ) {
+	unsigned rows = _rowEnd-_rowStart;
+	_bands[i] = moments(_cols, _colStart, _colEnd,
+			    _rowStart + (i*rows)/_nbands,
+			    _rowStart + ((i+1)*rows)/_nbands,
+			    _offset, _threshold, _src);
+      }
+    }
+    TwoDMoments sum() const {
+      TwoDMoments m;
+      for(unsigned i=0; i<_nbands; i++)
+	m += _bands[i];
+      return m;
+    }
+    Semaphore& sem() { return _sem; }
+  private:
+    unsigned _cols, _colStart, _colEnd;
+    unsigned _rowStart, _rowEnd, _nbands;
+    unsigned short _offset, _threshold;
+    const unsigned short* _src;
+    unsigned    _next;
+    Semaphore   _sem;
+    TwoDMoments _bands[MaxBands];
+  };
+
+  class RowRun : public Routine {
+  public:
+    RowRun(RowBatch& batch) : _batch(batch) {}
+    void routine() { _batch.run(); _batch.sem().give(); delete this; }
+  private:
+    RowBatch& _batch;
+  };
+
+  //
+  //  Helper threads which join the calling thread in summing the bands
+  //  of a batch.
+  //
+  class RowPool {
+  public:
+    RowPool(unsigned nthreads) : _tasks(nthreads-1) {
+      for(unsigned i=0; i<_tasks.size(); i++)
+	_tasks[i] = new Task(TaskObject("CamMom"));
+    }
+    ~RowPool() {
+      for(unsigned i=0; i<_tasks.size(); i++)
+	_tasks[i]->destroy();
+    }
+  public:
+    unsigned threads() const { return _tasks.size()+1; }
+    //  Returns when all bands of the batch are summed
+    void run(RowBatch& batch) {
+      for(unsigned i=0; i<_tasks.size(); i++)
+	_tasks[i]->call(new RowRun(batch));
+      batch.run();
+      for(unsigned i=0; i<_tasks.size(); i++)
+	batch.sem().take();
+    }
+  private:
+    std::vector<Task*> _tasks;
+  };
+}
+
+static RowPool* _pool = 0;
+
+//  Frames smaller than this are not worth waking the helper threads for
+static const unsigned MinPoolPixels = 1<<16;
+static const unsigned MinBandRows   = 16;
+
+void TwoDMoments::_accumulate(unsigned cols,
+			      unsigned colStart, unsigned colEnd,
+			      unsigned rowStart, unsigned rowEnd,
+			      unsigned short offset,
+			      unsigned short threshold,
+			      const unsigned short* src)
+{
+  unsigned rows = rowEnd > rowStart ? rowEnd-rowStart : 0;
+  unsigned npix = colEnd > colStart ? (colEnd-colStart)*rows : 0;
+  if (_pool && npix >= MinPoolPixels) {
+    //  A few bands per thread so that a slow thread doesn't hold up the rest
+    unsigned nbands = 4*_pool->threads();
+    if (nbands > rows/MinBandRows) nbands = rows/MinBandRows;
+    if (nbands > RowBatch::MaxBands) nbands = RowBatch::MaxBands;
+    if (nbands > 1) {
+      RowBatch batch(cols, colStart, colEnd, rowStart, rowEnd, nbands,
+		     offset, threshold, src);
+      _pool->run(batch);
+      *this += batch.sum();
+      return;
+    }
+  }
+  *this += moments(cols, colStart, colEnd, rowStart, rowEnd, offset, threshold, src);
+}
+
 TwoDMoments::TwoDMoments(unsigned cols,
 			 unsigned rows,
 			 unsigned short offset,
 			 const unsigned short* src) :
   _n(0), _x(0), _y(0), _xx(0), _yy(0), _xy(0)
 {
-  for(unsigned k=0; k<rows; k++) {
-    unsigned wsum  = 0;
-    unsigned wxsum = 0;
-    for(unsigned j=0; j<cols; j++) {
-      unsigned short d  = *src++;
-      if (d < offset) continue;
-      d -= offset;
-      unsigned long  dj = d*j;
-      wsum  += d;
-      wxsum += dj;
-      _xx   += dj*j;
-    }
-    _n  += wsum;
-    _x  += wxsum;
-    unsigned long long wk = wsum*k;
-    _y  += wk;
-    _yy += wk*k;
-    unsigned long long wx = wxsum;
-    _xy += wx*k;
-  }
+  _accumulate(cols, 0, cols, 0, rows, offset, offset, src);
 }
 
 TwoDMoments::TwoDMoments(unsigned cols,
@@ -37,29 +164,7 @@ TwoDMoments::TwoDMoments(unsigned cols,
 			 const unsigned short* src) :
   _n(0), _x(0), _y(0), _xx(0), _yy(0), _xy(0)
 {
-  src += rowStart*cols;
-  for(unsigned k=rowStart; k<rowEnd; k++) {
-    unsigned wsum  = 0;
-    unsigned wxsum = 0;
-    src += colStart;
-    for(unsigned j=colStart; j<colEnd; j++) {
-      unsigned short d  = *src++;
-      if (d < offset) continue;
-      d -= offset;
-      unsigned long  dj = d*j;
-      wsum  += d;
-      wxsum += dj;
-      _xx   += dj*j;
-    }
-    src += cols-colEnd;
-    _n  += wsum;
-    _x  += wxsum;
-    unsigned long long wk = wsum*k;
-    _y  += wk;
-    _yy += wk*k;
-    unsigned long long wx = wxsum;
-    _xy += wx*k;
-  }
+  _accumulate(cols, colStart, colEnd, rowStart, rowEnd, offset, offset, src);
 }
 
 TwoDMoments::TwoDMoments(unsigned cols,
@@ -70,25 +175,58 @@ TwoDMoments::TwoDMoments(unsigned cols,
   _n(0), _x(0), _y(0), _xx(0), _yy(0), _xy(0)
 {
   threshold = (offset > threshold) ? offset : threshold;
-  for(unsigned k=0; k<rows; k++) {
-    unsigned wsum  = 0;
-    unsigned wxsum = 0;
-    for(unsigned j=0; j<cols; j++) {
-      unsigned short d  = *src++;
+  _accumulate(cols, 0, cols, 0, rows, offset, threshold, src);
+}
+
+bool TwoDMoments::simd() { return _use_simd; }
+
+void TwoDMoments::useSimd(bool v) { _use_simd = v && _has_avx2; }
+
+unsigned TwoDMoments::threads() { return _pool ? _pool->threads() : 1; }
+
+void TwoDMoments::setThreads(unsigned n)
+{
+  if (_pool) {
+    delete _pool;
+    _pool = 0;
+  }
+  if (n > 1)
+    _pool = new RowPool(n);
+}
+
+//
+//  The row sums are kept in 64 bits, since the column-weighted sum of a
+//  16-bit row of a few thousand pixels exceeds 32 bits.
+//
+TwoDMoments Pds::twoDMoments_ref(unsigned cols,
+				 unsigned colStart, unsigned colEnd,
+				 unsigned rowStart, unsigned rowEnd,
+				 unsigned short offset,
+				 unsigned short threshold,
+				 const unsigned short* src)
+{
+  TwoDMoments m;
+  src += rowStart*cols;
+  for(unsigned k=rowStart; k<rowEnd; k++) {
+    unsigned           wsum  = 0;
+    unsigned long long wxsum = 0;
+    for(unsigned j=colStart; j<colEnd; j++) {
+      unsigned short d  = src[j];
       if (d < threshold) continue;
       d -= offset;
       unsigned long  dj = d*j;
       wsum  += d;
       wxsum += dj;
-      _xx   += dj*j;
+      m._xx += dj*j;
     }
-    _n  += wsum;
-    _x  += wxsum;
-    unsigned long long wk = wsum*k;
-    _y  += wk;
-    _yy += wk*k;
-    unsigned long long wx = wxsum;
-    _xy += wx*k;
+    src += cols;
+    m._n  += wsum;
+    m._x  += wxsum;
+    unsigned long long wk = wsum;
+    wk *= k;
+    m._y  += wk;
+    m._yy += wk*k;
+    m._xy += wxsum*k;
   }
+  return m;
 }
-
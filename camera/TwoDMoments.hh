@@ -3,6 +3,13 @@
 
 namespace Pds {
 
+  //
+  //  The moments n/x/y/xx/yy/xy of the pixels of a frame at or above a
+  //  threshold, less an offset.  The AVX2 kernel is used when the cpu
+  //  supports it, and the rows of large frames may be split among a few
+  //  threads (see setThreads, and PDS_FEX_MOMENT_THREADS for FexFrameServer);
+  //  all give the same sums as the scalar loop.
+  //
   class TwoDMoments {
   public:
     TwoDMoments() : _n(0), _x(0), _y(0), _xx(0), _yy(0), _xy(0) {}
@@ -28,6 +35,24 @@ namespace Pds {
 		const unsigned short* src);
     ~TwoDMoments() {}
 
+  public:
+    TwoDMoments& operator+=(const TwoDMoments&);
+    bool         operator==(const TwoDMoments&) const;
+
+  public:
+    static bool     simd      ();
+    static void     useSimd   (bool);      // only effective if the cpu supports AVX2
+    static unsigned threads   ();
+    static void     setThreads(unsigned);  // not while moments are being computed
+
+  private:
+    void _accumulate(unsigned cols,
+		     unsigned colStart, unsigned colEnd,
+		     unsigned rowStart, unsigned rowEnd,
+		     unsigned short offset,
+		     unsigned short threshold,
+		     const unsigned short* src);
+
   public:
     unsigned long long _n;
     unsigned long long _x;
@@ -36,7 +61,37 @@ namespace Pds {
     unsigned long long _yy;
     unsigned long long _xy;
   };
+
+  //  The moments of rows [rowStart,rowEnd) and columns [colStart,colEnd)
+  //  of a frame "cols" wide, by the scalar loop and the AVX2 kernel
+  TwoDMoments twoDMoments_ref (unsigned cols,
+			       unsigned colStart, unsigned colEnd,
+			       unsigned rowStart, unsigned rowEnd,
+			       unsigned short offset,
+			       unsigned short threshold,
+			       const unsigned short* src);
+  TwoDMoments twoDMoments_avx2(unsigned cols,
+			       unsigned colStart, unsigned colEnd,
+			       unsigned rowStart, unsigned rowEnd,
+			       unsigned short offset,
+			       unsigned short threshold,
+			       const unsigned short* src);
 };
 
-#endif
+inline Pds::TwoDMoments& Pds::TwoDMoments::operator+=(const TwoDMoments& m)
+{
+  _n  += m._n;
+  _x  += m._x;
+  _y  += m._y;
+  _xx += m._xx;
+  _yy += m._yy;
+  _xy += m._xy;
+  return *this;
+}
 
+inline bool Pds::TwoDMoments::operator==(const TwoDMoments& m) const
+{
+  return _n==m._n && _x==m._x && _y==m._y && _xx==m._xx && _yy==m._yy && _xy==m._xy;
+}
+
+#endif
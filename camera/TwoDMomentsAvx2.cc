@@ -0,0 +1,93 @@
+//
+//  The AVX2 kernel of TwoDMoments.  It alone is built for AVX2, and
+//  TwoDMoments only calls it when the cpu supports it.
+//
+#if defined(__x86_64__)
+#include "TwoDMoments.hh"
+
+#pragma GCC target("avx2")
+
+#include <immintrin.h>
+
+using namespace Pds;
+
+static inline unsigned hsum32(__m256i v)
+{
+  __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v,1));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+  return _mm_cvtsi128_si32(s);
+}
+
+static inline unsigned long long hsum64(__m256i v)
+{
+  __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v,1));
+  s = _mm_add_epi64(s, _mm_unpackhi_epi64(s, s));
+  return _mm_cvtsi128_si64(s);
+}
+
+//
+//  Eight pixels at a time, widened to 32 bits.  The products d*j fit in 32
+//  bits; they are summed and multiplied by j again in 64-bit lanes, the
+//  even and odd pixels separately.
+//
+TwoDMoments Pds::twoDMoments_avx2(unsigned cols,
+				  unsigned colStart, unsigned colEnd,
+				  unsigned rowStart, unsigned rowEnd,
+				  unsigned short offset,
+				  unsigned short threshold,
+				  const unsigned short* src)
+{
+  const __m256i voff  = _mm256_set1_epi32(offset);
+  const __m256i vthr  = _mm256_set1_epi32(int(threshold)-1);
+  const __m256i vlow  = _mm256_set1_epi64x(0xffffffffULL);
+  const __m256i vstep = _mm256_set1_epi32(8);
+  const __m256i vj0   = _mm256_add_epi32(_mm256_set1_epi32(colStart),
+					 _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+  const unsigned jend = colEnd > colStart ? colStart + ((colEnd-colStart)&~7U) : colStart;
+
+  TwoDMoments m;
+  __m256i vxx = _mm256_setzero_si256();
+  src += rowStart*cols;
+  for(unsigned k=rowStart; k<rowEnd; k++) {
+    __m256i vw  = _mm256_setzero_si256();
+    __m256i vwx = _mm256_setzero_si256();
+    __m256i vj  = vj0;
+    unsigned j=colStart;
+    for(; j<jend; j+=8) {
+      __m256i d  = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src+j)));
+      d = _mm256_and_si256(_mm256_sub_epi32(d, voff), _mm256_cmpgt_epi32(d, vthr));
+      __m256i dj = _mm256_mullo_epi32(d, vj);
+      vw  = _mm256_add_epi32(vw , d);
+      vwx = _mm256_add_epi64(vwx, _mm256_and_si256 (dj, vlow));
+      vwx = _mm256_add_epi64(vwx, _mm256_srli_epi64(dj, 32));
+      vxx = _mm256_add_epi64(vxx, _mm256_mul_epu32 (dj, vj));
+      vxx = _mm256_add_epi64(vxx, _mm256_mul_epu32 (_mm256_srli_epi64(dj, 32),
+						    _mm256_srli_epi64(vj, 32)));
+      vj  = _mm256_add_epi32(vj, vstep);
+    }
+    unsigned           wsum  = hsum32(vw);
+    unsigned long long wxsum = hsum64(vwx);
+    for(; j<colEnd; j++) {
+      unsigned short d  = src[j];
+      if (d < threshold) continue;
+      d -= offset;
+      unsigned long  dj = d*j;
+      wsum  += d;
+      wxsum += dj;
+      m._xx += dj*j;
+    }
+    src += cols;
+    m._n  += wsum;
+    m._x  += wxsum;
+    unsigned long long wk = wsum;
+    wk *= k;
+    m._y  += wk;
+    m._yy += wk*k;
+    m._xy += wxsum*k;
+  }
+  m._xx += hsum64(vxx);
+  return m;
+}
+
+#endif
@@ -10,6 +10,7 @@ libsrcs_camera := CameraBase.cc \
 		  FexCameraManager.cc \
 		  FrameHandle.cc \
 		  TwoDMoments.cc \
+		  TwoDMomentsAvx2.cc \
 		  TwoDGaussian.cc \
 		  Frame.cc \
 	          FrameServer.cc \
@@ -45,7 +46,7 @@ libincs_camedt := edt/include pdsdata/include
 tgtnames :=
 
 ifneq ($(findstring x86_64,$(tgt_arch)),)
-tgtnames := pdvserialcmd pdvcamsend camreceiver
+tgtnames := pdvserialcmd pdvcamsend camreceiver momentsbench
 else
 #tgtnames := camsend camreceiver serialcmd fccdcmd
 tgtnames := camsend serialcmd fccdcmd
@@ -112,3 +113,6 @@ tgtlibs_pdvcamsend += pdsdata/xtcdata pdsdata/psddl_pdsdata mysql/mysqlclient
 tgtlibs_pdvcamsend += edt/pdv
 tgtslib_pdvcamsend := $(USRLIBDIR)/rt dl
 
+tgtsrcs_momentsbench := momentsbench.cc TwoDMoments.cc TwoDMomentsAvx2.cc
+tgtlibs_momentsbench := pds/service
+tgtslib_momentsbench := $(USRLIBDIR)/rt $(USRLIBDIR)/pthread
@@ -0,0 +1,128 @@
+//
+//  Throughput of the TwoDMoments variants used by FexFrameServer (full
+//  frame, region of interest and threshold) on synthetic frames: a
+//  gaussian spot on a noisy pedestal.  Each is timed with the scalar loop
+//  and the AVX2 kernel, in one thread and with the rows split among
+//  threads, and its moments compared with those of the scalar loop.
+//
+#include "pds/camera/TwoDMoments.hh"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+enum Variant { FullFrame, RegionOfInterest, Threshold, NVariants };
+static const char* _variant_names[] = { "full", "roi", "threshold" };
+
+class Frame {
+public:
+  Frame(unsigned width, unsigned height, unsigned depth, unsigned short offset) :
+    _width(width), _height(height), _data(new unsigned short[width*height])
+  {
+    unsigned short maxv = (1<<depth)-1;
+    double x0 = 0.4*width, y0 = 0.6*height, sx = 0.05*width, sy = 0.08*height;
+    for(unsigned k=0; k<height; k++)
+      for(unsigned j=0; j<width; j++) {
+        double dx = (double(j)-x0)/sx, dy = (double(k)-y0)/sy;
+        double v = offset + (random()&0x1f) + 0.8*maxv*exp(-0.5*(dx*dx+dy*dy));
+        _data[k*width+j] = v < maxv ? (unsigned short)(v) : maxv;
+      }
+  }
+  ~Frame() { delete[] _data; }
+public:
+  TwoDMoments moments(Variant v, unsigned short offset, unsigned short threshold) const {
+    switch(v) {
+    case RegionOfInterest:
+      return TwoDMoments(_width, _width/4, 3*_width/4+1, _height/4, 3*_height/4+1, offset, _data);
+    case Threshold:
+      return TwoDMoments(_width, _height, offset, threshold, _data);
+    default:
+      return TwoDMoments(_width, _height, offset, _data);
+    }
+  }
+  unsigned pixels(Variant v) const {
+    return v==RegionOfInterest ? (_width/2+1)*(_height/2+1) : _width*_height;
+  }
+private:
+  unsigned        _width, _height;
+  unsigned short* _data;
+};
+
+static void usage(const char* p)
+{
+  printf("Usage: %s [-w <width>] [-h <height>] [-d <depth>] [-n <frames>] [-t <threads>]\n"
+         "          [-o <offset>] [-T <threshold>]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned width     = 1024;
+  unsigned height    = 1024;
+  unsigned depth     = 12;
+  unsigned nframes   = 200;
+  unsigned nthreads  = 4;
+  unsigned offset    = 32;
+  unsigned threshold = 256;
+
+  int c;
+  while ((c = getopt(argc, argv, "w:h:d:n:t:o:T:")) != -1) {
+    switch(c) {
+    case 'w': width     = strtoul(optarg,NULL,0); break;
+    case 'h': height    = strtoul(optarg,NULL,0); break;
+    case 'd': depth     = strtoul(optarg,NULL,0); break;
+    case 'n': nframes   = strtoul(optarg,NULL,0); break;
+    case 't': nthreads  = strtoul(optarg,NULL,0); break;
+    case 'o': offset    = strtoul(optarg,NULL,0); break;
+    case 'T': threshold = strtoul(optarg,NULL,0); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  if (depth > 16) depth = 16;
+  Frame frame(width, height, depth, offset);
+  bool lsimd = TwoDMoments::simd();
+  printf("%u frames of %ux%u %u-bit pixels, offset %u, threshold %u, avx2 %s\n",
+         nframes, width, height, depth, offset, threshold, lsimd ? "available" : "unavailable");
+
+  bool lexact = true;
+  for(int v=0; v<NVariants; v++) {
+    Variant variant = Variant(v);
+    TwoDMoments::useSimd(false);
+    TwoDMoments::setThreads(1);
+    TwoDMoments ref = frame.moments(variant, offset, threshold);
+
+    for(unsigned isimd=0; isimd<(lsimd ? 2:1); isimd++) {
+      TwoDMoments::useSimd(isimd);
+      unsigned threads[] = { 1, nthreads };
+      for(unsigned it=0; it<(nthreads>1 ? 2:1); it++) {
+        unsigned t = threads[it];
+        TwoDMoments::setThreads(t);
+        TwoDMoments m;
+        double t0 = now();
+        for(unsigned i=0; i<nframes; i++)
+          m = frame.moments(variant, offset, threshold);
+        double dt = now()-t0;
+        bool lsame = (m == ref);
+        lexact &= lsame;
+        printf("%-9s %-6s %u thread%s: %8.1f frames/s %7.1f Mpixels/s  %s\n",
+               _variant_names[v], isimd ? "avx2":"scalar", t, t>1 ? "s":" ",
+               double(nframes)/dt, 1.e-6*double(nframes)*double(frame.pixels(variant))/dt,
+               lsame ? "identical" : "DIFFERS");
+      }
+    }
+  }
+  TwoDMoments::setThreads(1);
+
+  return lexact ? 0 : 1;
+}
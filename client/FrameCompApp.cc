@@ -4,6 +4,7 @@
 #include "pds/xtc/InDatagram.hh"
 #include "pds/service/Task.hh"
 #include "pds/service/Timer.hh"
+#include "pds/service/Semaphore.hh"
 
 #include "pds/config/CsPad2x2DataType.hh"
 
@@ -15,11 +16,15 @@
 #include "pds/pnccd/FrameV0.hh"
 #include "pdsdata/psddl/pnccd.ddl.h"
 
+#include "pds/config/EpixDataType.hh"
+#include "pdsdata/psddl/epix.ddl.h"
+
 #include "pdsdata/compress/CompressedPayload.hh"
 #include "pdsdata/compress/CompressedXtc.hh"
 #include "pdsdata/psddl/camera.ddl.h"
 
 #include "pdsdata/xtc/DetInfo.hh"
+#include "pdsdata/xtc/XtcIterator.hh"
 
 #include "pdsdata/compress/CompressedData.hh"
 #include "pdsdata/compress/HistNEngine.hh"
@@ -44,6 +49,7 @@ static bool lUseOMP=false;
 static bool lVerbose=false;
 static unsigned copyPresample=0;
 static unsigned icopyPresample=0;
+static const unsigned mgr_queue_depth = 1024;  // lock-free work queue of the manager task
 
 static double time_since(const timespec& now, const timespec& tv)
 {
@@ -58,9 +64,10 @@ namespace Pds {
     public:
       Entry(Transition* tr) : _state(Completed), _type(TypeT), _ptr(tr), _copy(false), _insize(0)
       { clock_gettime(CLOCK_REALTIME,&_start); }
-      Entry(InDatagram* in) : _state(in->datagram().seq.service()==TransitionId::L1Accept ||
-                                     in->datagram().seq.service()==TransitionId::Configure ? Queued:Completed),
-                              _type(TypeI), _ptr(in), _copy(false), _insize(in->datagram().xtc.sizeofPayload())
+      Entry(InDatagram* in, bool pass=false) :
+        _state(!pass && (in->datagram().seq.service()==TransitionId::L1Accept ||
+                         in->datagram().seq.service()==TransitionId::Configure) ? Queued:Completed),
+        _type(TypeI), _ptr(in), _copy(false), _insize(in->datagram().xtc.sizeofPayload())
       { clock_gettime(CLOCK_REALTIME,&_start); 
         if (copyPresample!=0 && (++icopyPresample >= copyPresample)) {
           _copy=true;
@@ -73,7 +80,7 @@ namespace Pds {
     public:
       void assign  () { _state=Assigned; }
       void complete() { _state=Completed; clock_gettime(CLOCK_REALTIME,&_complete); }
-      void post    (FrameCompApp& app) { 
+      void post    (Appliance& app) { 
         if (_type == TypeT) app.post((Transition*)_ptr);
         else                app.post((InDatagram*)_ptr);
       }
@@ -109,11 +116,12 @@ namespace Pds {
 
     class QueueEv : public Routine {
     public:
-      QueueEv(InDatagram* in, FrameCompApp& app) : _in(in), _app(app) {}
-      void routine() { _app.queueEvent(_in); delete this; }
+      QueueEv(InDatagram* in, FrameCompApp& app, bool pass=false) : _in(in), _app(app), _pass(pass) {}
+      void routine() { _app.queueEvent(_in,_pass); delete this; }
     private:
       InDatagram*   _in;
       FrameCompApp& _app;
+      bool          _pass;
     };
 
     class ComplEv : public Routine {
@@ -126,11 +134,129 @@ namespace Pds {
       unsigned      _id;
     };
 
+    //
+    //  The elements of one image to be compressed concurrently
+    //
+    class ElementJob {
+    public:
+      char*   ibuff;
+      char*   obuff;
+      Compress::Hist16Engine::ImageParams img;
+      size_t  csize;
+    };
+
+    class ElementBatch {
+    public:
+      ElementBatch(ElementJob* jobs, unsigned njobs, CompressedPayload::Engine engine) :
+        _jobs(jobs), _njobs(njobs), _next(0), _engine(engine), _sem(Semaphore::EMPTY) {}
+    public:
+      ElementJob* claim() {
+        unsigned i = __sync_fetch_and_add(&_next,1);
+        return i < _njobs ? &_jobs[i] : 0;
+      }
+      CompressedPayload::Engine engine() const { return _engine; }
+      unsigned njobs() const { return _njobs; }
+      Semaphore& sem() { return _sem; }
+    private:
+      ElementJob* _jobs;
+      unsigned    _njobs;
+      unsigned    _next;
+      CompressedPayload::Engine _engine;
+      Semaphore   _sem;
+    };
+
+    //
+    //  A helper thread with its own compression engines.  Workers claim
+    //  elements from a batch until it is exhausted, so a large element
+    //  doesn't hold up the others.
+    //
+    class ElementWorker {
+    public:
+      ElementWorker() : _task(new Pds::Task(TaskObject("FCAelm"))) {}
+      ~ElementWorker() { _task->destroy(); }
+    public:
+      void run(ElementBatch&);
+      void compress(ElementBatch& batch) {
+        ElementJob* job;
+        while( (job = batch.claim()) ) {
+          unsigned dsize = job->img.depth*job->img.width;
+          if      (batch.engine() == CompressedPayload::HistN &&
+                   _histN.compress(job->ibuff,job->img.depth,dsize,job->obuff,job->csize) == Compress::HistNEngine::Success)
+            ;
+          else if (batch.engine() == CompressedPayload::Hist16 &&
+                   _hist16.compress(job->ibuff,job->img,job->obuff,job->csize) == Compress::Hist16Engine::Success)
+            ;
+          else
+            job->csize = 0;
+        }
+        batch.sem().give();
+      }
+    private:
+      Pds::Task*             _task;
+      Compress::Hist16Engine _hist16;
+      Compress::HistNEngine  _histN;
+    };
+
+    class ElementRun : public Routine {
+    public:
+      ElementRun(ElementBatch& batch, ElementWorker& worker) : _batch(batch), _worker(worker) {}
+      void routine() { _worker.compress(_batch); delete this; }
+    private:
+      ElementBatch&  _batch;
+      ElementWorker& _worker;
+    };
+
+    inline void ElementWorker::run(ElementBatch& batch) { _task->call(new ElementRun(batch,*this)); }
+
+    class ElementPool {
+    public:
+      ElementPool(unsigned nthreads) : _workers(nthreads) {
+        for(unsigned i=0; i<nthreads; i++)
+          _workers[i] = new ElementWorker;
+      }
+      ~ElementPool() {
+        for(unsigned i=0; i<_workers.size(); i++)
+          delete _workers[i];
+      }
+    public:
+      //  Returns when all elements of the batch are compressed
+      void compress(ElementBatch& batch) {
+        unsigned n = batch.njobs() < _workers.size() ? batch.njobs() : _workers.size();
+        for(unsigned i=0; i<n; i++)
+          _workers[i]->run(batch);
+        for(unsigned i=0; i<n; i++)
+          batch.sem().take();
+      }
+    private:
+      std::vector<ElementWorker*> _workers;
+    };
+
+    //
+    //  As CompressedXtc, but the elements are compressed by the ElementPool
+    //  into a scratch buffer and then reassembled in order.
+    //
+    class ParallelCompressedXtc : public Pds::Xtc {
+    public:
+      ParallelCompressedXtc( Pds::Xtc&     xtc,
+                             const std::list<unsigned>& headerOffsets,
+                             unsigned headerSize,
+                             unsigned depth,
+                             Pds::CompressedPayload::Engine engine,
+                             ElementPool& pool,
+                             char* scratch );
+    public:
+      static size_t scratch_size( Pds::Xtc& xtc,
+                                  const std::list<unsigned>& headerOffsets,
+                                  unsigned headerSize );
+    };
+
     class MyIter : public XtcStripper {
     public:
       enum Status {Stop, Continue};
-      MyIter(Xtc* xtc, uint32_t*& p, char* obuff, size_t max_osize,bool cache) :
-        XtcStripper(xtc, p), _obuff(obuff), _max_osize(max_osize), _cache(cache), _cached(false) {}
+      MyIter(Xtc* xtc, uint32_t*& p, char* obuff, size_t max_osize,bool cache,
+             ElementPool* pool=0, char* sbuff=0, size_t max_ssize=0) :
+        XtcStripper(xtc, p), _obuff(obuff), _max_osize(max_osize), _cache(cache), _cached(false),
+        _pool(pool), _sbuff(sbuff), _max_ssize(max_ssize) {}
       ~MyIter() {}
       bool cached() const { return _cached; }
     protected:
@@ -140,17 +266,31 @@ namespace Pds {
       size_t _max_osize;
       bool   _cache;
       bool   _cached;
+      ElementPool* _pool;
+      char*  _sbuff;
+      size_t _max_ssize;
+    };
+
+    //
+    //  Registers configurations without compressing
+    //
+    class ConfigIter : public XtcIterator {
+    public:
+      ConfigIter(Xtc* xtc) : XtcIterator(xtc) {}
+      int process(Xtc*);
     };
 
     class Task : public Routine {
     public:
-      Task(unsigned id, FrameCompApp& app, size_t max_size) :
+      Task(unsigned id, FrameCompApp& app, size_t max_size, ElementPool* pool) :
         _id(id), _app(app), 
         _task(new Pds::Task(TaskObject("FCAtsk"))),
         _entry(0),
         _obuff(new uint32_t[max_size>>2]),
-        _max_size(max_size) {}
-      ~Task() { _task->destroy(); delete[] _obuff; }
+        _max_size(max_size),
+        _pool(pool),
+        _sbuff(pool ? new uint32_t[max_size>>2] : 0) {}
+      ~Task() { _task->destroy(); delete[] _obuff; if (_sbuff) delete[] _sbuff; }
     public:
       void assign(FCA::Entry* e) { (_entry = e)->assign(); _task->call(this); }
       void unassign() { _entry = 0; }
@@ -158,7 +298,8 @@ namespace Pds {
       void routine() {
         InDatagram* in = (InDatagram*)_entry->ptr();
         uint32_t* pdg = reinterpret_cast<uint32_t*>(&(in->datagram().xtc));
-        MyIter iter(&in->datagram().xtc,pdg,(char*)_obuff,_max_size,_entry->copy());
+        MyIter iter(&in->datagram().xtc,pdg,(char*)_obuff,_max_size,_entry->copy(),
+                    _pool,(char*)_sbuff,_sbuff ? _max_size : 0);
         iter.iterate();
         if (iter.cached()) {
           Xtc* xtc = reinterpret_cast<Xtc*>(_obuff);
@@ -175,6 +316,8 @@ namespace Pds {
       enum { MaxSize = 0x2000000 };
       uint32_t*     _obuff;
       size_t        _max_size;
+      ElementPool*  _pool;
+      uint32_t*     _sbuff;
     };
 
 #ifdef _OPENMP
@@ -215,6 +358,55 @@ static std::vector<DetInfo>         _infov4;
 static std::vector<CsPadConfigType> _config;
 static std::vector<DetInfo>         _info;
 
+//
+//  Remember the configurations needed to interpret the event data
+//
+static void _register_config(Xtc* xtc)
+{
+  if (xtc->contains.value() == _pnCCDConfigType.value()) {
+    _configp.push_back(*reinterpret_cast<const pnCCDConfigType*>(xtc->payload()));
+    _infop  .push_back(static_cast<DetInfo&>(xtc->src));
+  }
+  else if (xtc->contains.value() == _CsPadConfigType.value()) {
+    _config.push_back(*reinterpret_cast<const CsPadConfigType*>(xtc->payload()));
+    _info  .push_back(static_cast<DetInfo&>(xtc->src));
+    if (lVerbose)      printf("Registered config for %08x.%08x:%sv%d\n",
+                              xtc->src.log(),xtc->src.phy(),
+                              TypeId::name(xtc->contains.id()),
+                              xtc->contains.version());
+  }
+  else if (xtc->contains.id() == TypeId::Id_CspadConfig && xtc->contains.version()==4) {
+    _configv4.push_back(*reinterpret_cast<const CsPad::ConfigV4*>(xtc->payload()));
+    _infov4  .push_back(static_cast<DetInfo&>(xtc->src));
+    if (lVerbose)      printf("Registered config for %08x.%08x:%sv%d\n",
+                              xtc->src.log(),xtc->src.phy(),
+                              TypeId::name(xtc->contains.id()),
+                              xtc->contains.version());
+  }
+}
+
+//
+//  Size of the fixed header preceding the epix frame, or 0 if not an
+//  (uncompressed) epix frame.
+//
+static unsigned _epix_header_size(const TypeId& type)
+{
+  if (type.compressed())
+    return 0;
+  if (type.id() == TypeId::Id_EpixElement) {
+    switch(type.version()) {
+    case Epix::ElementV1::Version: return sizeof(Epix::ElementV1);
+    case Epix::ElementV2::Version: return sizeof(Epix::ElementV2);
+    case Epix::ElementV3::Version: return sizeof(Epix::ElementV3);
+    default: break;
+    }
+  }
+  else if (type.id() == TypeId::Id_Epix10kaArray &&
+           type.version() == Epix::ArrayV1::Version)
+    return sizeof(Epix::ArrayV1);
+  return 0;
+}
+
 static const unsigned nbins = 64;
 static const double ms_per_bin = 64./64.;
 static const double rat_per_bin = 1.28/64.;
@@ -226,8 +418,10 @@ static MonEntryTH1F* _mon_entry_th1f( const char* name )
   return new MonEntryTH1F(desc);
 }
 
-FrameCompApp::FrameCompApp(size_t max_size, unsigned nthreads) :
-  _mgr_task(new Task(TaskObject("FCAmgr"))),
+FrameCompApp::FrameCompApp(size_t max_size, unsigned nthreads, Appliance* output, unsigned ethreads) :
+  _output  (output),
+  _elements(ethreads ? new FCA::ElementPool(ethreads) : 0),
+  _mgr_task(new Task(TaskObject("FCAmgr"),mgr_queue_depth)),
   _tasks   (nthreads ? nthreads : 4),
   _timer   (new FCA::Timer(*this,*_mgr_task))
 {
@@ -255,7 +449,7 @@ FrameCompApp::FrameCompApp(size_t max_size, unsigned nthreads) :
   group->add(_compress_ratio);
 
   for(unsigned id=0; id<_tasks.size(); id++)
-    _tasks[id] = new FCA::Task(id,*this,max_size);
+    _tasks[id] = new FCA::Task(id,*this,max_size,_elements);
 
   //  _timer->start();
 }
@@ -265,6 +459,8 @@ FrameCompApp::~FrameCompApp()
   _mgr_task->destroy();
   for(unsigned id=0; id<_tasks.size(); id++)
     delete _tasks[id];
+  if (_elements)
+    delete _elements;
 }
 
 void FrameCompApp::useOMP(bool l) { lUseOMP=l; }
@@ -282,13 +478,18 @@ InDatagram* FrameCompApp::events(InDatagram* in)
   return (InDatagram*)Appliance::DontDelete;
 }
 
+void FrameCompApp::pass(InDatagram* in)
+{
+  _mgr_task->call(new FCA::QueueEv(in,*this,true));
+}
+
 void FrameCompApp::queueTransition(Transition* tr)
 {
   _list.push_back(new FCA::Entry(tr));
   process();
 }
 
-void FrameCompApp::queueEvent(InDatagram* in)
+void FrameCompApp::queueEvent(InDatagram* in, bool pass)
 {
   if (in->datagram().seq.service()==TransitionId::Configure) {
     _config.clear();
@@ -297,11 +498,22 @@ void FrameCompApp::queueEvent(InDatagram* in)
     _infov4  .clear();
     if (lVerbose)    printf("FCA::queue Configure\n");
   }
-  _list.push_back(new FCA::Entry(in));
+  _list.push_back(new FCA::Entry(in,pass));
   process();
   audit();
 }
 
+void FrameCompApp::configure(Xtc* xtc)
+{
+  _configp .clear();
+  _infop   .clear();
+  _config  .clear();
+  _info    .clear();
+  _configv4.clear();
+  _infov4  .clear();
+  FCA::ConfigIter(xtc).iterate();
+}
+
 void FrameCompApp::_post(FCA::Entry* e)
 {
   timespec now;
@@ -333,7 +545,7 @@ void FrameCompApp::_post(FCA::Entry* e)
   _start_to_post     ->time(time);
   _compress_ratio    ->time(time);
 
-  e->post(*this);
+  e->post(_output ? *_output : *this);
 }
 
 void FrameCompApp::completeEntry(FCA::Entry* e, unsigned id)
@@ -402,7 +614,7 @@ void FrameCompApp::audit()
 void FCA::MyIter::process(Xtc* xtc) 
 {
   if (xtc->contains.id()==TypeId::Id_Xtc) {
-    FCA::MyIter iter(xtc,_pwrite,_obuff,_max_osize,_cache);
+    FCA::MyIter iter(xtc,_pwrite,_obuff,_max_osize,_cache,_pool,_sbuff,_max_ssize);
     iter.iterate();
     _cached |= iter.cached();
     return;
@@ -519,6 +731,13 @@ void FCA::MyIter::process(Xtc* xtc)
                                         TypeId::name(xtc->contains.id()),
                                         xtc->contains.version());
   }
+  else if (_epix_header_size(xtc->contains) &&
+           ((xtc->sizeofPayload()-_epix_header_size(xtc->contains))&1)==0) {
+    headerOffsets.push_back(0);
+    headerSize = _epix_header_size(xtc->contains);
+    depth      = 2;
+    engine     = CompressedPayload::Hist16;
+  }
   else if (xtc->contains.id() == TypeId::Id_pnCCDframe &&
            xtc->contains.version() == 0) {
     // shuffle
@@ -547,29 +766,23 @@ void FCA::MyIter::process(Xtc* xtc)
       }
     }   
   }
-  else if (xtc->contains.value() == _pnCCDConfigType.value()) {
-    _configp.push_back(*reinterpret_cast<const pnCCDConfigType*>(xtc->payload()));
-    _infop  .push_back(static_cast<DetInfo&>(xtc->src));
-  }
-  else if (xtc->contains.value() == _CsPadConfigType.value()) {
-    _config.push_back(*reinterpret_cast<const CsPadConfigType*>(xtc->payload()));
-    _info  .push_back(static_cast<DetInfo&>(xtc->src));
-    if (lVerbose)      printf("Registered config for %08x.%08x:%sv%d\n",
-                              xtc->src.log(),xtc->src.phy(),
-                              TypeId::name(xtc->contains.id()),
-                              xtc->contains.version());
-  }
-  else if (xtc->contains.id() == TypeId::Id_CspadConfig && xtc->contains.version()==4) {
-    _configv4.push_back(*reinterpret_cast<const CsPad::ConfigV4*>(xtc->payload()));
-    _infov4  .push_back(static_cast<DetInfo&>(xtc->src));
-    if (lVerbose)      printf("Registered config for %08x.%08x:%sv%d\n",
-                              xtc->src.log(),xtc->src.phy(),
-                              TypeId::name(xtc->contains.id()),
-                              xtc->contains.version());
-  }
+  else
+    _register_config(xtc);
 
   Xtc* cxtc = 0;
-  if (depth > 0) {
+  if (depth > 0 && _pool && headerOffsets.size() > 1 &&
+      FCA::ParallelCompressedXtc::scratch_size(mxtc ? *mxtc : *xtc,
+                                               headerOffsets,
+                                               headerSize) <= _max_ssize) {
+    cxtc = new (_obuff) ParallelCompressedXtc(mxtc ? *mxtc : *xtc, 
+                                              headerOffsets,
+                                              headerSize,
+                                              depth,
+                                              engine,
+                                              *_pool,
+                                              _sbuff);
+  }
+  else if (depth > 0) {
     cxtc = new (_obuff) CompressedXtc(mxtc ? *mxtc : *xtc, 
                                       headerOffsets,
                                       headerSize,
@@ -626,6 +839,90 @@ void FCA::MyIter::process(Xtc* xtc)
   
   XtcStripper::process(xtc);
 }
+
+int FCA::ConfigIter::process(Xtc* xtc)
+{
+  if (xtc->contains.id()==TypeId::Id_Xtc)
+    iterate(xtc);
+  else
+    _register_config(xtc);
+  return Continue;
+}
+
+//
+//  Size of the element data following each header
+//
+static unsigned _element_size(Xtc& xtc,
+                              const std::list<unsigned>& headerOffsets,
+                              std::list<unsigned>::const_iterator it,
+                              unsigned headerSize)
+{
+  unsigned hoff = *it;
+  return (++it == headerOffsets.end()) ? 
+    (char*)xtc.next()-(xtc.payload()+hoff+headerSize) : (*it)-hoff-headerSize;
+}
+
+static size_t _scratch_size(unsigned dsize) { return (dsize*5/4+64)&~3; }
+
+size_t FCA::ParallelCompressedXtc::scratch_size( Xtc& xtc,
+                                                 const std::list<unsigned>& headerOffsets,
+                                                 unsigned headerSize )
+{
+  size_t sz = 0;
+  for(std::list<unsigned>::const_iterator it=headerOffsets.begin(); it!=headerOffsets.end(); it++)
+    sz += _scratch_size(_element_size(xtc,headerOffsets,it,headerSize));
+  return sz;
+}
+
+FCA::ParallelCompressedXtc::ParallelCompressedXtc( Xtc&     xtc,
+                                                   const std::list<unsigned>& headerOffsets,
+                                                   unsigned headerSize,
+                                                   unsigned depth,
+                                                   CompressedPayload::Engine engine,
+                                                   ElementPool& pool,
+                                                   char* scratch ) :
+  Xtc( TypeId(xtc.contains.id(), xtc.contains.version(), true),
+       xtc.src,
+       xtc.damage )
+{
+  std::vector<ElementJob> jobs(headerOffsets.size());
+  unsigned i=0;
+  for(std::list<unsigned>::const_iterator it=headerOffsets.begin();
+      it!=headerOffsets.end(); it++, i++) {
+    unsigned dsize = _element_size(xtc,headerOffsets,it,headerSize);
+    jobs[i].ibuff = xtc.payload() + (*it) + headerSize;
+    jobs[i].obuff = scratch;
+    jobs[i].img.width  = dsize/depth;
+    jobs[i].img.height = 1;
+    jobs[i].img.depth  = depth;
+    jobs[i].csize = 0;
+    scratch += _scratch_size(dsize);
+  }
+
+  ElementBatch batch(&jobs[0], jobs.size(), engine);
+  pool.compress(batch);
+
+  const unsigned align_mask = sizeof(uint32_t)-1;
+
+  i = 0;
+  for(std::list<unsigned>::const_iterator it=headerOffsets.begin();
+      it!=headerOffsets.end(); it++, i++) {
+    const ElementJob& job = jobs[i];
+    unsigned dsize = job.img.depth*job.img.width;
+    //  copy the header
+    new (alloc(sizeof(CompressedData))) CompressedData(headerSize);
+    memcpy(alloc(headerSize), xtc.payload()+(*it), headerSize);
+    //  copy the payload
+    if (job.csize==0) {
+      new (alloc(sizeof(CompressedPayload))) CompressedPayload(CompressedPayload::None,dsize,dsize);
+      memcpy(alloc((dsize+align_mask)&~align_mask),job.ibuff,dsize);
+    }
+    else {
+      new (alloc(sizeof(CompressedPayload))) CompressedPayload(engine,dsize,job.csize);
+      memcpy(alloc((job.csize+align_mask)&~align_mask),job.obuff,job.csize);
+    }
+  }
+}
   
 #ifdef _OPENMP
 FCA::OMPCompressedXtc::OMPCompressedXtc( Xtc&     xtc,
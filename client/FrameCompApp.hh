@@ -5,6 +5,8 @@
 **  This appliance will compress images in a pipeline that distributes the
 **  work among a fixed number of threads.  Each thread gets the whole job
 **  of compressing one event.  The events are completed in order.
+**  Optionally, the elements (e.g. cspad quadrants) of one event are
+**  further distributed among a set of element threads.
 */
 
 #include "pds/utility/Appliance.hh"
@@ -15,12 +17,17 @@
 namespace Pds {
   class MonEntryTH1F;
   class Task;
+  class Xtc;
 
-  namespace FCA { class Entry; class Task; class Timer; }
+  namespace FCA { class Entry; class Task; class Timer; class ElementPool; }
 
   class FrameCompApp : public Appliance {
   public:
-    FrameCompApp(size_t max_size, unsigned nthreads=4);
+    //  Completed events are posted to the next appliance, or through
+    //  "output" when the appliance is driven outside of a stream.  The
+    //  elements of an event are spread over "ethreads" element threads.
+    FrameCompApp(size_t max_size, unsigned nthreads=4, Appliance* output=0,
+                 unsigned ethreads=0);
     ~FrameCompApp();
   public:
     Transition* transitions(Transition*);
@@ -28,10 +35,12 @@ namespace Pds {
   public:
     Task& mgr_task() { return *_mgr_task; }
     void  queueTransition(Transition*);
-    void  queueEvent     (InDatagram*);
+    void  queueEvent     (InDatagram*, bool pass=false);
     void  completeEntry  (FCA::Entry*,unsigned);
     void  process        ();
     void  audit          ();
+    void  configure      (Xtc*);  // learn configurations not seen in the stream
+    void  pass           (InDatagram*);  // post in order, uncompressed
   public:
     static void useOMP(bool);
     static void setVerbose(bool);
@@ -39,6 +48,8 @@ namespace Pds {
   private:
     void  _post(FCA::Entry*);
   private:
+    Appliance*              _output;
+    FCA::ElementPool*       _elements;
     Pds::Task*              _mgr_task;
     std::list<FCA::Entry*>  _list;
     std::vector<FCA::Task*> _tasks;
@@ -27,6 +27,7 @@
 
 static const unsigned nbins = 64;
 static const double ms_per_bin = 256./64.;
+static const unsigned mgr_queue_depth = 1024;  // lock-free work queue of the manager task
 
 static double time_since(const timespec& now, const timespec& tv)
 {
@@ -373,7 +374,7 @@ void Work::ComplEv::routine() { _app.completeEntry(_in,_id); delete this; }
 
 WorkThreads::WorkThreads(const char* name,
                          const std::vector<Appliance*>& apps) :
-  _mgr_task(new Task(TaskObject("Workmgr")))
+  _mgr_task(new Task(TaskObject("Workmgr"),mgr_queue_depth))
 {
   _mgr = new Work::Manager(name, *this, *_mgr_task);
   
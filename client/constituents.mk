@@ -1,14 +1,19 @@
 libnames := client
-libsrcs_client := $(filter-out FrameCompApp.cc l3ftest.cc,$(wildcard *.cc))
+libsrcs_client := $(filter-out FrameCompApp.cc l3ftest.cc fcabench.cc,$(wildcard *.cc))
 libincs_client := pdsdata/include ndarray/include boost/include 
 
 libnames += clientcompress
 libsrcs_clientcompress := FrameCompApp.cc
 libincs_clientcompress := pdsdata/include ndarray/include boost/include 
 
-tgtnames := l3ftest
+tgtnames := l3ftest fcabench
 tgtsrcs_l3ftest := l3ftest.cc
 tgtlibs_l3ftest := pdsdata/xtcdata pdsdata/appdata pdsdata/psddl_pdsdata
 tgtlibs_l3ftest += pds/client pds/utility pds/service pds/collection pds/vmon pds/mon pds/xtc
 tgtslib_l3ftest := $(USRLIBDIR)/rt $(USRLIBDIR)/dl
-tgtincs_l3ftest := pdsdata/include
\ No newline at end of file
+tgtincs_l3ftest := pdsdata/include
+tgtsrcs_fcabench := fcabench.cc
+tgtlibs_fcabench := pdsdata/xtcdata pdsdata/compressdata pdsdata/psddl_pdsdata
+tgtlibs_fcabench += pds/clientcompress pds/client pds/utility pds/service pds/collection pds/vmon pds/mon pds/xtc
+tgtslib_fcabench := $(USRLIBDIR)/rt $(USRLIBDIR)/dl
+tgtincs_fcabench := pdsdata/include ndarray/include boost/include
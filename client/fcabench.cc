@@ -0,0 +1,212 @@
+//
+//  Throughput of the FrameCompApp compression pipeline by detector type.
+//  The events of an xtc file are split by detector type and each set is
+//  compressed with the serial per-element engine and with the element
+//  threads, reporting the throughput and compression ratio of each.
+//
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+
+#include <vector>
+
+#include "pds/client/FrameCompApp.hh"
+#include "pds/service/GenericPoolW.hh"
+#include "pds/service/Semaphore.hh"
+#include "pds/xtc/CDatagram.hh"
+#include "pdsdata/xtc/XtcFileIterator.hh"
+#include "pdsdata/xtc/XtcIterator.hh"
+
+namespace Pds {
+  enum DetType { Camera, CsPad, CsPad2x2, Epix, pnCCD, NDetTypes };
+  static const char* det_name[] = { "Camera", "CsPad", "CsPad2x2", "Epix", "pnCCD" };
+
+  static int det_type(const TypeId& type)
+  {
+    switch(type.id()) {
+    case TypeId::Id_Frame          : return Camera;
+    case TypeId::Id_CspadElement   : return CsPad;
+    case TypeId::Id_Cspad2x2Element: return CsPad2x2;
+    case TypeId::Id_EpixElement    :
+    case TypeId::Id_Epix10kaArray  : return Epix;
+    case TypeId::Id_pnCCDframe     : return pnCCD;
+    default: break;
+    }
+    return -1;
+  }
+
+  //
+  //  Collect the leaf xtcs of one detector type
+  //
+  class DetIter : public XtcIterator {
+  public:
+    DetIter(Xtc* xtc, int type, std::vector<Xtc*>& leaves) :
+      XtcIterator(xtc), _type(type), _leaves(leaves) {}
+  public:
+    int process(Xtc* xtc) {
+      if (xtc->contains.id()==TypeId::Id_Xtc)
+        iterate(xtc);
+      else if (det_type(xtc->contains)==_type)
+        _leaves.push_back(xtc);
+      return Continue;
+    }
+  private:
+    int                _type;
+    std::vector<Xtc*>& _leaves;
+  };
+
+  class Sink : public Appliance {
+  public:
+    Sink(Semaphore& sem) : _sem(sem), _bytes(0) {}
+  public:
+    Transition* transitions(Transition* in) { return 0; }
+    InDatagram* events     (InDatagram* in) {
+      _bytes += in->datagram().xtc.sizeofPayload();
+      _sem.give();
+      return 0;
+    }
+    double bytes() const { return _bytes; }
+  private:
+    Semaphore& _sem;
+    double     _bytes;
+  };
+};
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+//  A datagram holding only the leaves of one detector type
+static Datagram* extract(const Datagram& dg, int type)
+{
+  std::vector<Xtc*> leaves;
+  DetIter(const_cast<Xtc*>(&dg.xtc), type, leaves).iterate();
+  if (leaves.empty())
+    return 0;
+
+  unsigned size = sizeof(Datagram);
+  for(unsigned i=0; i<leaves.size(); i++)
+    size += leaves[i]->extent;
+
+  Datagram* odg = ::new(new char[size]) Datagram(dg, dg.xtc.contains, dg.xtc.src);
+  for(unsigned i=0; i<leaves.size(); i++)
+    memcpy(odg->xtc.alloc(leaves[i]->extent), leaves[i], leaves[i]->extent);
+  return odg;
+}
+
+static Datagram* copy(const Datagram& dg)
+{
+  unsigned size = sizeof(Datagram)+dg.xtc.sizeofPayload();
+  char* p = new char[size];
+  memcpy(p, &dg, size);
+  return reinterpret_cast<Datagram*>(p);
+}
+
+static void run(int type, const std::vector<Datagram*>& events, Datagram* cfg,
+                size_t max_size, unsigned nthreads, unsigned ethreads)
+{
+  //  Bound the events in flight so none pass uncompressed for lack of a thread
+  GenericPoolW pool(max_size, nthreads);
+  Semaphore    sem(Semaphore::EMPTY);
+  Sink         sink(sem);
+
+  FrameCompApp* app = new FrameCompApp(max_size, nthreads, &sink, ethreads);
+  if (cfg)
+    app->configure(&cfg->xtc);
+
+  double ibytes = 0;
+  double t0 = now();
+  for(unsigned i=0; i<events.size(); i++) {
+    ibytes += events[i]->xtc.sizeofPayload();
+    app->events(new(&pool) CDatagram(*events[i], events[i]->xtc));
+  }
+  for(unsigned i=0; i<events.size(); i++)
+    sem.take();
+  double dt = now()-t0;
+
+  delete app;
+
+  printf("%-9s %8zu %9u %12.1f %8.3f\n",
+         det_name[type], events.size(), ethreads,
+         ibytes/dt*1.e-6, sink.bytes()/ibytes);
+}
+
+void usage(char* progname) {
+  fprintf(stderr,"Usage: %s -x <xtcname> [-n <events per type>] [-t <event threads>] [-e <element threads>] [-s <max event size>] [-h]\n", progname);
+}
+
+int main(int argc, char* argv[]) {
+  int c;
+  char* xtcname=0;
+  unsigned nevents  = 100;
+  unsigned nthreads = 4;
+  unsigned ethreads = 4;
+  size_t   max_size = 0x900000;
+
+  while ((c = getopt(argc, argv, "hx:n:t:e:s:")) != -1) {
+    switch (c) {
+    case 'x': xtcname  = optarg; break;
+    case 'n': nevents  = strtoul(optarg,NULL,0); break;
+    case 't': nthreads = strtoul(optarg,NULL,0); break;
+    case 'e': ethreads = strtoul(optarg,NULL,0); break;
+    case 's': max_size = strtoul(optarg,NULL,0); break;
+    case 'h':
+    default:
+      usage(argv[0]);
+      exit(0);
+    }
+  }
+  
+  if (!xtcname) {
+    usage(argv[0]);
+    exit(2);
+  }
+
+  int fd = open(xtcname,O_RDONLY | O_LARGEFILE);
+  if (fd < 0) {
+    printf("Unable to open file %s\n",xtcname);
+    exit(2);
+  }
+
+  //
+  //  Load the events into memory so that file access isn't timed
+  //
+  std::vector<Datagram*> events[NDetTypes];
+  Datagram* cfg = 0;
+
+  XtcFileIterator iter(fd,max_size);
+  Dgram* dg;
+  while ((dg = iter.next())) {
+    Datagram& ddg = *reinterpret_cast<Datagram*>(dg);
+    if (ddg.seq.service()==TransitionId::Configure && !cfg)
+      cfg = copy(ddg);
+    else if (ddg.seq.service()==TransitionId::L1Accept) {
+      bool lfull = true;
+      for(int t=0; t<NDetTypes; t++) {
+        if (events[t].size() < nevents) {
+          Datagram* odg = extract(ddg,t);
+          if (odg) events[t].push_back(odg);
+          lfull = false;
+        }
+      }
+      if (lfull) break;
+    }
+  }
+  close(fd);
+
+  printf("%-9s %8s %9s %12s %8s\n","type","events","elem thr","[MB/s]","out/in");
+  for(int t=0; t<NDetTypes; t++) {
+    if (events[t].empty()) continue;
+    run(t, events[t], cfg, max_size, nthreads, 0);
+    run(t, events[t], cfg, max_size, nthreads, ethreads);
+  }
+
+  return 0;
+}
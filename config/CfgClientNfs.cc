@@ -1,6 +1,7 @@
 #include "CfgClientNfs.hh"
 
 #include "pds/config/XtcClient.hh"
+#include "pds/config/CfgFileCache.hh"
 #include "pds/utility/Transition.hh"
 #include "pdsdata/xtc/Src.hh"
 #include "pdsdata/xtc/TypeId.hh"
@@ -34,13 +35,15 @@ static void clear_map(std::map<unsigned,CfgClientNfs::CacheEntry>& m)
 CfgClientNfs::CfgClientNfs( const Src& src ) :
   _src( src ),
   _db ( 0 ),
-  _key( 0 )
+  _key( 0 ),
+  _files( CfgFileCache::open() )
 {
 }
 
 CfgClientNfs::~CfgClientNfs()
 {
   if (_db) delete _db;
+  if (_files) delete _files;
   clear_map(_cache);
 }
 
@@ -96,15 +99,29 @@ int CfgClientNfs::fetch(const Transition& tr,
     clock_gettime(CLOCK_REALTIME,&tv_b);
 #endif
 
-    int result = db->getXTC(tr.env().value(),
-			    _src,
-			    id,
-			    dst,
-			    maxSize);
+    //
+    //  The node's cache is good if the database's stamp is unchanged
+    //
+    uint64_t stamp  = _files ? db->getXTCStamp(_key, _src, id) : 0;
+    int      result = 0;
+    if (stamp)
+      result = _files->find(_path.c_str(), _key, _src, id, stamp, dst, maxSize);
+
+    bool cached = result > 0;
+    if (!cached) {
+      result = db->getXTC(tr.env().value(),
+                          _src,
+                          id,
+                          dst,
+                          maxSize);
+      if (stamp && result > 0)
+        _files->store(_path.c_str(), _key, _src, id, stamp, dst, result);
+    }
 #ifdef DBUG
     struct timespec tv_e;
     clock_gettime(CLOCK_REALTIME,&tv_e);
-    printf("CfgClientNfs::fetch() %f s\n", time_diff(tv_b,tv_e));
+    printf("CfgClientNfs::fetch() %f s%s\n", time_diff(tv_b,tv_e),
+           cached ? " (node cache)" : "");
 #endif
 
     if (result > 0) {
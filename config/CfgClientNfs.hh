@@ -13,6 +13,7 @@ namespace Pds {
   class Allocation;
   class Transition;
   class TypeId;
+  class CfgFileCache;
 
   class CfgClientNfs {
   public:
@@ -33,6 +34,7 @@ namespace Pds {
     Pds_ConfigDb::XtcClient* _db;
     std::string              _path;
     unsigned                 _key;
+    CfgFileCache*            _files;
   public:
     class CacheEntry {
     public:
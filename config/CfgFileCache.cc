@@ -0,0 +1,300 @@
+#include "CfgFileCache.hh"
+
+#include "pdsdata/xtc/Src.hh"
+#include "pdsdata/xtc/TypeId.hh"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+using namespace Pds;
+
+static const uint32_t Magic      = 0x43676643;  // "CfgC"
+static const uint32_t Version    = 2;
+static const unsigned NumEntries = 8192;
+static const unsigned MaxProbe   = 16;
+static const uint64_t MaxBytes   = 256ULL<<20;  // of payloads on the node
+
+namespace Pds {
+  class CfgFileCache::Entry {
+  public:
+    uint64_t db;       // hash of the database path; 0 for a free entry
+    uint64_t stamp;
+    uint64_t hash;     // of the payload
+    uint32_t key;
+    uint32_t log;
+    uint32_t phy;
+    uint32_t type;
+    uint32_t size;
+    uint32_t reserved;
+  };
+};
+
+namespace {
+  class Header {
+  public:
+    uint32_t magic;
+    uint32_t version;
+    uint32_t nentries;
+    uint32_t reserved;
+    uint64_t bytes;     // of the payloads referenced by the index
+  };
+
+  class FileLock {
+  public:
+    FileLock(int fd, int op) : _fd(fd) { flock(_fd, op); }
+    ~FileLock() { flock(_fd, LOCK_UN); }
+  private:
+    int _fd;
+  };
+};
+
+static const unsigned IndexSize = sizeof(Header) + NumEntries*sizeof(CfgFileCache::Entry);
+
+CfgFileCache* CfgFileCache::open()
+{
+  const char* dir = getenv("PDS_CFG_CACHE");
+  if (!dir || !*dir)
+    return 0;
+
+  CfgFileCache* cache = new CfgFileCache(dir);
+  if (!cache->valid()) {
+    delete cache;
+    cache = 0;
+  }
+  return cache;
+}
+
+CfgFileCache::CfgFileCache(const char* dir) :
+  _dir  (dir),
+  _fd   (-1),
+  _index(0)
+{
+  //
+  //  Only the processes of this user may use the cache, since they
+  //  configure the hardware from it.
+  //
+  if (mkdir(dir, 0700) && errno != EEXIST) {
+    printf("CfgFileCache failed to create %s : %s\n", dir, strerror(errno));
+    return;
+  }
+
+  struct stat64 d;
+  if (lstat64(dir, &d) || !S_ISDIR(d.st_mode) ||
+      d.st_uid != geteuid() || (d.st_mode & 077)) {
+    printf("CfgFileCache %s is not a directory private to this user\n", dir);
+    return;
+  }
+
+  std::string path = _dir + "/index";
+  _fd = ::open(path.c_str(), O_RDWR|O_CREAT|O_NOFOLLOW, 0600);
+  if (_fd < 0) {
+    printf("CfgFileCache failed to open %s : %s\n", path.c_str(), strerror(errno));
+    return;
+  }
+
+  void* p;
+  { FileLock lock(_fd, LOCK_EX);
+    struct stat64 s;
+    if (fstat64(_fd, &s) || s.st_size != IndexSize) {
+      //  New, or of another layout
+      ftruncate(_fd, 0);
+      ftruncate(_fd, IndexSize);
+    }
+    p = mmap(0, IndexSize, PROT_READ|PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (p != MAP_FAILED) {
+      Header& h = *reinterpret_cast<Header*>(p);
+      if (h.magic != Magic || h.version != Version || h.nentries != NumEntries) {
+        memset(p, 0, IndexSize);
+        h.magic    = Magic;
+        h.version  = Version;
+        h.nentries = NumEntries;
+        h.bytes    = 0;
+      }
+    }
+  }
+
+  if (p == MAP_FAILED) {
+    printf("CfgFileCache failed to map %s : %s\n", path.c_str(), strerror(errno));
+    ::close(_fd);
+    _fd = -1;
+    return;
+  }
+
+  _index = reinterpret_cast<Entry*>(reinterpret_cast<Header*>(p)+1);
+}
+
+CfgFileCache::~CfgFileCache()
+{
+  if (_index)
+    munmap(reinterpret_cast<Header*>(_index)-1, IndexSize);
+  if (_fd >= 0)
+    ::close(_fd);
+}
+
+int CfgFileCache::find(const char*   dbpath,
+                       unsigned      key,
+                       const Src&    src,
+                       const TypeId& id,
+                       uint64_t      stamp,
+                       void*         dst,
+                       unsigned      maxSize)
+{
+  if (!_index) return 0;
+
+  Entry e;
+  { FileLock lock(_fd, LOCK_SH);
+    Entry* p = _find(hash(dbpath,strlen(dbpath))|1, key, src, id, false);
+    if (!p) return 0;
+    e = *p; }
+
+  if (e.stamp != stamp || e.size > maxSize)
+    return 0;
+
+  int fd = ::open(_payload(e.hash,e.size).c_str(), O_RDONLY);
+  if (fd < 0)
+    return 0;
+  int len = ::read(fd, dst, e.size);
+  ::close(fd);
+
+  if (len != int(e.size) || hash(dst,e.size) != e.hash)
+    return 0;
+
+  return len;
+}
+
+void CfgFileCache::store(const char*   dbpath,
+                         unsigned      key,
+                         const Src&    src,
+                         const TypeId& id,
+                         uint64_t      stamp,
+                         const void*   payload,
+                         unsigned      size)
+{
+  if (!_index) return;
+
+  uint64_t db = hash(dbpath,strlen(dbpath))|1;
+  uint64_t h  = hash(payload,size);
+
+  FileLock lock(_fd, LOCK_EX);
+  Header& hdr = *(reinterpret_cast<Header*>(_index)-1);
+  Entry*  e   = _find(db, key, src, id, true);
+
+  //  The payload replaced is removed, unless another entry has it
+  bool     lref  = (e->db && e->hash == h) || _referenced(h, e);
+  unsigned freed = (e->db && e->hash != h && !_referenced(e->hash, e)) ? e->size : 0;
+
+  if (!lref && hdr.bytes - freed + size > MaxBytes)
+    return;  // full; the payload is fetched from the database next time
+
+  std::string   path = _payload(h,size);
+  struct stat64 s;
+  if (!lref || stat64(path.c_str(), &s) || s.st_size != size) {
+    //
+    //  The payload is written to a private file and renamed, so that it
+    //  appears complete to the other processes.
+    //
+    char tmp[32];
+    sprintf(tmp, ".%d", getpid());
+    std::string tpath = path + tmp;
+    int fd = ::open(tpath.c_str(), O_WRONLY|O_CREAT|O_TRUNC|O_NOFOLLOW, 0600);
+    if (fd < 0) {
+      printf("CfgFileCache failed to open %s : %s\n", tpath.c_str(), strerror(errno));
+      return;
+    }
+    int len = ::write(fd, payload, size);
+    ::close(fd);
+    if (len != int(size) || rename(tpath.c_str(), path.c_str())) {
+      printf("CfgFileCache failed to write %s : %s\n", path.c_str(), strerror(errno));
+      unlink(tpath.c_str());
+      return;
+    }
+    if (!lref)
+      hdr.bytes += size;
+  }
+
+  if (freed) {
+    unlink(_payload(e->hash,e->size).c_str());
+    hdr.bytes -= freed;
+  }
+
+  e->db    = db;
+  e->stamp = stamp;
+  e->hash  = h;
+  e->key   = key;
+  e->log   = src.log();
+  e->phy   = src.phy();
+  e->type  = id.value();
+  e->size  = size;
+}
+
+//
+//  Whether an entry other than "e" has the payload
+//
+bool CfgFileCache::_referenced(uint64_t h, const Entry* e) const
+{
+  for(unsigned i=0; i<NumEntries; i++)
+    if (&_index[i]!=e && _index[i].db && _index[i].hash==h)
+      return true;
+  return false;
+}
+
+//
+//  The entries for a database, key, source and type are found by open
+//  addressing.  If there is no free entry in reach, the first is replaced.
+//
+CfgFileCache::Entry* CfgFileCache::_find(uint64_t      db,
+                                         unsigned      key,
+                                         const Src&    src,
+                                         const TypeId& id,
+                                         bool          lfree)
+{
+  uint32_t k[4] = { key, src.log(), src.phy(), id.value() };
+  unsigned slot = (hash(k,sizeof(k)) ^ db) % NumEntries;
+  for(unsigned i=0; i<MaxProbe; i++) {
+    Entry& e = _index[(slot+i)%NumEntries];
+    if (e.db == db && e.key == k[0] && e.log == k[1] && e.phy == k[2] && e.type == k[3])
+      return &e;
+  }
+  if (!lfree)
+    return 0;
+
+  for(unsigned i=0; i<MaxProbe; i++) {
+    Entry& e = _index[(slot+i)%NumEntries];
+    if (e.db == 0)
+      return &e;
+  }
+  return &_index[slot];
+}
+
+std::string CfgFileCache::_payload(uint64_t h, unsigned size) const
+{
+  char name[64];
+  sprintf(name, "/%016llx-%u", (unsigned long long)h, size);
+  return _dir + name;
+}
+
+uint64_t CfgFileCache::hash(const void* p, unsigned size)
+{
+  const uint64_t m = 0x9e3779b97f4a7c15ULL;
+  const char*    b = reinterpret_cast<const char*>(p);
+  uint64_t       h = 0xcbf29ce484222325ULL ^ size;
+  uint64_t       w;
+  for(unsigned n=size/8; n; n--, b+=8) {
+    memcpy(&w, b, 8);
+    h  = (h ^ w) * m;
+    h ^= h >> 29;
+  }
+  w = 0;
+  memcpy(&w, b, size&7);
+  h  = (h ^ w) * m;
+  h ^= h >> 32;
+  return h;
+}
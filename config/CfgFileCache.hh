@@ -0,0 +1,61 @@
+#ifndef Pds_CfgFileCache_hh
+#define Pds_CfgFileCache_hh
+
+#include <stdint.h>
+#include <string>
+
+namespace Pds {
+
+  class Src;
+  class TypeId;
+
+  //
+  //  A cache of configuration XTCs on the node, shared by all the processes
+  //  of one user that fetch them.  Each payload is stored once, in a file
+  //  named by the hash of its contents.  An index file, mapped by every
+  //  process, finds the payload for a database, key, source and type, and
+  //  records the database's stamp (see XtcClient::getXTCStamp) when it was
+  //  stored.  A lookup with any other stamp misses.  Payloads that would
+  //  take the cache over its size limit are not stored.
+  //
+  class CfgFileCache {
+  public:
+    CfgFileCache(const char* dir);
+    ~CfgFileCache();
+  public:
+    //  The cache in the directory $PDS_CFG_CACHE (e.g. under /dev/shm);
+    //  0 if it is not set or the cache cannot be opened.
+    static CfgFileCache* open();
+  public:
+    bool valid() const { return _index!=0; }
+    //  Returns the size copied to dst, or 0 if not cached with that stamp
+    int  find (const char*   dbpath,
+               unsigned      key,
+               const Src&    src,
+               const TypeId& id,
+               uint64_t      stamp,
+               void*         dst,
+               unsigned      maxSize);
+    void store(const char*   dbpath,
+               unsigned      key,
+               const Src&    src,
+               const TypeId& id,
+               uint64_t      stamp,
+               const void*   payload,
+               unsigned      size);
+  public:
+    static uint64_t hash(const void*, unsigned);
+  public:
+    class Entry;      // of the index
+  private:
+    Entry* _find (uint64_t db, unsigned key, const Src&, const TypeId&, bool lfree);
+    bool   _referenced(uint64_t hash, const Entry*) const;
+    std::string _payload(uint64_t hash, unsigned size) const;
+  private:
+    std::string _dir;
+    int         _fd;
+    Entry*      _index;
+  };
+};
+
+#endif
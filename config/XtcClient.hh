@@ -1,6 +1,8 @@
 #ifndef Pds_XtcClient_hh
 #define Pds_XtcClient_hh
 
+#include <stdint.h>
+
 namespace Pds { class Src; class TypeId; };
 
 namespace Pds_ConfigDb {
@@ -15,6 +17,11 @@ namespace Pds_ConfigDb {
                               const Pds::TypeId& type_id,
                               void*              dst,
                               unsigned           maxSize) = 0;
+    /// A stamp which changes whenever the XTC returned by getXTC may
+    /// change, cheaper to get than the XTC; 0 if unknown
+    virtual uint64_t  getXTCStamp( unsigned           key,
+                                   const Pds::Src&    src,
+                                   const Pds::TypeId& type_id) { return 0; }
   };
 };
 
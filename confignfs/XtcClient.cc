@@ -8,6 +8,7 @@
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
+#include <sys/stat.h>
 
 using namespace Pds_ConfigDb::Nfs;
 
@@ -42,3 +43,33 @@ int       XtcClient::getXTC( unsigned           key,
 
   return len;
 }
+
+//
+//  The file's identity, size and modification time.  The file is opened
+//  rather than stat'ed, so that NFS revalidates its attributes.
+//
+uint64_t  XtcClient::getXTCStamp( unsigned           key,
+                                  const Pds::Src&    src,
+                                  const Pds::TypeId& type_id)
+{
+  char filename[128];
+  sprintf(filename,"%s/keys/%s",
+          _path.c_str(),
+          CfgPath::path(key,src,type_id).c_str());
+  int fd = ::open(filename,O_RDONLY);
+  if (fd < 0)
+    return 0;
+
+  struct stat64 s;
+  int err = fstat64(fd, &s);
+  ::close(fd);
+  if (err)
+    return 0;
+
+  const uint64_t m = 0x9e3779b97f4a7c15ULL;
+  uint64_t stamp = s.st_ino;
+  stamp = (stamp ^ uint64_t(s.st_size))        * m;
+  stamp = (stamp ^ uint64_t(s.st_mtim.tv_sec)) * m;
+  stamp = (stamp ^ uint64_t(s.st_mtim.tv_nsec))* m;
+  return stamp ? stamp : 1;
+}
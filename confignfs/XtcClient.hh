@@ -20,6 +20,9 @@ namespace Pds_ConfigDb {
                         const Pds::TypeId& type_id,
                         void*              dst,
                         unsigned           maxSize);
+      uint64_t  getXTCStamp( unsigned           key,
+                             const Pds::Src&    src,
+                             const Pds::TypeId& type_id);
     private:
       std::string _path;
     };
@@ -1,6 +1,7 @@
 #include "pds/configsql/DbClient.hh"
 #include "pds/configsql/QueryProcessor.hh"
 #include "pds/config/PdsDefs.hh"
+#include "pdsdata/xtc/Src.hh"
 
 using Pds_ConfigDb::XtcEntry;
 using Pds_ConfigDb::XtcEntryT;
@@ -15,6 +16,7 @@ using Pds_ConfigDb::ExptAlias;
 #include <mysql/mysql.h>
 
 #include <stdlib.h>
+#include <string.h>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -189,6 +191,8 @@ static std::string blob(const void* payload, int len)
 DbClient::DbClient(const char* path) :
   _lock(NoLock)
 {
+  _keyXtc[0] = _keyXtc[1] = 0;
+
   //
   // Read configuration parameters and decript the passwords.
   //
@@ -256,6 +260,9 @@ DbClient::DbClient(const char* path) :
 
 DbClient::~DbClient()
 {
+  for(unsigned i=0; i<2; i++)
+    if (_keyXtc[i])
+      mysql_stmt_close( _keyXtc[i] );
   mysql_close( _mysql );
 }
 
@@ -1029,6 +1036,149 @@ int                  DbClient::setKey(const Key& key,
   return 0;
 }
 
+//
+//  The sources matched are those XtcClient looked for: at the source's
+//  level, and at the Source level only the one with its address.  The XTC
+//  is the latest of its type and name, as getXTC(const XtcEntry&) returns.
+//  A single statement reads a consistent view, so no tables are locked.
+//
+static const char* _keyXtcSql[] = {
+  "SELECT runkeys.source,runkeys.typeid,runkeys.xtcname,UNIX_TIMESTAMP(xtc.xtctime),"
+  "LENGTH(xtc.payload),CRC32(xtc.payload)"
+  " FROM runkeys JOIN xtc"
+  " ON xtc.typeid=runkeys.typeid AND xtc.xtcname=runkeys.xtcname"
+  " WHERE runkeys.runkey=? AND (runkeys.source>>56)=?"
+  " AND (?<>0 OR (runkeys.source&4294967295)=?)"
+  " AND xtc.xtctime=(SELECT MAX(x.xtctime) FROM xtc x"
+  "  WHERE x.typeid=runkeys.typeid AND x.xtcname=runkeys.xtcname);",
+  "SELECT runkeys.source,runkeys.typeid,runkeys.xtcname,UNIX_TIMESTAMP(xtc.xtctime),"
+  "LENGTH(xtc.payload),CRC32(xtc.payload),xtc.payload"
+  " FROM runkeys JOIN xtc"
+  " ON xtc.typeid=runkeys.typeid AND xtc.xtcname=runkeys.xtcname"
+  " WHERE runkeys.runkey=? AND (runkeys.source>>56)=?"
+  " AND (?<>0 OR (runkeys.source&4294967295)=?)"
+  " AND xtc.xtctime=(SELECT MAX(x.xtctime) FROM xtc x"
+  "  WHERE x.typeid=runkeys.typeid AND x.xtcname=runkeys.xtcname);" };
+
+static void _bind(MYSQL_BIND&      b,
+                  enum_field_types type,
+                  void*            buffer,
+                  unsigned long    buffer_length=0,
+                  unsigned long*   length=0)
+{
+  memset(&b, 0, sizeof(b));
+  b.buffer_type   = type;
+  b.buffer        = buffer;
+  b.buffer_length = buffer_length;
+  b.length        = length;
+  b.is_unsigned   = 1;
+}
+
+static void _stmtError(MYSQL_STMT*& stmt, const char* call) throw (DatabaseError)
+{
+  //  Prepared again on the next call, in case the connection was lost
+  std::string err = std::string("error in ")+call+"(): "+mysql_stmt_error(stmt);
+  mysql_stmt_close(stmt);
+  stmt = 0;
+  throw DatabaseError(err);
+}
+
+int                  DbClient::getKeyXTC(unsigned             key,
+                                         const Pds::Src&      src,
+                                         std::vector<KeyXtc>& entries,
+                                         std::vector<char>*   payloads)
+{
+  MYSQL_STMT*& stmt = _keyXtc[payloads ? 1:0];
+  if (!stmt) {
+    if (!(stmt = mysql_stmt_init(_mysql)))
+      throw DatabaseError( "error in mysql_stmt_init(): insufficient memory to allocate an object" );
+    const char* sql = _keyXtcSql[payloads ? 1:0];
+    if (mysql_stmt_prepare(stmt, sql, strlen(sql)))
+      _stmtError(stmt, "mysql_stmt_prepare");
+  }
+
+  unsigned level  = src.level();
+  unsigned anyphy = src.level() != Pds::Level::Source;
+  unsigned phy    = src.phy();
+  MYSQL_BIND param[4];
+  _bind(param[0], MYSQL_TYPE_LONG, &key);
+  _bind(param[1], MYSQL_TYPE_LONG, &level);
+  _bind(param[2], MYSQL_TYPE_LONG, &anyphy);
+  _bind(param[3], MYSQL_TYPE_LONG, &phy);
+  if (mysql_stmt_bind_param(stmt, param))
+    _stmtError(stmt, "mysql_stmt_bind_param");
+  if (mysql_stmt_execute(stmt))
+    _stmtError(stmt, "mysql_stmt_execute");
+
+  //
+  //  The rows are not stored by the client library, but read as they
+  //  arrive.  Each payload is bound with no space, so its length is known
+  //  when the row is fetched, and is then read directly into its place
+  //  at the end of payloads.
+  //
+  uint64_t      source;
+  unsigned      type;
+  char          name[33];
+  unsigned long name_len;
+  long long     xtctime;
+  unsigned      size;
+  unsigned      crc;
+  unsigned long payload_len=0;
+  MYSQL_BIND result[7];
+  _bind(result[0], MYSQL_TYPE_LONGLONG, &source);
+  _bind(result[1], MYSQL_TYPE_LONG    , &type);
+  _bind(result[2], MYSQL_TYPE_STRING  , name, sizeof(name), &name_len);
+  _bind(result[3], MYSQL_TYPE_LONGLONG, &xtctime);
+  _bind(result[4], MYSQL_TYPE_LONG    , &size);
+  _bind(result[5], MYSQL_TYPE_LONG    , &crc);
+  _bind(result[6], MYSQL_TYPE_BLOB    , 0, 0, &payload_len);
+  if (mysql_stmt_bind_result(stmt, result))
+    _stmtError(stmt, "mysql_stmt_bind_result");
+
+  unsigned first = entries.size();
+  int rc;
+  while((rc = mysql_stmt_fetch(stmt))==0 || rc==MYSQL_DATA_TRUNCATED) {
+    KeyXtc x;
+    x.entry.source      = source;
+    x.entry.xtc.type_id = (const Pds::TypeId&)(type);
+    x.entry.xtc.name    = std::string(name, name_len < sizeof(name) ? name_len : sizeof(name)-1);
+    x.time              = time_t(xtctime);
+    x.offset            = 0;
+    x.size              = size;
+    x.crc               = crc;
+
+    //  runkeys may list a configuration more than once
+    unsigned i=first;
+    while(i<entries.size() && !(entries[i].entry == x.entry))
+      i++;
+    if (i<entries.size())
+      continue;
+
+    if (payloads) {
+      x.offset = payloads->size();
+      x.size   = payload_len;
+      if (x.size) {
+        payloads->resize(x.offset+x.size);
+        MYSQL_BIND b;
+        _bind(b, MYSQL_TYPE_BLOB, &(*payloads)[x.offset], x.size, &payload_len);
+        if (mysql_stmt_fetch_column(stmt, &b, 6, 0)) {
+          mysql_stmt_free_result(stmt);
+          _stmtError(stmt, "mysql_stmt_fetch_column");
+        }
+      }
+    }
+    entries.push_back(x);
+  }
+
+  if (rc != MYSQL_NO_DATA) {
+    mysql_stmt_free_result(stmt);
+    _stmtError(stmt, "mysql_stmt_fetch");
+  }
+
+  mysql_stmt_free_result(stmt);
+  return entries.size()-first;
+}
+
 std::list<XtcEntry>  DbClient::getXTC(unsigned type)
 {
   std::list<XtcEntry> xlist;
@@ -4,9 +4,23 @@
 #include "pds/config/DbClient.hh"
 
 #include <mysql/mysql.h>
+#include <time.h>
+#include <vector>
+
+namespace Pds { class Src; };
 
 namespace Pds_ConfigDb {
   namespace Sql {
+    /// A configuration used by a run key, with the latest version of its XTC
+    class KeyXtc {
+    public:
+      KeyEntry entry;
+      time_t   time;
+      unsigned offset;   // of the payload
+      unsigned size;
+      unsigned crc;      // CRC32 of the payload
+    };
+
     class DbClient : public Pds_ConfigDb::DbClient {
     private:
       DbClient(const char*);
@@ -48,6 +62,14 @@ namespace Pds_ConfigDb {
 
       /// Set the configurations used by a run key
       int                  setKey(const Key&,std::list<KeyEntry>);
+
+      /// Get the configurations used by a run key for a source, with the
+      /// latest XTC of each, in one query.  The payloads are appended to
+      /// payloads, unless it is 0.  Returns the number of entries appended.
+      int                  getKeyXTC(unsigned             key,
+                                     const Pds::Src&      src,
+                                     std::vector<KeyXtc>& entries,
+                                     std::vector<char>*   payloads);
     public:
       /// Get a list of all XTCs matching type
       std::list<XtcEntry>  getXTC(unsigned type);
@@ -84,6 +106,7 @@ namespace Pds_ConfigDb {
       enum Option { Lock, NoLock };
       Option          _lock;
       MYSQL*          _mysql;
+      MYSQL_STMT*     _keyXtc[2];  // without, with payloads
     };
   };
 };
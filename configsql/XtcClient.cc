@@ -1,16 +1,20 @@
 #include "pds/configsql/XtcClient.hh"
 #include "pds/configsql/DbClient.hh"
-#include "pds/config/DeviceEntry.hh"
 #include "pdsdata/xtc/Src.hh"
 #include "pdsdata/xtc/TypeId.hh"
 
 #include <stdio.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <string.h>
 
 using namespace Pds_ConfigDb::Sql;
 
-XtcClient::XtcClient(const char* path) : _db(DbClient::open(path))
+XtcClient::XtcClient(const char* path) :
+  _db      (DbClient::open(path)),
+  _valid   (false),
+  _payloads(false),
+  _key     (0)
 {
   printf("Sql::XtcClient %s\n",path);
 }
@@ -25,22 +29,70 @@ XtcClient* XtcClient::open  ( const char* path )
   return new XtcClient(path); 
 }
 
+const KeyXtc* XtcClient::_fetch( unsigned           key,
+                                 const Pds::Src&    src,
+                                 const Pds::TypeId& type_id,
+                                 bool               payloads)
+{
+  if (!(_valid && _key == key && _src == src && (_payloads || !payloads))) {
+    _valid = false;
+    _entries.clear();
+    _payload.clear();  // keeps its capacity for the next key
+    _db->getKeyXTC(key, src, _entries, payloads ? &_payload : 0);
+    _valid    = true;
+    _payloads = payloads;
+    _key      = key;
+    _src      = src;
+  }
+
+  for(unsigned i=0; i<_entries.size(); i++)
+    if (_entries[i].entry.xtc.type_id.value() == type_id.value())
+      return &_entries[i];
+
+  return 0;
+}
+
 int       XtcClient::getXTC( unsigned           key,
                              const Pds::Src&    src,
                              const Pds::TypeId& type_id,
                              void*              dst,
                              unsigned           maxSize)
 {
-  std::list<KeyEntry> klist = _db->getKey(key);
-  for(std::list<KeyEntry>::iterator it=klist.begin();
-      it!=klist.end(); it++) {
-    DeviceEntry d(it->source);
-    if (d.level() == src.level() &&
-        (d.phy  () == src.phy() ||
-         d.level() != Pds::Level::Source) &&
-        it->xtc.type_id.value() == type_id.value())
-      return _db->getXTC(it->xtc, dst, maxSize);
+  const KeyXtc* x = _fetch(key, src, type_id, true);
+  if (!x)
+    return 0;
+
+  //  Never return a truncated configuration
+  if (x->size > maxSize) {
+    printf("Sql::XtcClient::getXTC %s size %u exceeds buffer %u\n",
+           x->entry.xtc.name.c_str(), x->size, maxSize);
+    return -1;
   }
 
-  return 0;
+  if (x->size)
+    memcpy(dst, &_payload[x->offset], x->size);
+  return x->size;
+}
+
+//
+//  The name, time, length and CRC32 of the latest version of the XTC,
+//  which is what getXTC returns.  The time alone has a resolution of one
+//  second.
+//
+uint64_t  XtcClient::getXTCStamp( unsigned           key,
+                                  const Pds::Src&    src,
+                                  const Pds::TypeId& type_id)
+{
+  const KeyXtc* x = _fetch(key, src, type_id, false);
+  if (!x || x->time == 0)
+    return 0;
+
+  const uint64_t m = 0x9e3779b97f4a7c15ULL;
+  uint64_t stamp = uint64_t(x->time) * m;
+  for(unsigned i=0; i<x->entry.xtc.name.size(); i++)
+    stamp = (stamp ^ uint8_t(x->entry.xtc.name[i])) * m;
+  stamp = (stamp ^ type_id.value()) * m;
+  stamp = (stamp ^ x->size) * m;
+  stamp = (stamp ^ x->crc) * m;
+  return stamp ? stamp : 1;
 }
@@ -2,12 +2,14 @@
 #define Pds_XtcClientSql_hh
 
 #include "pds/config/XtcClient.hh"
+#include "pds/configsql/DbClient.hh"
+#include "pdsdata/xtc/Src.hh"
 
 #include <string>
+#include <vector>
 
 namespace Pds_ConfigDb {
   namespace Sql {
-    class DbClient;
     class XtcClient : public Pds_ConfigDb::XtcClient {
     private:
       XtcClient(const char*);
@@ -21,8 +23,27 @@ namespace Pds_ConfigDb {
                         const Pds::TypeId& type_id,
                         void*              dst,
                         unsigned           maxSize);
+      uint64_t  getXTCStamp( unsigned           key,
+                             const Pds::Src&    src,
+                             const Pds::TypeId& type_id);
+    private:
+      const KeyXtc* _fetch( unsigned           key,
+                            const Pds::Src&    src,
+                            const Pds::TypeId& type_id,
+                            bool               payloads);
     private:
       DbClient* _db;
+      //
+      //  The configurations of the last key and source, all fetched in one
+      //  query; without the payloads if only the stamps were asked for.
+      //  As CfgClientNfs, they are kept until the key changes.
+      //
+      bool                _valid;
+      bool                _payloads;
+      unsigned            _key;
+      Pds::Src            _src;
+      std::vector<KeyXtc> _entries;
+      std::vector<char>   _payload;
     };
   };
 };
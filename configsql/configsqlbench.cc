@@ -0,0 +1,146 @@
+//
+//  Time to fetch the configuration of every device for a Configure, one
+//  query per XTC with a run key lookup for each (as Sql::XtcClient did),
+//  and with one DbClient::getKeyXTC per device, against the number of
+//  devices.  Each device has its own XTCs, under a run key made for each
+//  device count.  Run it against a scratch database: the XTCs it writes
+//  are left in the xtc table.
+//
+#include "pds/configsql/DbClient.hh"
+#include "pds/config/DeviceEntry.hh"
+#include "pdsdata/xtc/DetInfo.hh"
+#include "pdsdata/xtc/TypeId.hh"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <vector>
+
+using namespace Pds_ConfigDb;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+static void usage(const char* p)
+{
+  printf("Usage: %s -p <db path file> [-n <max devices>] [-t <XTCs per device>] [-s <XTC bytes>] [-r <repeats>]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  const char* path     = 0;
+  unsigned    ndevices = 256;
+  unsigned    ntypes   = 4;
+  unsigned    size     = 16384;
+  unsigned    repeats  = 5;
+
+  int c;
+  while ((c = getopt(argc, argv, "p:n:t:s:r:h")) != -1) {
+    switch(c) {
+    case 'p': path     = optarg; break;
+    case 'n': ndevices = strtoul(optarg,NULL,0); break;
+    case 't': ntypes   = strtoul(optarg,NULL,0); break;
+    case 's': size     = strtoul(optarg,NULL,0); break;
+    case 'r': repeats  = strtoul(optarg,NULL,0); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  if (!path || !ndevices || !ntypes || !repeats) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  Sql::DbClient* db = Sql::DbClient::open(path);
+
+  std::vector<Pds::DetInfo> srcs;
+  for(unsigned i=0; i<ndevices; i++)
+    srcs.push_back(Pds::DetInfo(0, Pds::DetInfo::NoDetector, i>>8,
+                                Pds::DetInfo::NoDevice, i&0xff));
+
+  //  The XTCs of every device
+  std::vector<char>     payload(size);
+  std::list<KeyEntry>   all;
+  db->begin();
+  for(unsigned i=0; i<ndevices; i++)
+    for(unsigned j=0; j<ntypes; j++) {
+      KeyEntry e;
+      e.source      = DeviceEntry(srcs[i]).value();
+      e.xtc.type_id = Pds::TypeId(Pds::TypeId::Type(j+1), 1);
+      char name[32];
+      sprintf(name, "bench_%u", i);
+      e.xtc.name    = name;
+      for(unsigned k=0; k<size; k++)
+        payload[k] = char(i+j+k);
+      db->setXTC(e.xtc, &payload[0], size);
+      all.push_back(e);
+    }
+  db->commit();
+
+  printf("%u XTCs per device, %u bytes each, %u repeats\n", ntypes, size, repeats);
+  printf("Configure time (ms)\n%8s %16s %16s\n", "devices", "query per XTC", "query per device");
+
+  std::vector<char>        dst(size);
+  std::vector<Sql::KeyXtc> entries;
+  std::vector<char>        payloads;
+  std::list<Key>           keys;
+
+  for(unsigned n=1; n<=ndevices; n<<=1) {
+    //  A run key for the first n devices
+    Key key;
+    key.key  = db->getNextKey();
+    key.time = 0;
+    key.name = "configsqlbench";
+    std::list<KeyEntry> kentries;
+    std::list<KeyEntry>::iterator it=all.begin();
+    for(unsigned i=0; i<n*ntypes; i++)
+      kentries.push_back(*it++);
+    db->begin();
+    db->setKey(key, kentries);
+    db->commit();
+    keys.push_back(key);
+
+    double tq=0, tb=0;
+    for(unsigned r=0; r<repeats; r++) {
+      double t0 = now();
+      for(unsigned i=0; i<n; i++) {
+        uint64_t source = DeviceEntry(srcs[i]).value();
+        for(unsigned j=0; j<ntypes; j++) {
+          unsigned type = Pds::TypeId(Pds::TypeId::Type(j+1), 1).value();
+          std::list<KeyEntry> klist = db->getKey(key.key);
+          for(std::list<KeyEntry>::iterator kt=klist.begin(); kt!=klist.end(); kt++)
+            if (kt->source == source && kt->xtc.type_id.value() == type) {
+              db->getXTC(kt->xtc, &dst[0], size);
+              break;
+            }
+        }
+      }
+      double t1 = now();
+      for(unsigned i=0; i<n; i++) {
+        entries .clear();
+        payloads.clear();
+        db->getKeyXTC(key.key, srcs[i], entries, &payloads);
+        for(unsigned j=0; j<entries.size(); j++)
+          memcpy(&dst[0], &payloads[entries[j].offset], entries[j].size);
+      }
+      tq += t1-t0;
+      tb += now()-t1;
+    }
+    printf("%8u %16.2f %16.2f\n", n, 1.e3*tq/repeats, 1.e3*tb/repeats);
+  }
+
+  //  Remove the run keys
+  db->begin();
+  for(std::list<Key>::iterator it=keys.begin(); it!=keys.end(); it++)
+    db->setKey(*it, std::list<KeyEntry>());
+  db->commit();
+
+  delete db;
+  return 0;
+}
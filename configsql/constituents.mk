@@ -5,3 +5,11 @@ libsrcs_configsql += QueryProcessor.cc
 libsrcs_configsql += DbClient.cc
 libsrcs_configsql += XtcClient.cc
 libincs_configsql := pdsdata/include mysql/include
+
+tgtnames := configsqlbench
+
+tgtsrcs_configsqlbench := configsqlbench.cc
+tgtlibs_configsqlbench := pds/configsql pds/configdbc
+tgtlibs_configsqlbench += pdsdata/xtcdata mysql/mysqlclient
+tgtslib_configsqlbench := $(USRLIBDIR)/rt
+tgtincs_configsqlbench := pdsdata/include mysql/include
@@ -149,7 +149,7 @@ class CspadUnmapAction : public Action {
 
 class CspadL1Action : public Action {
  public:
-   CspadL1Action(CspadServer* svr, CspadCompressionProcessor& processor, bool compress=false);
+   CspadL1Action(CspadServer* svr, CspadCompressionProcessor* processor);
 
    InDatagram* fire(InDatagram* in);
    void        reset(bool f=true);
@@ -160,7 +160,7 @@ private:
    inline InDatagram* postData(InDatagram* in);
    
    CspadServer* server;
-   CspadCompressionProcessor& _processor;
+   CspadCompressionProcessor* _processor;
    unsigned _lastMatchedFiducial;
    unsigned _lastMatchedFrameNumber;
    unsigned _lastMatchedAcqCount;
@@ -177,7 +177,7 @@ void CspadL1Action::reset(bool resetError) {
   if (resetError) _frameSyncErrorCount = 0;
 }
 
-CspadL1Action::CspadL1Action(CspadServer* svr, CspadCompressionProcessor& processor,  bool compress) :
+CspadL1Action::CspadL1Action(CspadServer* svr, CspadCompressionProcessor* processor) :
     server(svr),
     _processor(processor),
     _lastMatchedFiducial(0xffffffff),
@@ -186,14 +186,14 @@ CspadL1Action::CspadL1Action(CspadServer* svr, CspadCompressionProcessor& proces
     _resetCount(0),
     _damageCount(0),
     //_bUseCompressor(server->xtc().contains.id() == TypeId::Id_CspadElement)
-    _bUseCompressor(compress)
+    _bUseCompressor(processor!=0)
     {}
 
 inline InDatagram* CspadL1Action::postData(InDatagram* in)
 {
   if (_bUseCompressor)
   {
-    _processor.postData(*in); 
+    _processor->postData(*in); 
     return (InDatagram*) Appliance::DontDelete;            
   }
   
@@ -277,7 +277,7 @@ InDatagram* CspadL1Action::fire(InDatagram* in) {
         if (!_bUseCompressor)
           return postData(in);           
 
-        _processor.compressData(*in);
+        _processor->compressData(*in);
         
         // processor thread will post the compressed datagram
         return (InDatagram*) Appliance::DontDelete;
@@ -291,10 +291,10 @@ InDatagram* CspadL1Action::fire(InDatagram* in) {
 class CspadConfigAction : public Action {
 
   public:
-    CspadConfigAction( Pds::CspadConfigCache& cfg, CspadServer* server, CspadCompressionProcessor& processor, bool compress)
+    CspadConfigAction( Pds::CspadConfigCache& cfg, CspadServer* server, CspadCompressionProcessor* processor)
     : _cfg( cfg ), _server(server), _occPool(new GenericPool(sizeof(UserMessage),4)),  _processor(processor), _result(0),
       //_bUseCompressor(_server->xtc().contains.id() == TypeId::Id_CspadElement)
-      _bUseCompressor(compress)
+      _bUseCompressor(processor!=0)
       {}
 
     ~CspadConfigAction() {}
@@ -340,7 +340,7 @@ class CspadConfigAction : public Action {
       }
       
       if (in->datagram().xtc.damage.value() == 0 && _bUseCompressor) {
-        _processor.readConfig(&(in->datagram().xtc));
+        _processor->readConfig(&(in->datagram().xtc));
       }
       return in;
     }
@@ -349,7 +349,7 @@ class CspadConfigAction : public Action {
     CspadConfigCache&   _cfg;
     CspadServer*    _server;
     GenericPool*        _occPool;
-    CspadCompressionProcessor&  _processor;
+    CspadCompressionProcessor*  _processor;
   unsigned       _result;
     bool                        _bUseCompressor;    
 };
@@ -483,19 +483,20 @@ public:
 
 CspadManager::CspadManager( CspadServer* server, int d, bool c) :
     _fsm(*new Fsm), _cfg(*new CspadConfigCache(server->client())),
-    _appProcessor(*new AppProcessor()), _compressionProcessor(_appProcessor, 14, 32, server->debug())
+    _appProcessor(*new AppProcessor()),
+    _compressionProcessor(c ? new CspadCompressionProcessor(_appProcessor, 14, 32, server->debug()) : 0)
 {
 
    printf("CspadManager being initialized... " );
 
    server->manager(this);
 
-   CspadL1Action* l1 = new CspadL1Action( server, _compressionProcessor, c );
+   CspadL1Action* l1 = new CspadL1Action( server, _compressionProcessor );
    _fsm.callback( TransitionId::L1Accept, l1 );
 
    _fsm.callback( TransitionId::Map,             new CspadAllocAction( _cfg ) );
    _fsm.callback( TransitionId::Unmap,           new CspadUnmapAction( server ) );
-   _fsm.callback( TransitionId::Configure,       new CspadConfigAction(_cfg, server, _compressionProcessor, c ) );
+   _fsm.callback( TransitionId::Configure,       new CspadConfigAction(_cfg, server, _compressionProcessor ) );
    _fsm.callback( TransitionId::Enable,          new CspadEnableAction( server ) );
    _fsm.callback( TransitionId::Disable,         new CspadDisableAction( server ) );
    _fsm.callback( TransitionId::BeginCalibCycle, new CspadBeginCalibCycleAction( server, _cfg, *l1 ) );
@@ -22,7 +22,7 @@ namespace Pds {
       Fsm&                           _fsm;
       CspadConfigCache&              _cfg;
       Appliance&                     _appProcessor;
-      Pds::CspadCompressionProcessor _compressionProcessor;
+      Pds::CspadCompressionProcessor* _compressionProcessor;  // only when compressing
   };
 
 #endif
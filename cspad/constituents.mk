@@ -10,8 +10,8 @@ libsrcs_cspad := \
                  Processor.cc \
                  CspadServer.cc \
                  CspadManager.cc \
-                 CspadOccurrence.cc
-#                 CompressionProcessor.cc \
+                 CspadOccurrence.cc \
+                 CompressionProcessor.cc
 
 #libsinc_cspad :=
 libincs_cspad := pgpcard aesdriver/include
@@ -3,6 +3,7 @@
 #include <vector>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 #include "pdsdata/xtc/TypeId.hh"
 #include "pds/xtc/Datagram.hh"
 #include "pds/service/GenericPool.hh"
@@ -10,6 +11,7 @@
 #include "pds/config/EpicsConfigType.hh"
 #include "XtcEpicsPv.hh"
 #include "EpicsArchMonitor.hh"
+#include "EpicsArchSchedule.hh"
 
 namespace Pds
 {
@@ -20,7 +22,8 @@ using std::stringstream;
 EpicsArchMonitor::EpicsArchMonitor(const Src & src, const std::string & sFnConfig,
   float fDefaultInterval, int iNumEventNode, Pool & occPool, int iDebugLevel, int iIgnoreLevel, std::string& sConfigFileWarning):
   _src(src), _sFnConfig(sFnConfig), _fDefaultInterval(fDefaultInterval), _iNumEventNode(iNumEventNode),
-  _occPool(occPool), _iDebugLevel(iDebugLevel), _iIgnoreLevel(iIgnoreLevel)
+  _occPool(occPool), _iDebugLevel(iDebugLevel), _iIgnoreLevel(iIgnoreLevel),
+  _pSchedule(NULL)
 {
   if (_sFnConfig == "")
     throw string("EpicsArchMonitor::EpicsArchMonitor(): Invalid parameters");
@@ -73,6 +76,8 @@ EpicsArchMonitor::~EpicsArchMonitor()
   if (ECA_NORMAL != iFail)
     SEVCHK(iFail,
            "EpicsArchMonitor::~EpicsArchMonitor(): ca_task_exit() failed");
+
+  delete _pSchedule;
 }
 
 //static int getLocalTime( const timespec& ts, char* sTime )
@@ -95,20 +100,42 @@ int EpicsArchMonitor::writeToXtc(Datagram & dg, UserMessage ** msg, const struct
 
   const int iNumPv = _lpvPvList.size();
 
+  _viWrite.clear();
+
   if (!bCtrlValue)
   {
-    bool bAnyPvWantsWrite = false;
+    /*
+     * Only the PVs whose update interval has elapsed become due; each is
+     * then written once to every event node.
+     */
+    _viDue.clear();
+    _pSchedule->collect(tsCurrent, _viDue);
+    for (unsigned u = 0; u < _viDue.size(); u++)
+    {
+      _lpvPvList[_viDue[u]].armWriteEvent();
+      _addPending(_viDue[u]);
+    }
 
-    for (int iPvName = 0; iPvName < iNumPv; iPvName++)
+    unsigned uKeep = 0;
+    for (unsigned u = 0; u < _viPending.size(); u++)
     {
+      int iPvName = _viPending[u];
       EpicsMonitorPv & epicsPvCur = _lpvPvList[iPvName];
 
-      if (epicsPvCur.checkWriteEvent(tsCurrent, uVectorCur) )
-        bAnyPvWantsWrite = true;
+      if (epicsPvCur.checkWriteEvent(uVectorCur) )
+        _viWrite.push_back(iPvName);
+
+      if (epicsPvCur.isWritePending())
+        _viPending[uKeep++] = iPvName;
+      else
+        _vbPending[iPvName] = 0;
     }
+    _viPending.resize(uKeep);
 
-    if (!bAnyPvWantsWrite)
+    if (_viWrite.empty())
       return 0;
+
+    std::sort(_viWrite.begin(), _viWrite.end());
   }
   else
   {
@@ -125,6 +152,9 @@ int EpicsArchMonitor::writeToXtc(Datagram & dg, UserMessage ** msg, const struct
     }
 
     dg.xtc.alloc(pXtcConfig->sizeofPayload());
+
+    for (int iPvName = 0; iPvName < iNumPv; iPvName++)
+      _viWrite.push_back(iPvName);
   }
 
   TypeId typeIdXtc(EpicsArchMonitor::typeXtc, EpicsArchMonitor::iXtcVersion);
@@ -139,12 +169,9 @@ int EpicsArchMonitor::writeToXtc(Datagram & dg, UserMessage ** msg, const struct
   bool bAnyPvWriteOkay      = false;
   bool bSomePvWriteError    = false;
   bool bSomePvNotConnected  = false; // PV not connected: Less serious than the "Write Error"
-  for (int iPvName = 0; iPvName < iNumPv; iPvName++)
+  for (unsigned uWrite = 0; uWrite < _viWrite.size(); uWrite++)
   {
-    EpicsMonitorPv & epicsPvCur = _lpvPvList[iPvName];
-
-    if (! (bCtrlValue || epicsPvCur.isWriteEvent() ) )
-      continue;
+    EpicsMonitorPv & epicsPvCur = _lpvPvList[_viWrite[uWrite]];
 
     if (_iDebugLevel >= 1)
       epicsPvCur.printPv();
@@ -153,9 +180,21 @@ int EpicsArchMonitor::writeToXtc(Datagram & dg, UserMessage ** msg, const struct
     //printf("Writing PV [%d] %s (%s) C %d\n", epicsPvCur.getPvId(), epicsPvCur.getPvDescription().c_str(),
     //  epicsPvCur.getPvName().c_str(), (int) (bCtrlValue) );
 
-    XtcEpicsPv *pXtcEpicsPvCur = new(&dg.xtc) XtcEpicsPv(typeIdXtc, _src);
+    int iFail;
+    if (bCtrlValue)
+    {
+      XtcEpicsPv *pXtcEpicsPvCur = new(&dg.xtc) XtcEpicsPv(typeIdXtc, _src);
 
-    int iFail = pXtcEpicsPvCur->setValue(epicsPvCur, bCtrlValue);
+      iFail = pXtcEpicsPvCur->setValue(epicsPvCur, bCtrlValue);
+    }
+    else
+    {
+      // The time value is kept laid out as its Xtc by the CA handler
+      int iSizeXtc = 0;
+      iFail = epicsPvCur.writeTimeXtc((char *) dg.xtc.next(), iSizeXtc);
+      if (iFail == 0)
+        dg.xtc.alloc(iSizeXtc);
+    }
 
     if (iFail == 0)
       bAnyPvWriteOkay = true;
@@ -212,7 +251,7 @@ int EpicsArchMonitor::writeToXtc(Datagram & dg, UserMessage ** msg, const struct
         ("EpicsArchMonitor::writeToXtc(): Pool buffer size is too small.\n");
       printf
         ("EpicsArchMonitor::writeToXtc(): %d Pvs are stored in 90%% of the pool buffer (size = %d bytes)\n",
-         iPvName + 1, EpicsArchMonitor::iMaxXtcSize);
+         uWrite + 1, EpicsArchMonitor::iMaxXtcSize);
       if (bCtrlValue && (*msg) == 0)
       {
         if (_occPool.numberOfFreeObjects()) {
@@ -259,6 +298,7 @@ int EpicsArchMonitor::validate(int iNumEventNode)
     }
 
     epicsPvCur.resetUpdates(iNumEventNode);
+    _addPending(iPvName);
   }
 
   return nNotConnected;
@@ -272,11 +312,22 @@ int EpicsArchMonitor::resetUpdates(int iNumEventNode)
     EpicsMonitorPv & epicsPvCur = _lpvPvList[iPvName];
 
     if (epicsPvCur.isConnected())
+    {
       epicsPvCur.resetUpdates(iNumEventNode);
+      _addPending(iPvName);
+    }
   }
   return 0;
 }
 
+void EpicsArchMonitor::_addPending(int iPvName)
+{
+  if (_vbPending[iPvName])
+    return;
+  _vbPending[iPvName] = 1;
+  _viPending.push_back(iPvName);
+}
+
 /*
 * private static member functions
 */
@@ -294,13 +345,19 @@ int EpicsArchMonitor::_setupPvList(const Pds::PvConfigFile::TPvList & vPvList,
 
 
   lpvPvList.resize(vPvList.size());
+  _pSchedule = new EpicsArchSchedule(vPvList.size());
+  _vbPending.assign(vPvList.size(), 0);
+  _viPending.clear();
   for (int iPvName = 0; iPvName < (int) vPvList.size(); iPvName++)
   {
     EpicsMonitorPv & epicsPvCur = lpvPvList[iPvName];
 
     int iFail = epicsPvCur.init(iPvName, vPvList[iPvName].sPvName,
       vPvList[iPvName].sPvDescription, vPvList[iPvName].fUpdateInterval,
-      _iNumEventNode);
+      _iNumEventNode, _src, _pSchedule);
+
+    // init() leaves the PV to be written to every event node
+    _addPending(iPvName);
 
     if (iFail != 0)
     {
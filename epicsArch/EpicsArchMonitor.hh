@@ -12,6 +12,7 @@ namespace Pds
 {
   class Pool;
   class UserMessage;
+  class EpicsArchSchedule;
 
   class EpicsArchMonitor
   {
@@ -42,6 +43,11 @@ namespace Pds
     int         _iIgnoreLevel;
     TPvNameSet  _setPv;
     TEpicsMonitorPvList _lpvPvList;    
+    EpicsArchSchedule*  _pSchedule;
+    std::vector<int>    _viPending;   // PVs with event nodes still to be written
+    std::vector<char>   _vbPending;
+    std::vector<int>    _viDue;
+    std::vector<int>    _viWrite;
 
     struct PvInfo
     {
@@ -58,6 +64,7 @@ namespace Pds
     };
 
     int _setupPvList      (const Pds::PvConfigFile::TPvList & vPvList, TEpicsMonitorPvList & lpvPvList);
+    void _addPending      (int iPvName);
 
     // Class usage control: Value semantics is disabled
     EpicsArchMonitor(const EpicsArchMonitor &);
@@ -0,0 +1,128 @@
+#include "EpicsArchSchedule.hh"
+
+namespace Pds
+{
+
+EpicsArchSchedule::EpicsArchSchedule(int iNumPv) :
+  _iHead      (-1),
+  _viNext     (iNumPv, -1),
+  _viQueued   (iNumPv, 0),
+  _vvSlot     (iNumSlots),
+  _vfDeadline (iNumPv, 0),
+  _vfInterval (iNumPv, 0),
+  _vuGen      (iNumPv, 0),
+  _llTick     (0),
+  _bStarted   (false)
+{
+}
+
+void EpicsArchSchedule::setInterval(int iPv, float fUpdateInterval)
+{
+  _vfInterval[iPv] = fUpdateInterval;
+  if (fUpdateInterval > 0)
+    wake(iPv);
+  else
+    _viEvery.push_back(iPv);
+}
+
+void EpicsArchSchedule::wake(int iPv)
+{
+  if (iPv < 0 || iPv >= (int) _viQueued.size())
+    return;
+
+  // Already on the list
+  if (!__sync_bool_compare_and_swap(&_viQueued[iPv], 0, 1))
+    return;
+
+  int iHead;
+  do
+  {
+    iHead        = _iHead;
+    _viNext[iPv] = iHead;
+  }
+  while (!__sync_bool_compare_and_swap(&_iHead, iHead, iPv));
+}
+
+void EpicsArchSchedule::collect(const struct timespec& tsCurrent, std::vector<int>& vDue)
+{
+  double    fNow   = tsCurrent.tv_sec + tsCurrent.tv_nsec * 1e-9;
+  long long llTick = (long long) (fNow * iSlotsPerSecond);
+
+  if (!_bStarted)
+  {
+    _llTick   = llTick;
+    _bStarted = true;
+  }
+
+  _viDue.clear();
+
+  /*
+   * Take the whole list of woken PVs at once; a PV may be pushed again as
+   * soon as its flag is cleared, so its link is read first.  A woken PV's
+   * entry on the wheel is made stale, and it is rescheduled below.
+   */
+  int iPv = __sync_lock_test_and_set(&_iHead, -1);
+  while (iPv >= 0)
+  {
+    int iNext = _viNext[iPv];
+    __sync_lock_release(&_viQueued[iPv]);
+    if (_vfInterval[iPv] > 0)
+    {
+      _vuGen[iPv]++;
+      _viDue.push_back(iPv);
+    }
+    iPv = iNext;
+  }
+
+  /*
+   * Visit the slots from the last trigger's through the current one.  The
+   * current slot is visited again on the next trigger, since its PVs may be
+   * due later within the slot.  Each slot is visited at most once.
+   */
+  long long llFrom = _llTick;
+  if (llTick < llFrom)
+    llFrom = llTick;
+  else if (llTick - llFrom >= iNumSlots)
+    llFrom = llTick - iNumSlots + 1;
+
+  for (long long llSlot = llFrom; llSlot <= llTick; llSlot++)
+  {
+    std::vector<Entry>& vSlot = _vvSlot[llSlot % iNumSlots];
+    unsigned uKeep = 0;
+    for (unsigned u = 0; u < vSlot.size(); u++)
+    {
+      const Entry& entry = vSlot[u];
+      if (entry.uGen != _vuGen[entry.iPv])
+        continue;                       // woken since
+      if (_vfDeadline[entry.iPv] <= fNow)
+        _viDue.push_back(entry.iPv);
+      else
+        vSlot[uKeep++] = entry;         // a later turn of the wheel
+    }
+    vSlot.resize(uKeep);
+  }
+
+  _llTick = llTick;
+
+  // Due now, and again an interval from now whether or not it changes
+  for (unsigned u = 0; u < _viDue.size(); u++)
+  {
+    _schedule(_viDue[u], fNow);
+    vDue.push_back(_viDue[u]);
+  }
+  vDue.insert(vDue.end(), _viEvery.begin(), _viEvery.end());
+}
+
+void EpicsArchSchedule::_schedule(int iPv, double fNow)
+{
+  double    fDeadline  = fNow + _vfInterval[iPv];
+  long long llDeadline = (long long) (fDeadline * iSlotsPerSecond);
+
+  _vfDeadline[iPv] = fDeadline;
+  Entry entry;
+  entry.iPv  = iPv;
+  entry.uGen = ++_vuGen[iPv];
+  _vvSlot[llDeadline % iNumSlots].push_back(entry);
+}
+
+}       // namespace Pds
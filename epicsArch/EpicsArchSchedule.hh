@@ -0,0 +1,69 @@
+#ifndef EPICS_ARCH_SCHEDULE_H
+#define EPICS_ARCH_SCHEDULE_H
+
+#include <vector>
+#include <time.h>
+
+namespace Pds
+{
+
+  /*
+   * Decides which PVs are due for archiving on a trigger, without scanning
+   * the whole PV list.
+   *
+   * Every PV sits on a timer wheel at the time its update interval will
+   * have elapsed since it was last due.  On each trigger, collect() returns
+   * the PVs whose time has come and puts each back on the wheel an interval
+   * later, so that every PV is archived once per interval as before, and
+   * only the PVs in the slots passed since the last trigger are visited.
+   * The PVs without an interval are due on every trigger, and are kept
+   * off the wheel.
+   *
+   * wake() makes a PV due on the next trigger, ahead of its interval; it is
+   * called from the CA threads (on a disconnection) and on a reconnect.  The
+   * woken PVs are pushed onto a lock-free list, once until it is collected.
+   */
+  class EpicsArchSchedule
+  {
+  public:
+    EpicsArchSchedule(int iNumPv);
+
+    // Sets the interval, and makes the PV due on the next trigger
+    void setInterval(int iPv, float fUpdateInterval);
+
+    // Called from any thread
+    void wake       (int iPv);
+
+    // Appends the PVs due at tsCurrent to vDue
+    void collect    (const struct timespec& tsCurrent, std::vector<int>& vDue);
+
+    static const int iNumSlots       = 1024;
+    static const int iSlotsPerSecond = 64;
+
+  private:
+    void _schedule(int iPv, double fNow);
+
+    // the lock-free list of woken PVs
+    volatile int        _iHead;
+    std::vector<int>    _viNext;
+    std::vector<int>    _viQueued;
+
+    // the timer wheel; an entry is stale once its PV has been rescheduled
+    struct Entry { int iPv; unsigned uGen; };
+    std::vector< std::vector<Entry> > _vvSlot;
+    std::vector<double>   _vfDeadline;
+    std::vector<float>    _vfInterval;
+    std::vector<unsigned> _vuGen;
+    std::vector<int>      _viDue;
+    std::vector<int>      _viEvery;     // PVs due on every trigger
+    long long             _llTick;
+    bool                  _bStarted;
+
+    // Class usage control: Value semantics is disabled
+    EpicsArchSchedule(const EpicsArchSchedule &);
+    EpicsArchSchedule & operator=(const EpicsArchSchedule &);
+  };
+
+}       // namespace Pds
+
+#endif
@@ -1,4 +1,6 @@
 #include "EpicsMonitorPv.hh"
+#include "EpicsArchSchedule.hh"
+#include "EpicsXtcSettings.hh"
 
 #define epicsAlarmGLOBAL
 #include <alarm.h>
@@ -10,16 +12,21 @@ namespace Pds
 
   int EpicsMonitorPv::init(int iPvId, 
     const std::string & sPvName, const std::string & sPvDescription,
-    float fUpdateInterval, int iNumEventNode)
+    float fUpdateInterval, int iNumEventNode, const Src & src, EpicsArchSchedule * pSchedule)
   {
     release();
 
+    _xtcTimeHeader = Xtc(TypeId(EpicsXtcSettings::typeXtc, EpicsXtcSettings::iXtcVersion), src);
+
     _iPvId            = iPvId;
     _sPvName          = sPvName;
     _sPvDescription   = sPvDescription;
     _fUpdateInterval  = fUpdateInterval;
     _iNumEventNode    = iNumEventNode;
-    _tsLastUpdate.tv_sec = _tsLastUpdate.tv_nsec = 0;
+    _pSchedule        = pSchedule;
+    _iScheduleId      = iPvId;
+    if (_pSchedule)
+      _pSchedule->setInterval(_iScheduleId, _fUpdateInterval);
     _iCaStatus = ca_create_channel(_sPvName.c_str(), caConnectionHandler, // event handler
            this, _iCaChannelPriority, &_chidPv);
     if (_iCaStatus != ECA_NORMAL)
@@ -36,7 +43,8 @@ namespace Pds
   int EpicsMonitorPv::reconnect()
   {
     release();
-    _tsLastUpdate.tv_sec = _tsLastUpdate.tv_nsec = 0;
+    if (_pSchedule)
+      _pSchedule->wake(_iScheduleId);
     _iCaStatus = ca_create_channel(_sPvName.c_str(), caConnectionHandler, // event handler
                                    this, _iCaChannelPriority, &_chidPv);
     if (_iCaStatus != ECA_NORMAL)
@@ -77,6 +85,11 @@ namespace Pds
     free(_pCtrlValue);
     _pCtrlValue = NULL;
 
+    free(_pcTimeXtc[0]);
+    _pcTimeXtc[0] = _pcTimeXtc[1] = NULL;
+    _uTimeXtcSeq   = 0;
+    _uTimeXtcIndex = 0;
+
     _evidCtrl = NULL;
     _evidTime = NULL;
 
@@ -127,6 +140,22 @@ namespace Pds
         return 1;
       }
     }
+    if (!_pcTimeXtc[0])
+    {
+      /*
+       * The Xtc of a time value is no larger than its DBR with the Xtc
+       * header and some slack
+       */
+      _iSizeTimeXtcBuffer = (sizeof(Xtc) + dbr_size_n(_lDbrTimeType, _ulNumElems) +
+                             _iSizeTimeXtcSlack + 7) & ~7;
+      _pcTimeXtc[0] = (char *) malloc(2 * _iSizeTimeXtcBuffer);
+      if (!_pcTimeXtc[0])
+      {
+        printf("EpicsMonitorPv::onCaChannelConnected()::malloc() failed\n");
+        return 1;
+      }
+      _pcTimeXtc[1] = _pcTimeXtc[0] + _iSizeTimeXtcBuffer;
+    }
     if (!_pCtrlValue)
     {
       /* 
@@ -183,6 +212,10 @@ namespace Pds
     // The channel might be just temporarily reset
     // so here we only set the flag to be false, and wait for it to come back in the future 
     _bConnected = false;
+
+    // Archive the disconnection without waiting for the interval
+    if (_pSchedule)
+      _pSchedule->wake(_iScheduleId);
     return 0;
   }
 
@@ -205,8 +238,9 @@ namespace Pds
 
     if (args.type == _lDbrTimeType)
     {
-      _bTimeValueUpdated = true;
       memcpy(_pTimeValue, args.dbr, dbr_size_n(args.type, args.count));
+      publishTimeXtc();
+      _bTimeValueUpdated = true;
     }
     else if (args.type == _lDbrCtrlType)
     {
@@ -320,34 +354,103 @@ namespace Pds
     &EpicsMonitorPv::writeXtcTimeValueByDbrId < DBR_DOUBLE >
   };
 
-  bool EpicsMonitorPv::checkWriteEvent(const struct timespec& tsCurrent, unsigned int uVectorCur)
+  /*
+   * The PV is due (see EpicsArchSchedule): write it once to each event node
+   */
+  void EpicsMonitorPv::armWriteEvent()
+  {
+    _u64MaskEventNode = ( ((uint64_t)1) << _iNumEventNode) - 1;    
+  }
+
+  bool EpicsMonitorPv::checkWriteEvent(unsigned int uVectorCur)
   {    
-    double fTimeElapsed = (tsCurrent.tv_sec - _tsLastUpdate.tv_sec) + (tsCurrent.tv_nsec - _tsLastUpdate.tv_nsec) * 1e-9;
-    if (fTimeElapsed >= _fUpdateInterval)
-    {     
-      _tsLastUpdate     = tsCurrent;
-      _u64MaskEventNode = ( ((uint64_t)1) << _iNumEventNode) - 1;    
-    }
-    
     if ( _u64MaskEventNode == 0 )
-    {
-      _bWriteEvent = false;
       return false;
-    }
 
     uint64_t uEventBit = (uint64_t)1 << ( uVectorCur % _iNumEventNode );
     
     if ( _u64MaskEventNode & uEventBit )
     {
       _u64MaskEventNode ^= uEventBit;
-      _bWriteEvent      =  true;
       return true;
     }
         
-    _bWriteEvent = false;
     return false;
   }
   
+  void EpicsMonitorPv::publishTimeXtc()
+  {
+    if (!_pcTimeXtc[0] || _lDbfType < 0 || _lDbfType >= _iSizeBasicDbrTypes)
+      return;
+
+    unsigned uNext = _uTimeXtcIndex ^ 1;
+    __sync_add_and_fetch(&_uTimeXtcSeq, 1);
+
+    Xtc*  pXtc    = new (_pcTimeXtc[uNext]) Xtc(_xtcTimeHeader);
+    char* pcValue = (char *) pXtc->next();
+    int   iSize   = 0;
+    (this->*lfuncWriteXtcTimeValueFunctionTable[_lDbfType]) (pcValue, iSize);
+    pXtc->alloc((iSize + 3) & ~3);  // Align to 4-bytes boundary
+
+    __sync_synchronize();
+    _uTimeXtcIndex = uNext;
+    __sync_add_and_fetch(&_uTimeXtcSeq, 1);
+  }
+
+  /*
+   * Copies the Xtc of the latest time value (the header included).  Another
+   * update may be published while copying, into the other buffer; the copy
+   * is retried only if a second one may have reused this buffer.
+   */
+  int EpicsMonitorPv::writeTimeXtc(char *pcXtcMem, int &iSizeXtc)
+  {
+    if (pcXtcMem == NULL)
+      return 1;
+
+    if (!_bConnected || _lDbrLastUpdateType == -1)
+    {
+      if (_iNumReportForNoConnection < _iMaxNumReportForNoConnection)
+      {
+        printf("EpicsMonitorPv::writeTimeXtc(): Pv %s not Connected\n", _sPvName.c_str());
+        _iNumReportForNoConnection++;
+      }
+      return 2;     // This error code (2) is a special case, and will be checked by the caller function.
+    }
+
+    if (_lDbfType < 0 || _lDbfType >= _iSizeBasicDbrTypes)
+    {
+      if (_iNumReportForNoConnection < _iMaxNumReportForNoConnection)
+      {
+        printf("EpicsMonitorPv::writeTimeXtc(): Unknown data type %ld\n", _lDbfType);
+        _iNumReportForNoConnection++;
+      }
+      return 3;
+    }
+
+    if (!_bTimeValueUpdated || _uTimeXtcSeq < 2)
+    {
+      printf("EpicsMonitorPv::writeTimeXtc(): Pv %s Time Value has not been updated\n",
+        _sPvName.c_str());
+      return 5;
+    }
+
+    while (true)
+    {
+      unsigned uSeq = _uTimeXtcSeq;
+      __sync_synchronize();
+
+      const Xtc* pXtc = (const Xtc *) _pcTimeXtc[_uTimeXtcIndex];
+      iSizeXtc = pXtc->extent;
+      if (iSizeXtc > _iSizeTimeXtcBuffer)
+        iSizeXtc = _iSizeTimeXtcBuffer;   // torn: retried below
+      memcpy(pcXtcMem, pXtc, iSizeXtc);
+
+      __sync_synchronize();
+      if (_uTimeXtcSeq - (uSeq & ~1u) <= 2)
+        return 0;
+    }
+  }
+
   int EpicsMonitorPv::writeXtc(char *pcXtcMem, bool bCtrlValue, int &iSizeXtc)
   {
     if (pcXtcMem == NULL)
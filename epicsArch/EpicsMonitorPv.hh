@@ -3,6 +3,7 @@
 
 #include "pds/epicsArch/EpicsDbrTools.hh"
 #include "pdsdata/psddl/epics.ddl.h"
+#include "pdsdata/xtc/Xtc.hh"
 
 #include <vector>
 #include <string>
@@ -15,6 +16,8 @@
 namespace Pds
 {
 
+  class EpicsArchSchedule;
+
   class EpicsMonitorPv
   {
   public:
@@ -23,18 +26,23 @@ namespace Pds
       _evidTime(NULL), _pTimeValue(NULL), _pCtrlValue(NULL),
       _bTimeValueUpdated(false), _bCtrlValueUpdated(false),
       _bCtrlValueWritten(false), _lDbrLastUpdateType(-1),
-      _iNumReportForNoConnection(0)
+      _iNumReportForNoConnection(0), _pSchedule(NULL), _iScheduleId(-1),
+      _iSizeTimeXtcBuffer(0), _uTimeXtcSeq(0), _uTimeXtcIndex(0)
     {
+      _pcTimeXtc[0] = _pcTimeXtc[1] = NULL;
     }
 
     int init(int iPvId, const std::string & sPvName,
-             const std::string & sPvDescription, float fUpdateInterval, int iNumEventNode);
+             const std::string & sPvDescription, float fUpdateInterval, int iNumEventNode,
+             const Src & src, EpicsArchSchedule * pSchedule = NULL);
     int reconnect();
     void resetUpdates(int iNumEventNode);
-    bool checkWriteEvent(const struct timespec& tsCurrent, unsigned int uVectorCur);
+    void armWriteEvent();
+    bool checkWriteEvent(unsigned int uVectorCur);
     int release();
     int printPv() const;
     int writeXtc(char *pcXtcMem, bool bCtrlValue, int &iSizeXtc);
+    int writeTimeXtc(char *pcXtcMem, int &iSizeXtc);
 
     /* Get & Set functions */
     const std::string & getPvName()         const {return _sPvName;}
@@ -43,7 +51,7 @@ namespace Pds
     float               getUpdateInterval() const {return _fUpdateInterval;}
     int                 getPvTypeId()       const {return _lDbfType;}
     bool                isConnected()       const {return _bConnected;}
-    bool                isWriteEvent()      const {return _bWriteEvent;}        
+    bool                isWritePending()    const {return _u64MaskEventNode != 0;}
 
      ~EpicsMonitorPv();   // non-virtual destructor: this class is not for inheritance
       
@@ -77,6 +85,7 @@ namespace Pds
     int onCaChannelConnected();
     int onCaChannelDisconnected();
     void onSubscriptionUpdate(const evargs & args);
+    void publishTimeXtc();
 
     template < int iDbrType > int printPvByDbrId() const;
 
@@ -89,6 +98,7 @@ namespace Pds
       int writeXtcTimeValueByDbrId(char *&pcXtcMem, int &iSizeXtc) const;
 
     static const int _iCaChannelPriority = 50;  // 0-100    
+    static const int _iSizeTimeXtcSlack  = 64;  // PV header and alignment beyond the DBR
 
     bool            _bConnected;
     int             _iPvId;
@@ -97,9 +107,7 @@ namespace Pds
     std::string     _sPvDescription;
     float           _fUpdateInterval;
     int             _iNumEventNode;    
-    struct timespec _tsLastUpdate;
-    uint64_t        _u64MaskEventNode;
-    bool            _bWriteEvent; // set by function checkWriteEvent()
+    uint64_t        _u64MaskEventNode; // event nodes still to be written
     unsigned long   _ulNumElems;
     int             _iCaStatus;
 
@@ -117,6 +125,20 @@ namespace Pds
 
     int _iNumReportForNoConnection;
 
+    EpicsArchSchedule * _pSchedule;   // woken on a disconnect or reconnect
+    int                 _iScheduleId;
+
+    /*
+     * The latest time value, laid out as its Xtc, in two buffers.  The CA
+     * handler fills the one not published and then publishes it; the
+     * sequence is odd while it does.
+     */
+    Xtc               _xtcTimeHeader;
+    char*             _pcTimeXtc[2];
+    int               _iSizeTimeXtcBuffer;
+    volatile unsigned _uTimeXtcSeq;
+    volatile unsigned _uTimeXtcIndex;
+
     static const int _iSizeBasicDbrTypes = EpicsDbrTools::iSizeBasicDbrTypes;
     typedef int (EpicsMonitorPv::*TPrintPvFuncPointer) () const;
     static const TPrintPvFuncPointer
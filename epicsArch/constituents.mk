@@ -1,6 +1,10 @@
 libnames := epicsArch
 
-libsrcs_epicsArch := $(wildcard *.cc)
+libsrcs_epicsArch := $(filter-out epicsschedbench.cc,$(wildcard *.cc))
 #libsinc_epicsArch := 
 libincs_epicsArch := epics/include epics/include/os/Linux
-libincs_epicsArch += pdsdata/include ndarray/include boost/include 
\ No newline at end of file
+libincs_epicsArch += pdsdata/include ndarray/include boost/include
+
+tgtnames := epicsschedbench
+tgtsrcs_epicsschedbench := epicsschedbench.cc EpicsArchSchedule.cc
+tgtslib_epicsschedbench := $(USRLIBDIR)/rt
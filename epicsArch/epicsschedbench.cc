@@ -0,0 +1,160 @@
+//
+//  Time per trigger to decide which PVs to archive, by scanning every PV
+//  for an elapsed update interval (as EpicsArchMonitor::writeToXtc did)
+//  and with EpicsArchSchedule, for simulated PVs each archived once per
+//  interval, of which a fraction are woken early (disconnected) each
+//  second.  Both should write the same number of PVs when none is woken.
+//
+#include "pds/epicsArch/EpicsArchSchedule.hh"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <vector>
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+static void usage(const char* p)
+{
+  printf("Usage: %s [-n <PVs>] [-i <update interval s>] [-w <fraction woken per s>] [-e <event nodes>] [-r <trigger rate Hz>] [-t <seconds>]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  int      iNumPv        = 10000;
+  float    fInterval     = 1.;
+  double   fWoken        = 0.;
+  int      iNumEventNode = 4;
+  double   fRate         = 120.;
+  double   fSeconds      = 60.;
+
+  int c;
+  while ((c = getopt(argc, argv, "n:i:w:e:r:t:h")) != -1) {
+    switch(c) {
+    case 'n': iNumPv        = strtol(optarg,NULL,0); break;
+    case 'i': fInterval     = strtod(optarg,NULL); break;
+    case 'w': fWoken        = strtod(optarg,NULL); break;
+    case 'e': iNumEventNode = strtol(optarg,NULL,0); break;
+    case 'r': fRate         = strtod(optarg,NULL); break;
+    case 't': fSeconds      = strtod(optarg,NULL); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  unsigned uTriggers = unsigned(fRate*fSeconds);
+  uint64_t u64All    = (uint64_t(1) << iNumEventNode) - 1;
+  double   fWakes    = fWoken*iNumPv/fRate;  // per trigger
+
+  //  The PVs woken before each trigger, the same for both
+  std::vector<unsigned> vuFirst(uTriggers+1);
+  std::vector<int>      viWake;
+  srandom(1);
+  double fAccum = 0;
+  for(unsigned t=0; t<uTriggers; t++) {
+    vuFirst[t] = viWake.size();
+    for(fAccum += fWakes; fAccum >= 1; fAccum -= 1)
+      viWake.push_back(random()%iNumPv);
+  }
+  vuFirst[uTriggers] = viWake.size();
+
+  double   fBase = 1.5e9;
+  unsigned long long ullScan=0, ullSched=0;
+  double   fScan, fSched, fNotify=0;
+
+  //  Every PV, every trigger
+  {
+    std::vector<double>   vfLast(iNumPv, 0);
+    std::vector<uint64_t> vuMask(iNumPv, u64All);
+    double t0 = now();
+    for(unsigned t=0; t<uTriggers; t++) {
+      double fNow = fBase + t/fRate;
+      for(unsigned k=vuFirst[t]; k<vuFirst[t+1]; k++)
+        vfLast[viWake[k]] = 0;
+      uint64_t uEventBit = uint64_t(1) << (t % iNumEventNode);
+      for(int i=0; i<iNumPv; i++) {
+        if (fNow - vfLast[i] >= fInterval) {
+          vfLast[i] = fNow;
+          vuMask[i] = u64All;
+        }
+        if (vuMask[i] & uEventBit) {
+          vuMask[i] ^= uEventBit;
+          ullScan++;
+        }
+      }
+    }
+    fScan = now()-t0;
+  }
+
+  //  Only the PVs due
+  {
+    EpicsArchSchedule schedule(iNumPv);
+    for(int i=0; i<iNumPv; i++)
+      schedule.setInterval(i, fInterval);
+
+    std::vector<uint64_t> vuMask   (iNumPv, u64All);
+    std::vector<char>     vbPending(iNumPv, 1);
+    std::vector<int>      viPending, viDue, viWrite;
+    for(int i=0; i<iNumPv; i++)
+      viPending.push_back(i);
+
+    double t0 = now();
+    for(unsigned t=0; t<uTriggers; t++) {
+      double t1 = now();
+      for(unsigned k=vuFirst[t]; k<vuFirst[t+1]; k++)
+        schedule.wake(viWake[k]);
+      fNotify += now()-t1;
+
+      double fNow = fBase + t/fRate;
+      timespec ts;
+      ts.tv_sec  = time_t(fNow);
+      ts.tv_nsec = long((fNow - ts.tv_sec)*1.e9);
+
+      viDue.clear();
+      schedule.collect(ts, viDue);
+      for(unsigned u=0; u<viDue.size(); u++) {
+        int i = viDue[u];
+        vuMask[i] = u64All;
+        if (!vbPending[i]) {
+          vbPending[i] = 1;
+          viPending.push_back(i);
+        }
+      }
+
+      uint64_t uEventBit = uint64_t(1) << (t % iNumEventNode);
+      unsigned uKeep = 0;
+      viWrite.clear();
+      for(unsigned u=0; u<viPending.size(); u++) {
+        int i = viPending[u];
+        if (vuMask[i] & uEventBit) {
+          vuMask[i] ^= uEventBit;
+          viWrite.push_back(i);
+        }
+        if (vuMask[i])
+          viPending[uKeep++] = i;
+        else
+          vbPending[i] = 0;
+      }
+      viPending.resize(uKeep);
+      ullSched += viWrite.size();
+    }
+    fSched = now()-t0-fNotify;
+  }
+
+  printf("%d PVs, %g s interval, %g%% woken per s, %d event nodes, %u triggers\n",
+         iNumPv, fInterval, 100*fWoken, iNumEventNode, uTriggers);
+  printf("scan     %8.2f us/trigger  %8.1f PVs written/trigger\n",
+         1.e6*fScan/uTriggers, double(ullScan)/uTriggers);
+  printf("schedule %8.2f us/trigger  %8.1f PVs written/trigger  (%.0f ns per wake)\n",
+         1.e6*fSched/uTriggers, double(ullSched)/uTriggers,
+         viWake.empty() ? 0. : 1.e9*fNotify/viWake.size());
+  return 0;
+}
@@ -29,6 +29,7 @@
 #include <mqueue.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <vector>
 #include "pds/config/EventcodeTiming.hh"
 #include "pds/config/EpixConfigType.hh"
 #include "pds/pgp/Configurator.hh"
@@ -37,6 +38,7 @@
 #include "pds/pgp/Reg.hh"
 #include "pds/pgp/SrpV3.hh"
 #include "pds/pgp/AxiVersion.hh"
+#include "pds/pgp/VmonConfigure.hh"
 #include <PgpDriver.h>
 #include "ndarray/ndarray.h"
 
@@ -405,6 +407,9 @@ static AsicRegMode_s AconfigAddrs[Epix10kaASIC_ConfigShadow::NumberOfValues] = {
   {0x101A,  0}   //  25
 };
 
+static const char* PhaseNames[] = { "Version", "Evr", "Adc", "Config",
+                                    "Asic", "Pixel", "Check" };
+
 #define PRINT_STR(str) { printf("Configurator[%u]: %s\n", _quad, str); }
 #define PRINT_LINE(fmt, ...) { printf("Configurator[%u]: " fmt "\n", _quad, __VA_ARGS__); }
 
@@ -419,6 +424,10 @@ Configurator::Configurator(int f, unsigned lane, unsigned quad, unsigned d) :
   _rhisto(0),
   _first (false)
 {
+  { char buff[32];
+    sprintf(buff,"Epix10ka2m Q%u Configure",quad);
+    _vmon = new Pds::Pgp::VmonConfigure(buff, NumberOfPhases, PhaseNames); }
+
   //  Initialize cache to impossible values
   memset(_ewrote,1,4*sizeof(Epix10kaElemConfig));
   memset(_eread ,1,4*sizeof(Epix10kaElemConfig));
@@ -621,6 +630,7 @@ unsigned Configurator::configure( const Epix::PgpEvrConfig&   p,
   timespec      start, end;
   bool printFlag = true;
   clock_gettime(CLOCK_REALTIME, &start);
+  _vmon->start();
   //  _pgp->maskHWerror(true);
   PRINT_LINE("Configurator::configure %s reseting front end", first ? "" : "not ");
   if (first) {
@@ -658,12 +668,15 @@ unsigned Configurator::configure( const Epix::PgpEvrConfig&   p,
     PRINT_LINE("AcqR0Wid: %x", unsigned(pq->_acqCore.asicR0Width));
     PRINT_LINE("AcqRoClk: %x", unsigned(pq->_acqCore.asicRoClkCount));
   }
+  _vmon->phase(VersionPhase);
 
   ret |= this->_G3config(p);
+  _vmon->phase(EvrPhase);
 
   //ret |= _writeADCs();
 
   ret |= _checkADCs();
+  _vmon->phase(AdcPhase);
 
   if (ret == 0) {
     _resetSequenceCount();
@@ -676,6 +689,7 @@ unsigned Configurator::configure( const Epix::PgpEvrConfig&   p,
     _enableRunTrigger(false);
     if (printFlag) PRINT_STR("writing top level config");
     ret |= _writeConfig();
+    _vmon->phase(ConfigPhase);
     if (printFlag) {
       clock_gettime(CLOCK_REALTIME, &end);
       uint64_t diff = timeDiff(&end, &start) + 50000LL;
@@ -693,6 +707,7 @@ unsigned Configurator::configure( const Epix::PgpEvrConfig&   p,
     _enableRunTrigger(true);
     if (usleep(10000)<0) perror("configure second usleep failed");
   }
+  _vmon->end();
   if (printFlag) {
     clock_gettime(CLOCK_REALTIME, &end);
     uint64_t diff = timeDiff(&end, &start) + 50000LL;
@@ -942,6 +957,15 @@ unsigned Configurator::_writeASIC()
 {
   unsigned ret = Success;
   Quad* q = 0;
+
+  //
+  //  The registers of all the ASICs are written, and then read, as batches
+  //  of transactions in flight together, rather than one round trip each.
+  //
+  std::vector<Reg*>       wregs;
+  std::vector<uint32_t>   wvals;
+  std::vector<const Reg*> rregs;
+  std::vector<uint32_t*>  rdsts;  // 0 for a readback which is discarded
   for(unsigned ie=0; ie<4; ie++) {
     const Epix10kaElemConfig& e = _e[ie];
     unsigned m = e.asicMask();
@@ -949,47 +973,51 @@ unsigned Configurator::_writeASIC()
       if (m&(1<<index)) {
         uint32_t* u = (uint32_t*) &e.asics(index);
         unsigned ia = ie*4+index;
-        try {
-          for (unsigned i=0; i<Epix10kaASIC_ConfigShadow::NumberOfValues; i++) {
-            unsigned addr = AconfigAddrs[i].addr;
-            unsigned mode = AconfigAddrs[i].mode;
-            Reg&     reg  = q->_asicSaci[ia].reg[addr];
-
-            if (addr==0x1015) continue;  // skip chip ID
-
-            if (mode == ReadOnly) {
-              if (_debug & 1) PRINT_LINE("%s reading addr(%p)", __PRETTY_FUNCTION__, &reg);
-              u[i] = reg;
-              if (_debug & 1) PRINT_LINE(" data(0x%x) Asic(%u)", u[i], ia);
-            }
+        for (unsigned i=0; i<Epix10kaASIC_ConfigShadow::NumberOfValues; i++) {
+          unsigned addr = AconfigAddrs[i].addr;
+          unsigned mode = AconfigAddrs[i].mode;
+          Reg&     reg  = q->_asicSaci[ia].reg[addr];
 
-            else if (mode==WriteOnly) {
-              if (_debug & 1) PRINT_LINE("%s writing addr(%p) data(0x%x)", __PRETTY_FUNCTION__, &reg, u[i]);
-              reg = u[i];
-            }
+          if (addr==0x1015) continue;  // skip chip ID
 
-            else {
-              if (_debug & 1) PRINT_LINE("%s writing addr(%p) data(0x%x)", __PRETTY_FUNCTION__, &reg, u[i]);
-              reg = u[i];
-              unsigned v = reg;
-              if (_debug & 1) PRINT_LINE("%s read addr(%p) data(0x%x)", __PRETTY_FUNCTION__, &reg, v);
-            }
+          if (mode != ReadOnly) {
+            if (_debug & 1) PRINT_LINE("%s writing addr(%p) data(0x%x)", __PRETTY_FUNCTION__, &reg, u[i]);
+            wregs.push_back(&reg);
+            wvals.push_back(u[i]);
+          }
+          if (mode != WriteOnly) {
+            rregs.push_back(&reg);
+            rdsts.push_back(mode == ReadOnly ? &u[i] : 0);
           }
-        }
-        catch(std::string& e) {
-          PRINT_LINE("Caught exception: %s",e.c_str());
-          ret |= Failure;
         }
       }
     }
   }
 
+  try {
+    Reg::write(wregs, wvals);
+    std::vector<uint32_t> v;
+    Reg::read(rregs, v);
+    for(unsigned i=0; i<v.size(); i++) {
+      if (_debug & 1) PRINT_LINE("%s read addr(%p) data(0x%x)", __PRETTY_FUNCTION__, rregs[i], v[i]);
+      if (rdsts[i])
+        *rdsts[i] = v[i];
+    }
+  }
+  catch(std::string& e) {
+    PRINT_LINE("Caught exception: %s",e.c_str());
+    ret |= Failure;
+  }
+  _vmon->phase(AsicPhase);
+
   ret |= _writePixelBits();
+  _vmon->phase(PixelPhase);
 
   if (ret==Success) {
     ret |= _checkWrittenASIC(true);
     ret |= _checkIsEnASIC();
   }
+  _vmon->phase(CheckPhase);
 
   return ret;
 }
@@ -1068,29 +1096,49 @@ unsigned Configurator::_writePixelBits()
 unsigned Configurator::_checkWrittenASIC(bool writeBack) {
   unsigned ret = Success;
   Quad* q = 0;
+
+  //  Read back all the ASICs at once
+  std::vector<const Reg*> regs;
+  std::vector<uint32_t>   v;
   for(unsigned ie=0; ie<4; ie++) {
     const Epix10kaElemConfig& e = _e[ie];
-    bool done = false;
-    while (!done && _e) {
-      //      PRINT_STR("_checkWrittenASIC");
-      unsigned m = e.asicMask();
-      uint32_t myBuffer[sizeof(Epix10kaASIC_ConfigShadow)/sizeof(uint32_t)];
-      Epix10kaASIC_ConfigShadow* readAsic = (Epix10kaASIC_ConfigShadow*) myBuffer;
-      for (unsigned index=0; index<e.numberOfAsics(); index++) {
-        if (m&(1<<index)) {
-          Epix10kaAsic& asic = q->_asicSaci[4*ie+index];
-          for (int i = 0; (i<Epix10kaASIC_ConfigShadow::NumberOfValues) && (ret==Success); i++)
-            if ((AconfigAddrs[i].mode != WriteOnly))
-              myBuffer[i] = unsigned(asic.reg[AconfigAddrs[i].addr])&0xffff;
-          //          PRINT_LINE("checking elem(%u) asic(%u)",ie,index);
-          Epix10kaASIC_ConfigShadow* confAsic = (Epix10kaASIC_ConfigShadow*) &(e.asics(index));
-          if ((*confAsic != *readAsic)) {
-            PRINT_LINE("_checkWrittenASIC failed on ASIC %u Elem %u", index, ie);
-            if (writeBack) *confAsic = *readAsic;
-          }
+    unsigned m = e.asicMask();
+    for (unsigned index=0; index<e.numberOfAsics(); index++) {
+      if (m&(1<<index)) {
+        Epix10kaAsic& asic = q->_asicSaci[4*ie+index];
+        for (int i = 0; i<Epix10kaASIC_ConfigShadow::NumberOfValues; i++)
+          if ((AconfigAddrs[i].mode != WriteOnly))
+            regs.push_back(&asic.reg[AconfigAddrs[i].addr]);
+      }
+    }
+  }
+
+  try {
+    Reg::read(regs, v);
+  }
+  catch(std::string& e) {
+    PRINT_LINE("Caught exception: %s",e.c_str());
+    return Failure;
+  }
+
+  unsigned k = 0;
+  for(unsigned ie=0; ie<4; ie++) {
+    const Epix10kaElemConfig& e = _e[ie];
+    unsigned m = e.asicMask();
+    uint32_t myBuffer[sizeof(Epix10kaASIC_ConfigShadow)/sizeof(uint32_t)];
+    Epix10kaASIC_ConfigShadow* readAsic = (Epix10kaASIC_ConfigShadow*) myBuffer;
+    for (unsigned index=0; index<e.numberOfAsics(); index++) {
+      if (m&(1<<index)) {
+        for (int i = 0; i<Epix10kaASIC_ConfigShadow::NumberOfValues; i++)
+          if ((AconfigAddrs[i].mode != WriteOnly))
+            myBuffer[i] = v[k++]&0xffff;
+        //          PRINT_LINE("checking elem(%u) asic(%u)",ie,index);
+        Epix10kaASIC_ConfigShadow* confAsic = (Epix10kaASIC_ConfigShadow*) &(e.asics(index));
+        if ((*confAsic != *readAsic)) {
+          PRINT_LINE("_checkWrittenASIC failed on ASIC %u Elem %u", index, ie);
+          if (writeBack) *confAsic = *readAsic;
         }
       }
-      done = true;
     }
   }
   return ret;
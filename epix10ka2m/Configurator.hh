@@ -35,6 +35,7 @@
 #include <new>
 
 namespace Pds {
+  namespace Pgp { class VmonConfigure; }
   namespace Epix10ka2m {
     class Epix10kaAsic;
     //    AcqCount : 0x000005
@@ -237,6 +238,8 @@ namespace Pds {
 
     private:
       enum {MicroSecondsSleepTime=50};
+      enum Phase {VersionPhase, EvrPhase, AdcPhase, ConfigPhase,
+                  AsicPhase, PixelPhase, CheckPhase, NumberOfPhases};
       Pds::Pgp::SrpV3::Protocol*    _protocol;
       const Epix10kaQuadConfig*     _q;
       Epix10kaElemConfig*           _e;
@@ -246,6 +249,7 @@ namespace Pds {
       unsigned                      _quad;
       unsigned*                     _rhisto;
       bool                          _first;
+      Pds::Pgp::VmonConfigure*      _vmon;
     };
   }
 }
@@ -1,4 +1,5 @@
 #include "pds/epix10ka2m/FrameBuilder.hh"
+#include "pds/epix10ka2m/QuadReorder.hh"
 #include "pds/pgp/DataImportFrame.hh"
 #include "pds/pgp/Pgp.hh"
 #include "pds/xtc/Datagram.hh"
@@ -10,6 +11,10 @@
 
 using namespace Pds::Epix10ka2m;
 
+static unsigned _nthreads = 1;
+
+void FrameBuilder::setThreads(unsigned n) { _nthreads = n ? n : 1; }
+
 FrameBuilder::FrameBuilder(const Datagram&             in, 
                            Datagram&                   out, 
                            const Epix10ka2MConfigType& cfg) :
@@ -34,7 +39,11 @@ FrameBuilder::FrameBuilder(const Datagram&             in,
     //  _temp   = _payload->temperatures     (cfg);
 
 #if 1
-    for(unsigned i=0; i<4; i++)
+    //  The quads fill separate elements, so they may be reordered concurrently
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(_nthreads) if(_nthreads>1)
+#endif
+    for(int i=0; i<4; i++)
       _add_quad(i);
 #endif
 
@@ -115,11 +124,15 @@ void FrameBuilder::_add_quad(unsigned quad)
 
   //  Each quad arrives on a separate lane
   //  A super row crosses 2 elements; each element contains 2x2 ASICs
-  const unsigned asicRows     = Epix10kaElemConfig::_numberOfRowsPerAsic;
-  const unsigned elemRowSize  = Epix10kaElemConfig::_numberOfAsicsPerRow*Epix10kaElemConfig::_numberOfPixelsPerAsicRow;
-
   const uint16_t* u = reinterpret_cast<const uint16_t*>(e+1);
-  
+
+  u = QuadReorder::copy(u,
+                        const_cast<uint16_t*>(_array.data() + 4*quad*_array.strides()[0]),
+                        const_cast<uint16_t*>(_calib.data() + 4*quad*_calib.strides()[0]), _calib.shape()[1],
+                        const_cast<uint32_t*>(_env  .data() + 4*quad*_env  .strides()[0]), _env  .shape()[1]);
+
+  // Temperatures
+#if 0
 #define MMCPY(dst,src,sz) {                                       \
     for(unsigned k=0; k<sz; k++) {                                \
       dst[sz-1-k] = src[k];                                       \
@@ -127,66 +140,8 @@ void FrameBuilder::_add_quad(unsigned quad)
     src += sz;                                                    \
   }
 
-#define QCPY(d1,d2,d3,d4,src,sz) {                                \
-    for(unsigned k=0; k<sz; k++) {                                \
-      d1[sz-1-k] = src[k];                                        \
-      d2[sz-1-k] = src[k+sz];                                     \
-      d3[sz-1-k] = src[k+sz*2];                                   \
-      d4[sz-1-k] = src[k+sz*3];                                   \
-    }                                                             \
-    src += sz*4;                                                  \
-  }
-
-  // Frame data
-  for(unsigned i=0; i<asicRows; i++) { // 4 super rows at a time
-    unsigned dnRow = asicRows+i;
-    unsigned upRow = asicRows-i-1;
-    // QCPY(const_cast<uint16_t*>(&_array(4*quad+2,upRow,0)), 
-    //      const_cast<uint16_t*>(&_array(4*quad+3,upRow,0)),
-    //      const_cast<uint16_t*>(&_array(4*quad+2,dnRow,0)),
-    //      const_cast<uint16_t*>(&_array(4*quad+3,dnRow,0)),
-    //      u, elemRowSize);
-    // QCPY(const_cast<uint16_t*>(&_array(4*quad+0,upRow,0)),
-    //      const_cast<uint16_t*>(&_array(4*quad+1,upRow,0)),
-    //      const_cast<uint16_t*>(&_array(4*quad+0,dnRow,0)),
-    //      const_cast<uint16_t*>(&_array(4*quad+1,dnRow,0)),
-    //      u, elemRowSize);
-
-    MMCPY(const_cast<uint16_t*>(&_array(4*quad+2,upRow,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_array(4*quad+3,upRow,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_array(4*quad+2,dnRow,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_array(4*quad+3,dnRow,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_array(4*quad+0,upRow,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_array(4*quad+1,upRow,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_array(4*quad+0,dnRow,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_array(4*quad+1,dnRow,0)), u, elemRowSize);
-  }
-
-  // Calibration rows
-  const unsigned calibRows = _calib.shape()[1];
-  for(unsigned i=0; i<calibRows; i++) {
-    MMCPY(const_cast<uint16_t*>(&_calib(4*quad+2,i,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_calib(4*quad+3,i,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_calib(4*quad+0,i,0)), u, elemRowSize);
-    MMCPY(const_cast<uint16_t*>(&_calib(4*quad+1,i,0)), u, elemRowSize);
-  }
-
-  // Environmental rows
-  const unsigned envRows = _env.shape()[1];
-  const uint32_t* u32 = reinterpret_cast<const uint32_t*>(u);
-  for(unsigned i=0; i<envRows; i++) {
-    MMCPY(const_cast<uint32_t*>(&_env(4*quad+2,i,0)), u32, elemRowSize/2);
-    MMCPY(const_cast<uint32_t*>(&_env(4*quad+3,i,0)), u32, elemRowSize/2);
-    MMCPY(const_cast<uint32_t*>(&_env(4*quad+0,i,0)), u32, elemRowSize/2);
-    MMCPY(const_cast<uint32_t*>(&_env(4*quad+1,i,0)), u32, elemRowSize/2);
-  }
-
-  // Temperatures
-#if 0
   const unsigned tempSize = 4;
-  u = reinterpret_cast<const uint16_t*>(u32);
   MMCPY(const_cast<uint16_t*>(&_temp(4*quad+0)), u, tempSize);
   MMCPY(const_cast<uint16_t*>(&_temp(4*quad+2)), u, tempSize);
 #endif
 }
-
@@ -19,6 +19,8 @@ namespace Pds {
                    const Epix10ka2MConfigType&);
     public:
       int process(Xtc*);
+    public:
+      static void setThreads(unsigned);  // reorder the quads of a 2M concurrently (PDS_EPIX10KA2M_QUAD_THREADS)
     private:
       void _add_quad(unsigned quad);
     private:
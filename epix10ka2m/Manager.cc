@@ -40,6 +40,7 @@
 #include "pds/config/EpixConfigType.hh"
 #include "pds/epix10ka2m/ConfigCache.hh"
 #include "pds/epix10ka2m/Configurator.hh"
+#include "pds/epix10ka2m/FrameBuilder.hh"
 #include "pds/epix10ka2m/Server.hh"
 #include "pdsdata/xtc/DetInfo.hh"
 #include "pds/config/CfgClientNfs.hh"
@@ -348,6 +349,15 @@ Manager::Manager( const std::vector<Epix10ka2m::Server*>& server, unsigned nthre
 
    Fsm& fsm = *new Fsm;
 
+   //  The quads of each event may also be reordered concurrently; off unless
+   //  asked for, since it adds to the work threads above
+   const char* env = getenv("PDS_EPIX10KA2M_QUAD_THREADS");
+   if (env) {
+     unsigned n = strtoul(env,NULL,0);
+     FrameBuilder::setThreads(n);
+     printf("reordering quads in %u threads... ", n ? n : 1);
+   }
+
    if (nthreads) {
      std::vector<Appliance*> apps(4);
      apps[0] = &fsm;
@@ -0,0 +1,57 @@
+#include "pds/epix10ka2m/QuadReorder.hh"
+#include "pds/epix10ka2m/QuadReorderTemplate.hh"
+
+using namespace Pds::Epix10ka2m;
+
+namespace {
+  class ScalarRow {
+  public:
+    template <typename T, unsigned N>
+    static void reverse(T* dst, const T* src) {
+      for(unsigned k=0; k<N; k++)
+        dst[N-1-k] = src[k];
+    }
+    static void copy(uint16_t* dst, const uint16_t* src) { reverse<uint16_t,QuadReorder::RowSize  >(dst,src); }
+    static void copy(uint32_t* dst, const uint32_t* src) { reverse<uint32_t,QuadReorder::RowSize/2>(dst,src); }
+  };
+
+  QuadReorder::Isa cpu_isa()
+  {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))  return QuadReorder::Avx2;
+    if (__builtin_cpu_supports("ssse3")) return QuadReorder::Ssse3;
+#endif
+    return QuadReorder::Scalar;
+  }
+}
+
+static QuadReorder::Isa _cpu_isa = cpu_isa();
+//  The reorder is bound by memory, and the lane swap of the AVX2 copy made
+//  it slower than SSSE3 where measured; so AVX2 is used only on request.
+static QuadReorder::Isa _isa     = _cpu_isa < QuadReorder::Ssse3 ? _cpu_isa : QuadReorder::Ssse3;
+
+static const char* _isa_names[] = { "scalar", "ssse3", "avx2" };
+
+const uint16_t* QuadReorder::copy(const uint16_t* u,
+                                  uint16_t* array,
+                                  uint16_t* calib, unsigned calibRows,
+                                  uint32_t* env  , unsigned envRows)
+{
+  switch(_isa) {
+#if defined(__x86_64__)
+  case Avx2 : return reorder_avx2 (u, array, calib, calibRows, env, envRows);
+  case Ssse3: return reorder_ssse3(u, array, calib, calibRows, env, envRows);
+#endif
+  default   : break;
+  }
+  return reorder<ScalarRow>(u, array, calib, calibRows, env, envRows);
+}
+
+QuadReorder::Isa QuadReorder::isa() { return _isa; }
+
+QuadReorder::Isa QuadReorder::supported() { return _cpu_isa; }
+
+void QuadReorder::isa(Isa isa) { _isa = isa < _cpu_isa ? isa : _cpu_isa; }
+
+const char* QuadReorder::name(Isa isa) { return _isa_names[isa]; }
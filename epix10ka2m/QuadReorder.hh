@@ -0,0 +1,52 @@
+#ifndef Pds_Epix10ka2m_QuadReorder_hh
+#define Pds_Epix10ka2m_QuadReorder_hh
+
+#include "pds/config/EpixConfigType.hh"
+
+#include <stdint.h>
+
+namespace Pds {
+  namespace Epix10ka2m {
+    //
+    //  Reorders the payload of one quad into its four elements of an
+    //  Epix10kaDataArray.  Each row of the payload crosses two ASICs and
+    //  lands reversed in its element; the rows of an element are filled
+    //  outward from the middle.
+    //
+    //  The row copy is specialized at compile time for the row length of
+    //  the element layout, and for the instruction set (SSSE3 or AVX2),
+    //  which is chosen at run time among those the cpu supports.  All
+    //  produce the same output.
+    //
+    class QuadReorder {
+    public:
+      enum Isa { Scalar, Ssse3, Avx2 };
+      enum { AsicRows    = Epix10kaElemConfig::_numberOfRowsPerAsic,
+             RowSize     = Epix10kaElemConfig::_numberOfAsicsPerRow*Epix10kaElemConfig::_numberOfPixelsPerAsicRow,
+             ElemPixels  = 2*AsicRows*RowSize };
+    public:
+      //  "array", "calib" and "env" point to the first element of the quad.
+      //  Returns the payload following the environmental rows.
+      static const uint16_t* copy(const uint16_t* u,
+                                  uint16_t* array,
+                                  uint16_t* calib, unsigned calibRows,
+                                  uint32_t* env  , unsigned envRows);
+      static Isa         isa      ();
+      static void        isa      (Isa);  // limited to what the cpu supports
+      static Isa         supported();
+      static const char* name     (Isa);
+    public:
+      //  The reorder for a row copy policy "Row" (see QuadReorderTemplate.hh)
+      template <class Row>
+      static const uint16_t* reorder(const uint16_t* u,
+                                     uint16_t* array,
+                                     uint16_t* calib, unsigned calibRows,
+                                     uint32_t* env  , unsigned envRows);
+    };
+
+    const uint16_t* reorder_ssse3(const uint16_t*, uint16_t*, uint16_t*, unsigned, uint32_t*, unsigned);
+    const uint16_t* reorder_avx2 (const uint16_t*, uint16_t*, uint16_t*, unsigned, uint32_t*, unsigned);
+  }
+}
+
+#endif
@@ -0,0 +1,55 @@
+//
+//  The AVX2 row copy of QuadReorder.  It alone is built for AVX2, and
+//  QuadReorder only calls it when the cpu supports it.
+//
+#if defined(__x86_64__)
+#include "pds/epix10ka2m/QuadReorder.hh"
+
+#pragma GCC target("avx2")
+
+#include <immintrin.h>
+
+#include "pds/epix10ka2m/QuadReorderTemplate.hh"
+
+using namespace Pds::Epix10ka2m;
+
+namespace {
+  class Avx2Row {
+  public:
+    //  Reverse 8 words in each 128-bit lane, then swap the lanes
+    static void copy(uint16_t* dst, const uint16_t* src) {
+      const __m256i rev = _mm256_setr_epi8(14,15,12,13,10,11,8,9,6,7,4,5,2,3,0,1,
+                                           14,15,12,13,10,11,8,9,6,7,4,5,2,3,0,1);
+      const unsigned N = QuadReorder::RowSize;
+      unsigned k=0;
+      for(; k+16<=N; k+=16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src+k));
+        v = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, rev), 0x4e);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst+N-16-k), v);
+      }
+      for(; k<N; k++)
+        dst[N-1-k] = src[k];
+    }
+    static void copy(uint32_t* dst, const uint32_t* src) {
+      const __m256i rev = _mm256_setr_epi32(7,6,5,4,3,2,1,0);
+      const unsigned N = QuadReorder::RowSize/2;
+      unsigned k=0;
+      for(; k+8<=N; k+=8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src+k));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst+N-8-k), _mm256_permutevar8x32_epi32(v, rev));
+      }
+      for(; k<N; k++)
+        dst[N-1-k] = src[k];
+    }
+  };
+}
+
+const uint16_t* Pds::Epix10ka2m::reorder_avx2(const uint16_t* u,
+                                              uint16_t* array,
+                                              uint16_t* calib, unsigned calibRows,
+                                              uint32_t* env  , unsigned envRows)
+{
+  return QuadReorder::reorder<Avx2Row>(u, array, calib, calibRows, env, envRows);
+}
+
+#endif
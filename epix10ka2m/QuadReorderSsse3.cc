@@ -0,0 +1,52 @@
+//
+//  The SSSE3 row copy of QuadReorder.  It alone is built for SSSE3, and
+//  QuadReorder only calls it when the cpu supports it.
+//
+#if defined(__x86_64__)
+#include "pds/epix10ka2m/QuadReorder.hh"
+
+#pragma GCC target("ssse3")
+
+#include <tmmintrin.h>
+
+#include "pds/epix10ka2m/QuadReorderTemplate.hh"
+
+using namespace Pds::Epix10ka2m;
+
+namespace {
+  class Ssse3Row {
+  public:
+    //  Reverse 8 words in each 16 bytes
+    static void copy(uint16_t* dst, const uint16_t* src) {
+      const __m128i rev = _mm_setr_epi8(14,15,12,13,10,11,8,9,6,7,4,5,2,3,0,1);
+      const unsigned N = QuadReorder::RowSize;
+      unsigned k=0;
+      for(; k+8<=N; k+=8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src+k));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+N-8-k), _mm_shuffle_epi8(v, rev));
+      }
+      for(; k<N; k++)
+        dst[N-1-k] = src[k];
+    }
+    static void copy(uint32_t* dst, const uint32_t* src) {
+      const unsigned N = QuadReorder::RowSize/2;
+      unsigned k=0;
+      for(; k+4<=N; k+=4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src+k));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+N-4-k), _mm_shuffle_epi32(v, 0x1b));
+      }
+      for(; k<N; k++)
+        dst[N-1-k] = src[k];
+    }
+  };
+}
+
+const uint16_t* Pds::Epix10ka2m::reorder_ssse3(const uint16_t* u,
+                                               uint16_t* array,
+                                               uint16_t* calib, unsigned calibRows,
+                                               uint32_t* env  , unsigned envRows)
+{
+  return QuadReorder::reorder<Ssse3Row>(u, array, calib, calibRows, env, envRows);
+}
+
+#endif
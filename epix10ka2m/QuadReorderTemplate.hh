@@ -0,0 +1,57 @@
+#ifndef Pds_Epix10ka2m_QuadReorderTemplate_hh
+#define Pds_Epix10ka2m_QuadReorderTemplate_hh
+
+//
+//  The quad reorder for a row copy policy "Row", which provides
+//    static void copy(uint16_t* dst, const uint16_t* src);  // RowSize
+//    static void copy(uint32_t* dst, const uint32_t* src);  // RowSize/2
+//  Kept apart from QuadReorder.hh so that a file may build it and its
+//  row copy for another instruction set after including that header.
+//
+
+#include "pds/epix10ka2m/QuadReorder.hh"
+
+template <class Row>
+inline const uint16_t* Pds::Epix10ka2m::QuadReorder::reorder(const uint16_t* u,
+                                                            uint16_t* array,
+                                                            uint16_t* calib, unsigned calibRows,
+                                                            uint32_t* env  , unsigned envRows)
+{
+  // Frame data
+  for(unsigned i=0; i<AsicRows; i++) { // 4 super rows at a time
+    unsigned dnRow = (AsicRows+i)*RowSize;
+    unsigned upRow = (AsicRows-i-1)*RowSize;
+    Row::copy(&array[2*ElemPixels+upRow], u); u += RowSize;
+    Row::copy(&array[3*ElemPixels+upRow], u); u += RowSize;
+    Row::copy(&array[2*ElemPixels+dnRow], u); u += RowSize;
+    Row::copy(&array[3*ElemPixels+dnRow], u); u += RowSize;
+    Row::copy(&array[0*ElemPixels+upRow], u); u += RowSize;
+    Row::copy(&array[1*ElemPixels+upRow], u); u += RowSize;
+    Row::copy(&array[0*ElemPixels+dnRow], u); u += RowSize;
+    Row::copy(&array[1*ElemPixels+dnRow], u); u += RowSize;
+  }
+
+  // Calibration rows
+  const unsigned calibElem = calibRows*RowSize;
+  for(unsigned i=0; i<calibRows; i++) {
+    Row::copy(&calib[2*calibElem+i*RowSize], u); u += RowSize;
+    Row::copy(&calib[3*calibElem+i*RowSize], u); u += RowSize;
+    Row::copy(&calib[0*calibElem+i*RowSize], u); u += RowSize;
+    Row::copy(&calib[1*calibElem+i*RowSize], u); u += RowSize;
+  }
+
+  // Environmental rows
+  const unsigned envRow  = RowSize/2;
+  const unsigned envElem = envRows*envRow;
+  const uint32_t* u32 = reinterpret_cast<const uint32_t*>(u);
+  for(unsigned i=0; i<envRows; i++) {
+    Row::copy(&env[2*envElem+i*envRow], u32); u32 += envRow;
+    Row::copy(&env[3*envElem+i*envRow], u32); u32 += envRow;
+    Row::copy(&env[0*envElem+i*envRow], u32); u32 += envRow;
+    Row::copy(&env[1*envElem+i*envRow], u32); u32 += envRow;
+  }
+
+  return reinterpret_cast<const uint16_t*>(u32);
+}
+
+#endif
@@ -5,11 +5,19 @@ libsrcs_epix10ka2m := \
 		 ConfigCache.cc \
 		 Destination.cc \
 		 FrameBuilder.cc \
+		 QuadReorder.cc \
+		 QuadReorderSsse3.cc \
+		 QuadReorderAvx2.cc \
 		 Server.cc \
 		 ServerSim.cc \
 		 Manager.cc
 
 libincs_epix10ka2m := pgpcard aesdriver/include pgp pdsdata/include ndarray/include boost/include
+
+tgtnames := reorderbench
+tgtsrcs_reorderbench := reorderbench.cc QuadReorder.cc QuadReorderSsse3.cc QuadReorderAvx2.cc
+tgtincs_reorderbench := pdsdata/include ndarray/include boost/include
+
 CPPFLAGS += -fno-strict-aliasing
 CPPFLAGS += -fopenmp
 LXFlAGS += -fopenmp
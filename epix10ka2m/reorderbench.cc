@@ -0,0 +1,133 @@
+//
+//  Throughput of the epix10ka2m quad reorder of FrameBuilder on synthetic
+//  frames: each instruction set the cpu supports, with the quads of an
+//  event reordered serially or concurrently.  The output of each is
+//  compared with that of the scalar reorder.
+//
+#include "pds/epix10ka2m/QuadReorder.hh"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+using namespace Pds::Epix10ka2m;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+class Event {
+public:
+  Event(unsigned calibRows, unsigned envRows) :
+    _calibRows(calibRows), _envRows(envRows)
+  {
+    _arraySize = 16*QuadReorder::ElemPixels;
+    _calibSize = 16*calibRows*QuadReorder::RowSize;
+    _envSize   = 16*envRows*QuadReorder::RowSize/2;
+    _array = new uint16_t[_arraySize];
+    _calib = new uint16_t[_calibSize];
+    _env   = new uint32_t[_envSize];
+  }
+  ~Event() { delete[] _array; delete[] _calib; delete[] _env; }
+public:
+  void reorder(uint16_t* const* payload, unsigned nthreads) {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) if(nthreads>1)
+#endif
+    for(int q=0; q<4; q++)
+      QuadReorder::copy(payload[q],
+                        &_array[4*q*QuadReorder::ElemPixels],
+                        &_calib[4*q*_calibRows*QuadReorder::RowSize], _calibRows,
+                        &_env  [4*q*_envRows*QuadReorder::RowSize/2], _envRows);
+  }
+  bool operator==(const Event& o) const {
+    return memcmp(_array, o._array, _arraySize*sizeof(uint16_t))==0 &&
+      memcmp(_calib, o._calib, _calibSize*sizeof(uint16_t))==0 &&
+      memcmp(_env  , o._env  , _envSize  *sizeof(uint32_t))==0;
+  }
+  void clear() {
+    memset(_array, 0, _arraySize*sizeof(uint16_t));
+    memset(_calib, 0, _calibSize*sizeof(uint16_t));
+    memset(_env  , 0, _envSize  *sizeof(uint32_t));
+  }
+  unsigned bytes() const {
+    return _arraySize*sizeof(uint16_t) + _calibSize*sizeof(uint16_t) + _envSize*sizeof(uint32_t);
+  }
+private:
+  unsigned  _calibRows, _envRows;
+  unsigned  _arraySize, _calibSize, _envSize;
+  uint16_t* _array;
+  uint16_t* _calib;
+  uint32_t* _env;
+};
+
+static void usage(const char* p)
+{
+  printf("Usage: %s [-n <events>] [-t <threads>] [-c <calib rows>] [-e <env rows>]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned nevents   = 200;
+  unsigned nthreads  = 4;
+  unsigned calibRows = 2;
+  unsigned envRows   = 1;
+
+  int c;
+  while ((c = getopt(argc, argv, "n:t:c:e:h")) != -1) {
+    switch(c) {
+    case 'n': nevents   = strtoul(optarg,NULL,0); break;
+    case 't': nthreads  = strtoul(optarg,NULL,0); break;
+    case 'c': calibRows = strtoul(optarg,NULL,0); break;
+    case 'e': envRows   = strtoul(optarg,NULL,0); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  //  The payload of each quad, as it arrives from its lane
+  Event ref(calibRows, envRows), out(calibRows, envRows);
+  unsigned qwords = ref.bytes()/4/sizeof(uint16_t);
+  uint16_t* payload[4];
+  for(unsigned q=0; q<4; q++) {
+    payload[q] = new uint16_t[qwords];
+    for(unsigned i=0; i<qwords; i++)
+      payload[q][i] = random();
+  }
+
+  QuadReorder::Isa best = QuadReorder::supported();
+  printf("%u events of %u bytes, default instruction set %s\n",
+         nevents, ref.bytes(), QuadReorder::name(QuadReorder::isa()));
+
+  QuadReorder::isa(QuadReorder::Scalar);
+  ref.reorder(payload, 1);
+
+  bool lexact = true;
+  for(int isa=QuadReorder::Scalar; isa<=best; isa++) {
+    QuadReorder::isa(QuadReorder::Isa(isa));
+    unsigned threads[] = { 1, nthreads };
+    for(unsigned it=0; it<(nthreads>1 ? 2:1); it++) {
+      unsigned t = threads[it];
+      out.clear();
+      double t0 = now();
+      for(unsigned i=0; i<nevents; i++)
+        out.reorder(payload, t);
+      double dt = now()-t0;
+      bool lsame = (out == ref);
+      lexact &= lsame;
+      printf("%-6s %u thread%s: %8.1f events/s %6.2f GB/s  %s\n",
+             QuadReorder::name(QuadReorder::Isa(isa)), t, t>1 ? "s":" ",
+             double(nevents)/dt, 1.e-9*double(nevents)*double(ref.bytes())/dt,
+             lsame ? "identical" : "DIFFERS");
+    }
+  }
+
+  for(unsigned q=0; q<4; q++)
+    delete[] payload[q];
+
+  return lexact ? 0 : 1;
+}
@@ -1,6 +1,9 @@
 #include "Driver.hh"
 #include "DataFormat.hh"
 #include "DetectorId.hh"
+#include "PacketReceiver.hh"
+#include "pds/service/Task.hh"
+#include "pds/service/Semaphore.hh"
 #include "sls/Detector.h"
 
 #include <sys/socket.h>
@@ -25,20 +28,27 @@
 
 using namespace Pds::Jungfrau;
 
-struct frame_thread_args {
-  uint64_t* frame;
-  uint16_t* data;
-  JungfrauModInfoType* metadata; 
-  Module* module;
-  bool status;
-};
-
-static void* frame_thread(void* args_ptr)
-{
-  frame_thread_args* args = (frame_thread_args*) args_ptr;
-  args->status = args->module->get_frame(args->frame, args->metadata, args->data);
-
-  return NULL;
+namespace Pds {
+  namespace Jungfrau {
+    //
+    //  Reads one module's frame on that module's receiver task
+    //
+    class FrameJob : public Routine {
+      public:
+        FrameJob() : frame(0), data(0), metadata(0), module(0), sem(0), status(false) {}
+        void routine() {
+          status = module->get_frame(frame, metadata, data);
+          sem->give();
+        }
+      public:
+        uint64_t* frame;
+        uint16_t* data;
+        JungfrauModInfoType* metadata;
+        Module* module;
+        Semaphore* sem;
+        bool status;
+    };
+  }
 }
 
 static std::chrono::nanoseconds secs_to_ns(double secs)
@@ -125,7 +135,7 @@ Module::Module(const int id, const std::string& control, const std::string& host
   _socket(-1), _connected(false), _boot(true), _freerun(false), _poweron(false),
   _sockbuf_sz(sizeof(jungfrau_dgram)*JF_PACKET_NUM*JF_EVENTS_TO_BUFFER), _readbuf_sz(sizeof(jungfrau_header)),
   _frame_sz(JF_DATA_ELEM * sizeof(uint16_t)), _frame_elem(JF_DATA_ELEM),
-  _speed(JungfrauConfigType::Quarter)
+  _recv(0), _speed(JungfrauConfigType::Quarter)
 {
   _readbuf = new char[_readbuf_sz];
   _msgbuf  = new char[MSG_LEN];
@@ -169,6 +179,8 @@ Module::Module(const int id, const std::string& control, const std::string& host
       sa.sin_port        = htons(port);
 
       nb = ::bind(_socket, (sockaddr*)&sa, sizeof(sa));
+      if (nb >= 0)
+        _recv = new PacketReceiver(_socket);
     }
 
     if (nb<0) {
@@ -204,6 +216,10 @@ Module::~Module()
 
 void Module::shutdown()
 {
+  if (_recv) {
+    delete _recv;
+    _recv = 0;
+  }
   if (_socket >= 0) {
     ::close(_socket);
     _socket = -1;
@@ -947,6 +963,9 @@ void Module::reset()
 
 unsigned Module::flush()
 {
+  if (_recv)
+    return _recv->flush();
+
   ssize_t nb;
   struct sockaddr_in clientaddr;
   unsigned count = 0;
@@ -1013,22 +1032,32 @@ bool Module::get_packet(uint64_t* frame, JungfrauModInfoType* metadata, uint16_t
 
 bool Module::get_frame(uint64_t* frame, JungfrauModInfoType* metadata, uint16_t* data)
 {
-  unsigned npackets = 0;
   uint64_t cur_frame = 0;
-  bool first_packet = true;
-  bool last_packet = false;
 
-  while (!last_packet) {
-    get_packet(&cur_frame, metadata, data, &first_packet, &last_packet, &npackets);
+  if (!_recv) {
+    fprintf(stderr,"Error: no data receiver for Jungfrau at %s\n", _host.c_str());
+    return false;
   }
 
-  if (npackets == JF_PACKET_NUM) {
+  if (_recv->get_frame(&cur_frame, data)) {
     *frame = cur_frame;
-  } else {
-    fprintf(stderr,"Error: frame %lu from Jungfrau at %s is incomplete, received %u out of %d expected\n", cur_frame, _host.c_str(), npackets, JF_PACKET_NUM);
+    if (metadata) {
+      const jungfrau_header& header = _recv->header();
+      new(metadata) JungfrauModInfoType(header.timestamp, header.exptime, header.moduleID, header.xCoord, header.yCoord, header.zCoord);
+    }
+    return true;
   }
- 
-  return (npackets == JF_PACKET_NUM);
+
+  if (!_recv->aborted())
+    fprintf(stderr,"Error: frame %lu from Jungfrau at %s is incomplete, received %u out of %d expected\n", cur_frame, _host.c_str(), _recv->npackets(), JF_PACKET_NUM);
+
+  return false;
+}
+
+void Module::abort()
+{
+  if (_recv)
+    _recv->abort();
 }
 
 const char* Module::get_hostname() const
@@ -1083,8 +1112,9 @@ unsigned Module::get_frame_size() const
 Detector::Detector(std::vector<Module*>& modules, bool use_threads, int thread_rtprio) :
   _aborted(false),
   _use_threads(use_threads),
-  _threads(0),
-  _thread_attr(0),
+  _tasks(0),
+  _jobs(0),
+  _frame_sem(0),
   _pfds(0),
   _num_modules(modules.size()),
   _module_frames(new uint64_t[modules.size()]),
@@ -1102,20 +1132,20 @@ Detector::Detector(std::vector<Module*>& modules, bool use_threads, int thread_r
   // explicitly zero the _module_frames buffer
   memset(_module_frames, 0, modules.size() * sizeof(uint64_t));
   if (_use_threads) {
-    _threads = new pthread_t[_num_modules];
-    _thread_attr = new pthread_attr_t;
-    pthread_attr_init(_thread_attr);
-    if (thread_rtprio > 0) {
-      if (thread_rtprio > sched_get_priority_max(SCHED_FIFO)) {
-        thread_rtprio = sched_get_priority_max(SCHED_FIFO);
-      } else if (thread_rtprio < sched_get_priority_min(SCHED_FIFO)) {
-        thread_rtprio = sched_get_priority_min(SCHED_FIFO);
+    // a persistent receiver task per module; the cpus may be set by task policy
+    _tasks = new Task*[_num_modules];
+    _jobs = new FrameJob[_num_modules];
+    _frame_sem = new Semaphore(Semaphore::EMPTY);
+    for (unsigned i=0; i<_num_modules; i++) {
+      char name[32];
+      snprintf(name, sizeof(name), "JfRecv%u", i);
+      TaskObject tobj(name);
+      if (thread_rtprio > 0) {
+        tobj.policy(TaskPolicy(tobj.policy().cpus(), TaskPolicy::Fifo, thread_rtprio));
       }
-      struct sched_param params;
-      params.sched_priority = thread_rtprio;
-      pthread_attr_setschedpolicy(_thread_attr, SCHED_FIFO);
-      pthread_attr_setinheritsched(_thread_attr, PTHREAD_EXPLICIT_SCHED);
-      pthread_attr_setschedparam(_thread_attr, &params);
+      _tasks[i] = new Task(tobj);
+      _jobs[i].module = _modules[i];
+      _jobs[i].sem = _frame_sem;
     }
   } else {
     _pfds = new pollfd[_num_modules+1];
@@ -1132,15 +1162,18 @@ Detector::Detector(std::vector<Module*>& modules, bool use_threads, int thread_r
 
 Detector::~Detector()
 {
+  if (_tasks) {
+    for (unsigned i=0; i<_num_modules; i++) {
+      _tasks[i]->destroy();
+    }
+    delete[] _tasks;
+  }
+  if (_jobs) delete[] _jobs;
+  if (_frame_sem) delete _frame_sem;
   for (unsigned i=0; i<_num_modules; i++) {
     delete _modules[i];
   }
   _modules.clear();
-  if (_threads) delete[] _threads;
-  if (_thread_attr) {
-    pthread_attr_destroy(_thread_attr);
-    delete _thread_attr;
-  }
   if (_pfds) delete[] _pfds;
   if (_module_frames) delete[] _module_frames;
   if (_module_first_packet) delete[] _module_first_packet;
@@ -1178,6 +1211,10 @@ void Detector::signal(int sig)
 {
   if(!_use_threads) {
     ::write(_sigfd[1], &sig, sizeof(sig));
+  } else if (sig == JF_FRAME_WAIT_EXIT) {
+    for (unsigned i=0; i<_num_modules; i++) {
+      _modules[i]->abort();
+    }
   }
 }
 
@@ -1307,31 +1344,26 @@ bool Detector::get_frame(uint64_t* frame, JungfrauModInfoType* metadata, uint16_
 
 bool Detector::get_frame_thread(uint64_t* frame, JungfrauModInfoType* metadata, uint16_t* data)
 {
-  int thread_ret = 0;
   bool drop_frame = false;
   bool frame_unset = true;
-  frame_thread_args args[_num_modules];
 
-  // Start frame reading threads
+  // Hand each module's part of the frame to its receiver task
   for (unsigned i=0; i<_num_modules; i++) {
-    args[i].frame = &_module_frames[i];
-    args[i].data = data;
-    args[i].metadata = metadata;
-    args[i].module = _modules[i];
-    thread_ret = pthread_create(&_threads[i], _thread_attr, frame_thread, &args[i]);
-    if (thread_ret) {
-      fprintf(stderr, "Error: failed to launch frame fetching thread for module %u: %s\n", i, strerror(thread_ret));
-      return false;
-    }
+    _jobs[i].frame = &_module_frames[i];
+    _jobs[i].data = data;
+    _jobs[i].metadata = metadata;
+    _tasks[i]->call(&_jobs[i]);
 
     data += _modules[i]->get_num_pixels();
     if(metadata) metadata++;
   }
 
-  // Wait for the threads to finish
+  // Wait for the receivers to finish
+  for (unsigned i=0; i<_num_modules; i++) {
+    _frame_sem->take();
+  }
   for (unsigned i=0; i<_num_modules; i++) {
-    pthread_join(_threads[i], NULL);
-    if (!args[i].status) {
+    if (!_jobs[i].status) {
       fprintf(stderr,"Error: module %u failed to return a frame!\n", i);
       drop_frame = true;
     }
@@ -14,7 +14,13 @@ namespace sls {
 }
 
 namespace Pds {
+  class Task;
+  class Semaphore;
+
   namespace Jungfrau {
+    class PacketReceiver;
+    class FrameJob;
+
     class DacsConfig {
       public:
         DacsConfig();
@@ -78,6 +84,7 @@ namespace Pds {
         bool get_packet(uint64_t* frame, JungfrauModInfoType* metadata, uint16_t* data, bool* first_packet, bool* last_packet, unsigned* npackets);
         bool get_frame(uint64_t* framenum, uint16_t* data);
         bool get_frame(uint64_t* framenum, JungfrauModInfoType* metadata, uint16_t* data);
+        void abort();
         const char* get_hostname() const;
         const char* error();
         void set_error(const char* fmt, ...);
@@ -113,6 +120,7 @@ namespace Pds {
         unsigned          _frame_elem;
         char*             _readbuf;
         char*             _msgbuf;
+        PacketReceiver*   _recv;
         sls::Detector*    _det;
         DacsConfig        _dac_config;
         JungfrauConfigType::SpeedMode _speed;
@@ -151,8 +159,9 @@ namespace Pds {
       private:
         bool                  _aborted;
         bool                  _use_threads;
-        pthread_t*            _threads;
-        pthread_attr_t*       _thread_attr;
+        Task**                _tasks;
+        FrameJob*             _jobs;
+        Semaphore*            _frame_sem;
         pollfd*               _pfds;
         int                   _sigfd[2];
         unsigned              _num_modules;
@@ -0,0 +1,229 @@
+#include "PacketReceiver.hh"
+
+#include <poll.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#define JF_PAYLOAD_SIZE (JF_DATA_ELEM * sizeof(uint16_t))
+
+using namespace Pds::Jungfrau;
+
+static bool is_set(const uint64_t* mask, unsigned bit) { return mask[bit>>6] & (1ULL<<(bit&63)); }
+static void set   (uint64_t* mask, unsigned bit)       { mask[bit>>6] |= (1ULL<<(bit&63)); }
+
+PacketReceiver::PacketReceiver(int fd, unsigned batch) :
+  _fd(fd),
+  _batch(batch),
+  _msgs(new mmsghdr[batch]),
+  _iovs(new iovec[2*batch]),
+  _headers(new jungfrau_header[batch]),
+  _stash(new uint16_t[batch*JF_DATA_ELEM]),
+  _carry(new jungfrau_dgram[batch]),
+  _ncarry(0),
+  _carried(new jungfrau_dgram[batch]),
+  _ncarried(0),
+  _aborted(false),
+  _npackets(0),
+  _syscalls(0),
+  _packets(0),
+  _misplaced(0)
+{
+  if (::pipe(_sigfd)) {
+    fprintf(stderr, "%s pipe error: %s\n", __FUNCTION__, strerror(errno));
+    _sigfd[0] = _sigfd[1] = -1;
+  }
+
+  memset(_msgs, 0, batch*sizeof(mmsghdr));
+  for(unsigned i=0; i<batch; i++) {
+    _iovs[2*i].iov_base = &_headers[i];
+    _iovs[2*i].iov_len  = sizeof(jungfrau_header);
+    _iovs[2*i+1].iov_len = JF_PAYLOAD_SIZE;
+    _msgs[i].msg_hdr.msg_iov    = &_iovs[2*i];
+    _msgs[i].msg_hdr.msg_iovlen = 2;
+  }
+  memset(&_last, 0, sizeof(_last));
+}
+
+PacketReceiver::~PacketReceiver()
+{
+  if (_sigfd[0] >= 0) {
+    ::close(_sigfd[0]);
+    ::close(_sigfd[1]);
+  }
+  delete[] _msgs;
+  delete[] _iovs;
+  delete[] _headers;
+  delete[] _stash;
+  delete[] _carry;
+  delete[] _carried;
+}
+
+void PacketReceiver::abort()
+{
+  int sig = JF_FRAME_WAIT_EXIT;
+  ::write(_sigfd[1], &sig, sizeof(sig));
+}
+
+//
+//  Waits for the socket to be readable; false if aborted
+//
+bool PacketReceiver::_wait()
+{
+  pollfd pfds[2];
+  pfds[0].fd = _fd;
+  pfds[0].events = POLLIN;
+  pfds[1].fd = _sigfd[0];
+  pfds[1].events = POLLIN;
+
+  while(1) {
+    int npoll = ::poll(pfds, 2, -1);
+    _syscalls++;
+    if (npoll < 0) {
+      if (errno == EINTR) continue;
+      fprintf(stderr,"Error: packet receiver poll failed: %s\n", strerror(errno));
+      return false;
+    }
+    if (pfds[1].revents & POLLIN) {
+      int sig;
+      ::read(_sigfd[0], &sig, sizeof(sig));
+      _aborted = true;
+      return false;
+    }
+    if (pfds[0].revents & POLLIN)
+      return true;
+  }
+}
+
+//
+//  Accounts for one packet whose payload was received at "payload"
+//
+void PacketReceiver::_accept(const jungfrau_header& header, const uint16_t* payload, uint16_t* data)
+{
+  if (!_started) {
+    _frame   = header.framenum;
+    _started = true;
+  }
+
+  if (header.framenum < _frame)        // stale packet of a previous frame
+    return;
+
+  if (header.framenum > _frame) {      // the next frame has begun
+    _next_frame = true;
+    if (_ncarry < _batch) {
+      jungfrau_dgram& d = _carry[_ncarry++];
+      d.header = header;
+      memcpy(d.data, payload, JF_PAYLOAD_SIZE);
+    }
+    return;
+  }
+
+  unsigned p = header.packetnum;
+  if (p >= JF_PACKET_NUM || is_set(_filled, p))
+    return;
+
+  uint16_t* dst = &data[p*JF_DATA_ELEM];
+  if (payload != dst) {
+    memcpy(dst, payload, JF_PAYLOAD_SIZE);
+    _misplaced++;
+  }
+  set(_filled, p);
+  _npackets++;
+  _last = header;
+}
+
+bool PacketReceiver::get_frame(uint64_t* frame, uint16_t* data)
+{
+  _started    = false;
+  _next_frame = false;
+  _aborted    = false;
+  _npackets   = 0;
+  memset(_filled, 0, sizeof(_filled));
+
+  //  Start with the packets of this frame which ended the last one
+  jungfrau_dgram* carried = _carried;
+  _carried  = _carry;
+  _carry    = carried;
+  _ncarried = _ncarry;
+  _ncarry   = 0;
+  for(unsigned i=0; i<_ncarried; i++)
+    _accept(_carried[i].header, _carried[i].data, data);
+
+  unsigned cursor = 0;   // the lowest slot which may be free
+  while(_npackets < JF_PACKET_NUM && !_next_frame) {
+    //  Receive into the free slots in order; without one, into the stash
+    unsigned vlen = JF_PACKET_NUM - _npackets;
+    if (vlen > _batch) vlen = _batch;
+    for(unsigned i=0; i<vlen; i++) {
+      while(cursor < JF_PACKET_NUM && is_set(_filled, cursor))
+        cursor++;
+      _iovs[2*i+1].iov_base = (cursor < JF_PACKET_NUM) ?
+        &data[(cursor++)*JF_DATA_ELEM] : &_stash[i*JF_DATA_ELEM];
+    }
+
+    int nrecv = ::recvmmsg(_fd, _msgs, vlen, MSG_DONTWAIT, 0);
+    _syscalls++;
+    if (nrecv < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+        if (!_wait())
+          return false;
+        //  slots were not consumed; search again from the start
+        cursor = 0;
+        continue;
+      }
+      fprintf(stderr,"Error: failure receiving packets: %s\n", strerror(errno));
+      return false;
+    }
+    _packets += nrecv;
+
+    //  Move the payloads which landed in another packet's slot out of the
+    //  way first, so placing them can't overwrite one not yet examined.
+    for(int i=0; i<nrecv; i++) {
+      uint16_t* payload = (uint16_t*)_iovs[2*i+1].iov_base;
+      if (_msgs[i].msg_len != sizeof(jungfrau_dgram) ||
+          payload < data || payload >= data+JF_PACKET_NUM*JF_DATA_ELEM)
+        continue;
+      if (_headers[i].framenum != (_started ? _frame : _headers[0].framenum) ||
+          _headers[i].packetnum >= JF_PACKET_NUM ||
+          &data[_headers[i].packetnum*JF_DATA_ELEM] != payload) {
+        memcpy(&_stash[i*JF_DATA_ELEM], payload, JF_PAYLOAD_SIZE);
+        _iovs[2*i+1].iov_base = &_stash[i*JF_DATA_ELEM];
+      }
+    }
+
+    for(int i=0; i<nrecv; i++)
+      if (_msgs[i].msg_len == sizeof(jungfrau_dgram))   // discard runts
+        _accept(_headers[i], (uint16_t*)_iovs[2*i+1].iov_base, data);
+
+    cursor = 0;
+  }
+
+  *frame = _frame;
+  return _npackets == JF_PACKET_NUM;
+}
+
+unsigned PacketReceiver::flush()
+{
+  unsigned count = 0;
+  for(unsigned i=0; i<_batch; i++)
+    _iovs[2*i+1].iov_base = &_stash[i*JF_DATA_ELEM];
+
+  int nrecv;
+  while((nrecv = ::recvmmsg(_fd, _msgs, _batch, MSG_DONTWAIT, 0)) > 0)
+    count += nrecv;
+
+  //  forget packets kept for the next frame and any pending abort
+  count += _ncarry;
+  _ncarry = 0;
+
+  pollfd pfd;
+  pfd.fd = _sigfd[0];
+  pfd.events = POLLIN;
+  while(::poll(&pfd, 1, 0) > 0) {
+    int sig;
+    ::read(_sigfd[0], &sig, sizeof(sig));
+  }
+
+  return count;
+}
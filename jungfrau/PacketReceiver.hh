@@ -0,0 +1,75 @@
+#ifndef Pds_Jungfrau_PacketReceiver_hh
+#define Pds_Jungfrau_PacketReceiver_hh
+
+#include <stdint.h>
+#include <sys/socket.h>
+
+#include "DataFormat.hh"
+
+#define JF_RECV_BATCH 64
+
+namespace Pds {
+  namespace Jungfrau {
+    //
+    //  Receives the packets of a module's frames with recvmmsg.  The data
+    //  of each packet is received directly at the offset of the packet
+    //  expected next, so in-order packets need no copy; packets which
+    //  arrive out of order are moved to their packetnum offset afterwards.
+    //  A packet of the following frame ends the current (incomplete) frame
+    //  and is kept for the next call.
+    //
+    class PacketReceiver {
+      public:
+        PacketReceiver(int fd, unsigned batch=JF_RECV_BATCH);
+        ~PacketReceiver();
+      public:
+        //  Returns false if the frame is incomplete or the wait was aborted
+        bool get_frame(uint64_t* frame, uint16_t* data);
+        //  The header of the last packet of the last frame
+        const jungfrau_header& header() const;
+        //  Wakes (and fails) a get_frame in progress or the next one
+        void abort();
+        unsigned flush();
+      public:
+        bool     aborted  () const;  // the last frame's wait was aborted
+        unsigned npackets () const;  // packets received in the last frame
+        uint64_t syscalls () const;
+        uint64_t packets  () const;
+        uint64_t misplaced() const;
+      private:
+        bool _wait();
+        void _accept(const jungfrau_header& header, const uint16_t* payload, uint16_t* data);
+      private:
+        int              _fd;
+        int              _sigfd[2];
+        unsigned         _batch;
+        mmsghdr*         _msgs;
+        iovec*           _iovs;
+        jungfrau_header* _headers;
+        uint16_t*        _stash;
+        jungfrau_dgram*  _carry;
+        unsigned         _ncarry;
+        jungfrau_dgram*  _carried;
+        unsigned         _ncarried;
+        jungfrau_header  _last;
+        uint64_t         _frame;
+        bool             _started;
+        bool             _next_frame;
+        bool             _aborted;
+        uint64_t         _filled[(JF_PACKET_NUM+63)/64];
+        unsigned         _npackets;
+        uint64_t         _syscalls;
+        uint64_t         _packets;
+        uint64_t         _misplaced;
+    };
+  }
+}
+
+inline const Pds::Jungfrau::jungfrau_header& Pds::Jungfrau::PacketReceiver::header() const { return _last; }
+inline bool     Pds::Jungfrau::PacketReceiver::aborted  () const { return _aborted; }
+inline unsigned Pds::Jungfrau::PacketReceiver::npackets () const { return _npackets; }
+inline uint64_t Pds::Jungfrau::PacketReceiver::syscalls () const { return _syscalls; }
+inline uint64_t Pds::Jungfrau::PacketReceiver::packets  () const { return _packets; }
+inline uint64_t Pds::Jungfrau::PacketReceiver::misplaced() const { return _misplaced; }
+
+#endif
@@ -0,0 +1,144 @@
+#include "PixelCalib.hh"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+using namespace Pds::Jungfrau;
+
+static bool cpu_has_avx2()
+{
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+static bool _has_avx2 = cpu_has_avx2();
+static bool _use_simd = _has_avx2;
+
+//  The plane of constants for each value of the gain bits
+static const int _plane[] = { 0, 1, -1, 2 };
+
+static bool read_floats(const char* path, float* buff, unsigned n)
+{
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "PixelCalib failed to open %s: %s\n", path, strerror(errno));
+    return false;
+  }
+  size_t nread = fread(buff, sizeof(float), n, f);
+  fclose(f);
+  if (nread != n) {
+    fprintf(stderr, "PixelCalib read %zu of %u values from %s\n", nread, n, path);
+    return false;
+  }
+  return true;
+}
+
+PixelCalib::PixelCalib(unsigned npixels) :
+  _npixels (npixels),
+  _pedestal(new float[4*npixels]),
+  _gain    (new float[4*npixels])
+{
+  set(0, 0);
+}
+
+PixelCalib::~PixelCalib()
+{
+  delete[] _pedestal;
+  delete[] _gain;
+}
+
+void PixelCalib::set(const float* pedestals, const float* gains)
+{
+  for(unsigned g=0; g<4; g++) {
+    float* ped  = &_pedestal[g*_npixels];
+    float* gain = &_gain    [g*_npixels];
+    int p = _plane[g];
+    if (p < 0) {  // the invalid gain yields 0
+      memset(ped , 0, _npixels*sizeof(float));
+      memset(gain, 0, _npixels*sizeof(float));
+      continue;
+    }
+    if (pedestals)
+      memcpy(ped, &pedestals[p*_npixels], _npixels*sizeof(float));
+    else
+      memset(ped, 0, _npixels*sizeof(float));
+    for(unsigned i=0; i<_npixels; i++) {
+      float v = gains ? gains[p*_npixels+i] : 1.f;
+      gain[i] = v != 0 ? 1.f/v : 0.f;
+    }
+  }
+}
+
+bool PixelCalib::load(const char* path)
+{
+  char fname[256];
+  float* pedestals = new float[NGains*_npixels];
+  float* gains     = new float[NGains*_npixels];
+
+  snprintf(fname, sizeof(fname), "%s.pedestal", path);
+  bool lped  = read_floats(fname, pedestals, NGains*_npixels);
+
+  snprintf(fname, sizeof(fname), "%s.gain", path);
+  bool lgain = lped && read_floats(fname, gains, NGains*_npixels);
+
+  if (lped)
+    set(pedestals, lgain ? gains : 0);
+
+  delete[] pedestals;
+  delete[] gains;
+  return lped;
+}
+
+void PixelCalib::calibrate(const uint16_t* raw, float* out, unsigned offset, unsigned n) const
+{
+#if defined(__x86_64__)
+  if (_use_simd)
+    calibrate_avx2(raw, out, &_pedestal[offset], &_gain[offset], _npixels, n);
+  else
+#endif
+    calibrate_ref(raw, out, offset, n);
+}
+
+void PixelCalib::reduce(const uint16_t* raw, int16_t* out, unsigned offset, unsigned n, float scale) const
+{
+#if defined(__x86_64__)
+  if (_use_simd)
+    reduce_avx2(raw, out, &_pedestal[offset], &_gain[offset], _npixels, n, scale);
+  else
+#endif
+    reduce_ref(raw, out, offset, n, scale);
+}
+
+void PixelCalib::calibrate_ref(const uint16_t* raw, float* out, unsigned offset, unsigned n) const
+{
+  const float* ped  = &_pedestal[offset];
+  const float* gain = &_gain    [offset];
+  for(unsigned i=0; i<n; i++) {
+    unsigned k = (raw[i]>>14)*_npixels + i;
+    out[i] = (float(raw[i]&0x3fff) - ped[k]) * gain[k];
+  }
+}
+
+void PixelCalib::reduce_ref(const uint16_t* raw, int16_t* out, unsigned offset, unsigned n, float scale) const
+{
+  const float* ped  = &_pedestal[offset];
+  const float* gain = &_gain    [offset];
+  for(unsigned i=0; i<n; i++) {
+    unsigned k = (raw[i]>>14)*_npixels + i;
+    float v = (float(raw[i]&0x3fff) - ped[k]) * gain[k] * scale;
+    //  clamp as the vector max/min do, which also sends NaN to the minimum
+    v = v > -32768.f ? v : -32768.f;
+    v = v <  32767.f ? v :  32767.f;
+    out[i] = int16_t(lrintf(v));
+  }
+}
+
+bool PixelCalib::simd() { return _use_simd; }
+
+void PixelCalib::useSimd(bool l) { _use_simd = l && _has_avx2; }
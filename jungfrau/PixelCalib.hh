@@ -0,0 +1,58 @@
+#ifndef Pds_Jungfrau_PixelCalib_hh
+#define Pds_Jungfrau_PixelCalib_hh
+
+#include <stdint.h>
+
+namespace Pds {
+  namespace Jungfrau {
+    //
+    //  Per-pixel calibration constants of a Jungfrau detector and the
+    //  kernels which apply them.  Each raw word carries the adc value in
+    //  its low 14 bits and the gain in its top 2 bits (0 for gain 0,
+    //  1 for gain 1, 3 for gain 2; 2 never occurs and yields 0).  The
+    //  calibrated value of a pixel is
+    //
+    //    (adc - pedestal[gain]) / gain[gain]
+    //
+    //  The AVX2 kernels are used when the cpu supports them, and produce
+    //  the same bits as the scalar reference.
+    //
+    class PixelCalib {
+    public:
+      enum { NGains = 3 };
+      PixelCalib(unsigned npixels);
+      ~PixelCalib();
+    public:
+      //  Pedestals and gains are [NGains][npixels]; gains are in adc units
+      //  per unit of output, and a null gain array means 1 adc per unit.
+      void set (const float* pedestals, const float* gains);
+      //  Reads the raw float arrays from <path>.pedestal and <path>.gain
+      bool load(const char* path);
+      unsigned npixels() const;
+    public:
+      //  Calibrate the n pixels from "offset" of the detector
+      void calibrate    (const uint16_t* raw, float*   out, unsigned offset, unsigned n) const;
+      //  .. and round to int16 in units of 1/scale, saturating
+      void reduce       (const uint16_t* raw, int16_t* out, unsigned offset, unsigned n, float scale) const;
+      void calibrate_ref(const uint16_t* raw, float*   out, unsigned offset, unsigned n) const;
+      void reduce_ref   (const uint16_t* raw, int16_t* out, unsigned offset, unsigned n, float scale) const;
+    public:
+      static bool simd   ();
+      static void useSimd(bool);  // only effective if the cpu supports AVX2
+    private:
+      unsigned _npixels;
+      float*   _pedestal;  // [4][npixels] indexed by the gain bits
+      float*   _gain;      // reciprocal gains, same layout
+    };
+
+    //  The AVX2 kernels; pedestal and gain planes are "stride" apart
+    void calibrate_avx2(const uint16_t* raw, float* out, const float* pedestal, const float* gain,
+                        unsigned stride, unsigned n);
+    void reduce_avx2   (const uint16_t* raw, int16_t* out, const float* pedestal, const float* gain,
+                        unsigned stride, unsigned n, float scale);
+  }
+}
+
+inline unsigned Pds::Jungfrau::PixelCalib::npixels() const { return _npixels; }
+
+#endif
@@ -0,0 +1,112 @@
+//
+//  The AVX2 kernels of PixelCalib.  They alone are built for AVX2, and
+//  PixelCalib only calls them when the cpu supports it.
+//
+#if defined(__x86_64__)
+#include "PixelCalib.hh"
+
+#include <math.h>
+
+//  Only the code below is built for AVX2, so nothing the headers above
+//  emit can require it.
+#pragma GCC target("avx2")
+
+#include <immintrin.h>
+
+namespace {
+  //
+  //  Calibrates the 8 pixels in "x" from pixel i.  Sixteen pixels all in
+  //  gain 0 (the common case) take the constants from the gain 0 plane
+  //  directly; otherwise each pixel's constants are gathered from the
+  //  plane of its gain.
+  //
+  class Kernel {
+  public:
+    Kernel(const float* pedestal, const float* gain, unsigned stride) :
+      _pedestal(pedestal), _gain(gain),
+      _stride(_mm256_set1_epi32(stride)),
+      _iota  (_mm256_setr_epi32(0,1,2,3,4,5,6,7)),
+      _adc   (_mm256_set1_epi32(0x3fff)) {}
+  public:
+    __m256 gain0(__m256i x, unsigned i) const {
+      return _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(x), _mm256_loadu_ps(_pedestal+i)),
+                           _mm256_loadu_ps(_gain+i));
+    }
+    __m256 gather(__m256i x, unsigned i) const {
+      __m256i idx = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(x,14), _stride),
+                                     _mm256_add_epi32(_mm256_set1_epi32(i), _iota));
+      __m256 ped  = _mm256_i32gather_ps(_pedestal, idx, 4);
+      __m256 gain = _mm256_i32gather_ps(_gain    , idx, 4);
+      return _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(x,_adc)), ped), gain);
+    }
+    //  Calibrates the 16 pixels from i into lo and hi
+    void calibrate(const uint16_t* raw, unsigned i, __m256& lo, __m256& hi) const {
+      __m256i r  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw+i));
+      __m256i xl = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(r));
+      __m256i xh = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(r,1));
+      if (_mm256_testz_si256(r, _mm256_set1_epi16(short(0xc000)))) {
+        lo = gain0(xl, i);
+        hi = gain0(xh, i+8);
+      }
+      else {
+        lo = gather(xl, i);
+        hi = gather(xh, i+8);
+      }
+    }
+    //  The scalar calibration of pixel i, for the tail
+    float calibrate(const uint16_t* raw, unsigned i, unsigned stride) const {
+      unsigned k = (raw[i]>>14)*stride + i;
+      return (float(raw[i]&0x3fff) - _pedestal[k]) * _gain[k];
+    }
+  private:
+    const float* _pedestal;
+    const float* _gain;
+    __m256i      _stride;
+    __m256i      _iota;
+    __m256i      _adc;
+  };
+}
+
+void Pds::Jungfrau::calibrate_avx2(const uint16_t* raw, float* out,
+                                   const float* pedestal, const float* gain,
+                                   unsigned stride, unsigned n)
+{
+  Kernel k(pedestal, gain, stride);
+  unsigned i=0;
+  for(; i+16<=n; i+=16) {
+    __m256 lo, hi;
+    k.calibrate(raw, i, lo, hi);
+    _mm256_storeu_ps(out+i  , lo);
+    _mm256_storeu_ps(out+i+8, hi);
+  }
+  for(; i<n; i++)
+    out[i] = k.calibrate(raw, i, stride);
+}
+
+void Pds::Jungfrau::reduce_avx2(const uint16_t* raw, int16_t* out,
+                                const float* pedestal, const float* gain,
+                                unsigned stride, unsigned n, float scale)
+{
+  Kernel k(pedestal, gain, stride);
+  const __m256 vscale = _mm256_set1_ps(scale);
+  const __m256 vmin   = _mm256_set1_ps(-32768.f);
+  const __m256 vmax   = _mm256_set1_ps( 32767.f);
+  unsigned i=0;
+  for(; i+16<=n; i+=16) {
+    __m256 lo, hi;
+    k.calibrate(raw, i, lo, hi);
+    lo = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(lo, vscale), vmin), vmax);
+    hi = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(hi, vscale), vmin), vmax);
+    //  packs interleaves the 128-bit lanes; put them back in order
+    __m256i w = _mm256_packs_epi32(_mm256_cvtps_epi32(lo), _mm256_cvtps_epi32(hi));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out+i), _mm256_permute4x64_epi64(w, 0xd8));
+  }
+  for(; i<n; i++) {
+    float v = k.calibrate(raw, i, stride) * scale;
+    v = v > -32768.f ? v : -32768.f;
+    v = v <  32767.f ? v :  32767.f;
+    out[i] = int16_t(lrintf(v));
+  }
+}
+
+#endif
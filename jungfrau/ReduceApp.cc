@@ -0,0 +1,187 @@
+#include "ReduceApp.hh"
+#include "PixelCalib.hh"
+
+#include "pds/config/JungfrauConfigType.hh"
+#include "pds/xtc/CDatagram.hh"
+#include "pds/service/GenericPoolW.hh"
+#include "pdsdata/xtc/Xtc.hh"
+
+#include <new>
+#include <stdio.h>
+#include <string.h>
+
+namespace Pds {
+  namespace Jungfrau {
+    class ReduceEntry {
+    public:
+      ReduceEntry(const Xtc& xtc) :
+        _buffer(new char[xtc.sizeofPayload()]),
+        _calib (0)
+      {
+        memcpy(_buffer, xtc.payload(), xtc.sizeofPayload());
+        _calib = new PixelCalib(config().numPixels());
+      }
+      ~ReduceEntry() { delete _calib; delete[] _buffer; }
+    public:
+      const JungfrauConfigType& config() const { return *reinterpret_cast<const JungfrauConfigType*>(_buffer); }
+      const PixelCalib&         calib () const { return *_calib; }
+      PixelCalib&               calib ()       { return *_calib; }
+      unsigned npixels    () const { return config().numPixels(); }
+      unsigned size       () const { return JungfrauDataType::_sizeof(config()); }
+      unsigned header_size() const { return size() - npixels()*sizeof(uint16_t); }
+    private:
+      char*       _buffer;
+      PixelCalib* _calib;
+    };
+  }
+}
+
+using namespace Pds;
+using namespace Pds::Jungfrau;
+
+ReduceApp::ReduceApp(Mode mode, const char* calib_dir, float scale, size_t max_size) :
+  _mode     (mode),
+  _calib_dir(calib_dir ? calib_dir : "."),
+  _scale    (scale),
+  _pool     (mode==Calibrated ? new GenericPoolW(max_size,4) : 0),
+  _max_size (max_size),
+  _growth   (0),
+  _lconfig  (false),
+  _out      (0)
+{
+}
+
+ReduceApp::~ReduceApp()
+{
+  for(EntryMap::iterator it=_entries.begin(); it!=_entries.end(); it++)
+    delete it->second;
+  if (_pool) delete _pool;
+}
+
+Transition* ReduceApp::transitions(Transition* tr)
+{
+  return tr;
+}
+
+InDatagram* ReduceApp::events(InDatagram* dg)
+{
+  if (dg->datagram().seq.service() == TransitionId::Configure) {
+    for(EntryMap::iterator it=_entries.begin(); it!=_entries.end(); it++)
+      delete it->second;
+    _entries.clear();
+    _growth = 0;
+
+    _lconfig = true;
+    iterate(&dg->datagram().xtc);
+    _lconfig = false;
+  }
+  else if (dg->datagram().seq.service() == TransitionId::L1Accept && !_entries.empty()) {
+    if (_mode == Reduced) {
+      iterate(&dg->datagram().xtc);
+    }
+    else if (sizeof(CDatagram) + dg->datagram().xtc.sizeofPayload() + _growth > _max_size) {
+      printf("ReduceApp: calibrated event would exceed %zu bytes; passing raw\n", _max_size);
+    }
+    else {
+      CDatagram* odg = new (_pool) CDatagram(dg->datagram());
+      odg->datagram().xtc.damage = dg->datagram().xtc.damage;
+      _out = &odg->datagram().xtc;
+      iterate(&dg->datagram().xtc);
+      _out = 0;
+      return odg;
+    }
+  }
+  return dg;
+}
+
+int ReduceApp::process(Xtc* xtc)
+{
+  if (_lconfig) {
+    if (xtc->contains.id() == TypeId::Id_Xtc)
+      iterate(xtc);
+    else if (xtc->contains.value() == _jungfrauConfigType.value())
+      _configure(xtc);
+    return 1;
+  }
+
+  const ReduceEntry* entry = 0;
+  if (xtc->contains.value() == _jungfrauDataType.value()) {
+    EntryMap::const_iterator it = _entries.find(static_cast<const DetInfo&>(xtc->src));
+    if (it != _entries.end() && unsigned(xtc->sizeofPayload()) >= it->second->size())
+      entry = it->second;
+  }
+
+  if (_mode == Reduced) {
+    if (xtc->contains.id() == TypeId::Id_Xtc)
+      iterate(xtc);
+    else if (entry)
+      _reduce(xtc, *entry);
+  }
+  else {
+    if (xtc->contains.id() == TypeId::Id_Xtc) {
+      //  Rebuild the container and its contents in the output
+      Xtc* parent = _out;
+      _out = new (parent) Xtc(xtc->contains, xtc->src, xtc->damage);
+      iterate(xtc);
+      parent->alloc(_out->sizeofPayload());
+      _out = parent;
+    }
+    else if (entry)
+      _calibrate(xtc, *entry);
+    else
+      _copy(xtc);
+  }
+  return 1;
+}
+
+void ReduceApp::_configure(Xtc* xtc)
+{
+  const DetInfo& info = static_cast<const DetInfo&>(xtc->src);
+  ReduceEntry* entry = new ReduceEntry(*xtc);
+
+  std::string path = _calib_dir + "/" + DetInfo::name(info);
+  if (!entry->calib().load(path.c_str())) {
+    printf("ReduceApp: no constants for %s; its frames pass unchanged\n", DetInfo::name(info));
+    delete entry;
+    return;
+  }
+
+  printf("ReduceApp: loaded constants for %s [%u pixels] %s\n",
+         DetInfo::name(info), entry->npixels(), PixelCalib::simd() ? "(avx2)" : "");
+
+  EntryMap::iterator it = _entries.find(info);
+  if (it != _entries.end()) {
+    delete it->second;
+    it->second = entry;
+  }
+  else
+    _entries[info] = entry;
+
+  _growth += entry->npixels()*(sizeof(float)-sizeof(uint16_t));
+}
+
+void ReduceApp::_reduce(Xtc* xtc, const ReduceEntry& entry)
+{
+  const JungfrauDataType& elem = *reinterpret_cast<const JungfrauDataType*>(xtc->payload());
+  uint16_t* frame = const_cast<uint16_t*>(elem.frame(entry.config()).data());
+  entry.calib().reduce(frame, reinterpret_cast<int16_t*>(frame), 0, entry.npixels(), _scale);
+  xtc->contains = TypeId(TypeId::Id_JungfrauElement, ReducedVersion);
+}
+
+void ReduceApp::_calibrate(Xtc* xtc, const ReduceEntry& entry)
+{
+  const JungfrauDataType& elem = *reinterpret_cast<const JungfrauDataType*>(xtc->payload());
+  unsigned hsize = entry.header_size();
+  unsigned fsize = entry.npixels()*sizeof(float);
+
+  Xtc& tc = *new (_out) Xtc(TypeId(TypeId::Id_JungfrauElement, CalibratedVersion), xtc->src, xtc->damage);
+  memcpy(tc.alloc(hsize), xtc->payload(), hsize);
+  entry.calib().calibrate(elem.frame(entry.config()).data(),
+                          reinterpret_cast<float*>(tc.alloc(fsize)), 0, entry.npixels());
+  _out->alloc(hsize + fsize);
+}
+
+void ReduceApp::_copy(Xtc* xtc)
+{
+  memcpy(_out->alloc(xtc->extent), xtc, xtc->extent);
+}
@@ -0,0 +1,63 @@
+#ifndef Pds_Jungfrau_ReduceApp_hh
+#define Pds_Jungfrau_ReduceApp_hh
+
+#include "pds/utility/Appliance.hh"
+#include "pds/config/JungfrauDataType.hh"
+#include "pdsdata/xtc/XtcIterator.hh"
+#include "pdsdata/xtc/DetInfo.hh"
+
+#include <map>
+#include <string>
+
+namespace Pds {
+  class GenericPoolW;
+  namespace Jungfrau {
+    class PixelCalib;
+    class ReduceEntry;
+
+    //
+    //  An optional segment level appliance which decodes the gain bits of
+    //  Jungfrau frames and applies the pedestals and gains of each pixel.
+    //  Constants are loaded at Configure for each Jungfrau configuration
+    //  in the datagram from <calib_dir>/<DetInfo name>.pedestal and .gain
+    //  (see PixelCalib), and frames of a detector without constants pass
+    //  unchanged.
+    //
+    //  Reduced frames are rounded to int16 in units of 1/scale in place of
+    //  the raw frame.  Calibrated frames hold floats and are copied into a
+    //  new datagram of at most max_size bytes.  Either is marked with its
+    //  own element version, so readers of the raw element ignore it.
+    //
+    class ReduceApp : public Appliance, public XtcIterator {
+    public:
+      enum Mode { Reduced, Calibrated };
+      enum { ReducedVersion    = 0x100 | JungfrauDataType::Version,
+             CalibratedVersion = 0x200 | JungfrauDataType::Version };
+      ReduceApp(Mode mode, const char* calib_dir, float scale=1, size_t max_size=0x4000000);
+      ~ReduceApp();
+    public:
+      Transition* transitions(Transition*);
+      InDatagram* events     (InDatagram*);
+    public:
+      int process(Xtc*);
+    private:
+      void _configure(Xtc*);
+      void _reduce   (Xtc*, const ReduceEntry&);
+      void _calibrate(Xtc*, const ReduceEntry&);
+      void _copy     (Xtc*);
+    private:
+      typedef std::map<DetInfo, ReduceEntry*> EntryMap;
+      Mode          _mode;
+      std::string   _calib_dir;
+      float         _scale;
+      GenericPoolW* _pool;
+      size_t        _max_size;
+      unsigned      _growth;  // the increase of a calibrated event
+      EntryMap      _entries;
+      bool          _lconfig;
+      Xtc*          _out;     // the output xtc being filled
+    };
+  }
+}
+
+#endif
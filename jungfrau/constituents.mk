@@ -9,8 +9,16 @@ libnames += jungfrau
 CPPFLAGS += -std=c++11
 endif
 
-libsrcs_jungfrauseg := Segment.cc
+libsrcs_jungfrauseg := Segment.cc PixelCalib.cc PixelCalibAvx2.cc ReduceApp.cc
 libincs_jungfrauseg := pdsdata/include ndarray/include boost/include
 
-libsrcs_jungfrau := $(filter-out $(libsrcs_jungfrauseg),$(wildcard *.cc))
+libsrcs_jungfrau := $(filter-out $(libsrcs_jungfrauseg) jfrecvbench.cc jfcalibbench.cc,$(wildcard *.cc))
 libincs_jungfrau := pdsdata/include ndarray/include boost/include slsdet/include
+
+tgtnames := jfrecvbench jfcalibbench
+tgtsrcs_jfrecvbench := jfrecvbench.cc PacketReceiver.cc
+tgtslib_jfrecvbench := $(USRLIBDIR)/rt $(USRLIBDIR)/pthread
+tgtincs_jfrecvbench := pdsdata/include
+tgtsrcs_jfcalibbench := jfcalibbench.cc PixelCalib.cc PixelCalibAvx2.cc
+tgtlibs_jfcalibbench := pdsdata/compressdata
+tgtincs_jfcalibbench := pdsdata/include
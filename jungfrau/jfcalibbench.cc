@@ -0,0 +1,161 @@
+//
+//  Throughput of the Jungfrau gain decoding and pedestal subtraction on
+//  synthetic multi-module frames.  Each kernel (scalar reference and
+//  AVX2, calibrated float and reduced int16) is timed, the AVX2 results
+//  are compared bit for bit with the reference, and the raw and reduced
+//  frames are compressed with the Hist16 engine to compare their sizes.
+//
+#include "pds/jungfrau/PixelCalib.hh"
+#include "pdsdata/compress/Hist16Engine.hh"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+
+using namespace Pds;
+using namespace Pds::Jungfrau;
+
+static const unsigned ModulePixels = 512*1024;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+static double gauss()
+{
+  double u = drand48(), v = drand48();
+  return sqrt(-2*log(u > 0 ? u : 1.e-12))*cos(2*M_PI*v);
+}
+
+static unsigned clamp14(double v)
+{
+  return v < 0 ? 0 : v > 0x3fff ? 0x3fff : unsigned(v);
+}
+
+//
+//  Pixels mostly in gain 0 with noise of a few adc and sparse photons;
+//  a fraction switch to gains 1 and 2 and a few carry the invalid gain.
+//
+static void generate(uint16_t* raw, const float* ped, unsigned npixels, double fswitch)
+{
+  for(unsigned i=0; i<npixels; i++) {
+    double r = drand48();
+    unsigned g = r < fswitch*0.7 ? 1 : r < fswitch ? 3 : r < fswitch+1.e-4 ? 2 : 0;
+    unsigned p = g==3 ? 2 : g==2 ? 0 : g;
+    double v = ped[p*npixels+i] + (g==0 ? 3. : 1.)*gauss();
+    if (g==0 && drand48() < 0.01)
+      v += 40.*9.5;  // a 9.5 keV photon
+    raw[i] = (g<<14) | clamp14(v);
+  }
+}
+
+static void usage(const char* p)
+{
+  printf("Usage: %s [-m <modules>] [-n <frames>] [-f <fraction switched>] [-s <scale>]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned nmods    = 8;
+  unsigned nframes  = 20;
+  double   fswitch  = 0.01;
+  float    scale    = 10;   // 0.1 keV
+
+  int c;
+  while ((c = getopt(argc, argv, "m:n:f:s:h")) != -1) {
+    switch(c) {
+    case 'm': nmods   = strtoul(optarg,NULL,0); break;
+    case 'n': nframes = strtoul(optarg,NULL,0); break;
+    case 'f': fswitch = strtod (optarg,NULL); break;
+    case 's': scale   = strtod (optarg,NULL); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  const unsigned npixels = nmods*ModulePixels;
+
+  //  Constants typical of a module; gains in adc per keV
+  float* ped  = new float[PixelCalib::NGains*npixels];
+  float* gain = new float[PixelCalib::NGains*npixels];
+  for(unsigned i=0; i<npixels; i++) {
+    ped [i]           = 3000 + 300*gauss();
+    ped [npixels+i]   = 14000 + 200*gauss();
+    ped [2*npixels+i] = 14500 + 200*gauss();
+    gain[i]           = 40 + 2*gauss();
+    gain[npixels+i]   = -1.5 - 0.05*gauss();
+    gain[2*npixels+i] = -0.1 - 0.005*gauss();
+  }
+  PixelCalib calib(npixels);
+  calib.set(ped, gain);
+
+  uint16_t* raw = new uint16_t[npixels];
+  generate(raw, ped, npixels, fswitch);
+
+  float*   fref = new float  [npixels];
+  float*   fout = new float  [npixels];
+  int16_t* iref = new int16_t[npixels];
+  int16_t* iout = new int16_t[npixels];
+
+  printf("%u modules, %u frames, %.1f%% switched pixels, avx2 %s\n",
+         nmods, nframes, 100*fswitch, PixelCalib::simd() ? "available" : "not available");
+
+  bool lsimd = PixelCalib::simd();
+  for(unsigned pass=0; pass<(lsimd ? 2:1); pass++) {
+    bool lref = (pass==0);
+    PixelCalib::useSimd(!lref);
+
+    double t0 = now();
+    for(unsigned f=0; f<nframes; f++)
+      calib.calibrate(raw, lref ? fref : fout, 0, npixels);
+    double t1 = now();
+    for(unsigned f=0; f<nframes; f++)
+      calib.reduce(raw, lref ? iref : iout, 0, npixels, scale);
+    double t2 = now();
+
+    printf("%-8s calibrated: %7.1f frames/s %6.2f ns/pixel   reduced: %7.1f frames/s %6.2f ns/pixel\n",
+           lref ? "scalar" : "avx2",
+           double(nframes)/(t1-t0), 1.e9*(t1-t0)/(double(nframes)*npixels),
+           double(nframes)/(t2-t1), 1.e9*(t2-t1)/(double(nframes)*npixels));
+  }
+
+  if (lsimd) {
+    bool fexact = memcmp(fref, fout, npixels*sizeof(float))==0;
+    bool iexact = memcmp(iref, iout, npixels*sizeof(int16_t))==0;
+    printf("avx2 vs scalar: calibrated %s, reduced %s\n",
+           fexact ? "bit exact" : "DIFFER", iexact ? "bit exact" : "DIFFER");
+    if (!fexact || !iexact)
+      return 1;
+  }
+
+  //  Compressibility of one module of the raw and reduced frames
+  Compress::Hist16Engine engine;
+  Compress::Hist16Engine::ImageParams img;
+  img.width  = ModulePixels;
+  img.height = 1;
+  img.depth  = 2;
+  char*  obuff = new char[ModulePixels*sizeof(uint16_t)*5/4];
+  size_t craw, cred;
+  if (engine.compress(raw , img, obuff, craw) == Compress::Hist16Engine::Success &&
+      engine.compress(iref, img, obuff, cred) == Compress::Hist16Engine::Success)
+    printf("hist16 compressed module: raw %.3f  reduced %.3f of original size\n",
+           double(craw)/double(ModulePixels*sizeof(uint16_t)),
+           double(cred)/double(ModulePixels*sizeof(uint16_t)));
+  else
+    printf("hist16 compression failed\n");
+
+  delete[] obuff;
+  delete[] raw;
+  delete[] fref;
+  delete[] fout;
+  delete[] iref;
+  delete[] iout;
+  delete[] ped;
+  delete[] gain;
+  return 0;
+}
@@ -0,0 +1,300 @@
+//
+//  Throughput of the Jungfrau packet receiver.  A synthetic generator
+//  sends frames of JF_PACKET_NUM packets to a UDP port, and a receiver
+//  reassembles them either with the batched PacketReceiver or with the
+//  previous peek-and-read of each packet.  Reports frames/s and the
+//  receiver's frames per cpu-second.
+//
+//  The generator and receiver run in one process by default, or in
+//  separate processes (hosts) with -s and -r.
+//
+#include "pds/jungfrau/PacketReceiver.hh"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+using namespace Pds::Jungfrau;
+
+static unsigned nframes  = 10000;
+static unsigned rate     = 0;    // frames/s, 0 = as fast as possible
+static unsigned swap     = 0;    // swap a pair of packets every n
+static bool     lverbose = false;
+
+static double now(clockid_t clk=CLOCK_REALTIME)
+{
+  timespec ts;
+  clock_gettime(clk, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+//
+//  The generator
+//
+class Generator {
+public:
+  Generator(const sockaddr_in& dst) : _sent(0) {
+    _fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (::connect(_fd, (const sockaddr*)&dst, sizeof(dst)) < 0)
+      perror("Generator connect");
+    _dgrams = new jungfrau_dgram[JF_PACKET_NUM];
+    memset(_dgrams, 0, JF_PACKET_NUM*sizeof(jungfrau_dgram));
+    for(unsigned i=0; i<JF_PACKET_NUM; i++) {
+      _iovs[i].iov_base = &_dgrams[i];
+      _iovs[i].iov_len  = sizeof(jungfrau_dgram);
+      memset(&_msgs[i], 0, sizeof(mmsghdr));
+      _msgs[i].msg_hdr.msg_iov    = &_iovs[i];
+      _msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+  }
+  ~Generator() { ::close(_fd); delete[] _dgrams; }
+public:
+  void run() {
+    //  the order in which the packets are sent
+    unsigned order[JF_PACKET_NUM];
+    for(unsigned i=0; i<JF_PACKET_NUM; i++)
+      order[i] = i;
+    if (swap)
+      for(unsigned i=0; i+1<JF_PACKET_NUM; i+=swap) {
+        order[i]   = i+1;
+        order[i+1] = i;
+      }
+
+    double t0 = now();
+    for(uint64_t frame=1; frame<=nframes; frame++) {
+      for(unsigned i=0; i<JF_PACKET_NUM; i++) {
+        unsigned p = order[i];
+        jungfrau_header& h = _dgrams[i].header;
+        h.framenum  = frame;
+        h.packetnum = p;
+        h.timestamp = frame;
+        _dgrams[i].data[0] = frame & 0xffff;
+        _dgrams[i].data[1] = p;
+      }
+      for(unsigned i=0; i<JF_PACKET_NUM; ) {
+        int n = ::sendmmsg(_fd, &_msgs[i], JF_PACKET_NUM-i, 0);
+        if (n < 0) {
+          if (errno==ECONNREFUSED || errno==ENOBUFS) continue;
+          perror("Generator sendmmsg");
+          return;
+        }
+        i += n;
+      }
+      _sent++;
+      if (rate) {
+        double dt = double(frame)/double(rate) - (now()-t0);
+        if (dt > 0) usleep(unsigned(dt*1.e6));
+      }
+    }
+  }
+  unsigned sent() const { return _sent; }
+private:
+  int             _fd;
+  jungfrau_dgram* _dgrams;
+  iovec           _iovs[JF_PACKET_NUM];
+  mmsghdr         _msgs[JF_PACKET_NUM];
+  unsigned        _sent;
+};
+
+//
+//  The previous receiver: peek at the header, then read the packet into place
+//
+static bool legacy_frame(int fd, uint64_t* frame, uint16_t* data, unsigned& syscalls)
+{
+  jungfrau_header header;
+  unsigned npackets = 0;
+  bool first = true;
+  while(1) {
+    int nb = ::recvfrom(fd, &header, sizeof(header), MSG_PEEK, 0, 0);
+    syscalls++;
+    if (nb < 0) return false;
+    if (first) {
+      *frame = header.framenum;
+      first = false;
+    }
+    else if (*frame != header.framenum)
+      return false;
+
+    iovec iov[2];
+    iov[0].iov_base = &header;
+    iov[0].iov_len  = sizeof(header);
+    iov[1].iov_base = &data[JF_DATA_ELEM*header.packetnum];
+    iov[1].iov_len  = sizeof(jungfrau_dgram)-sizeof(jungfrau_header);
+    nb = ::readv(fd, iov, 2);
+    syscalls++;
+    if (nb < 0) return false;
+    npackets++;
+    if (header.packetnum == JF_PACKET_NUM-1)
+      return npackets == JF_PACKET_NUM;
+  }
+}
+
+static bool verify(uint64_t frame, const uint16_t* data)
+{
+  for(unsigned p=0; p<JF_PACKET_NUM; p++) {
+    const uint16_t* d = &data[p*JF_DATA_ELEM];
+    if (d[0] != (frame & 0xffff) || d[1] != p) {
+      printf("frame %lu packet %u misplaced: found frame %u packet %u\n",
+             (unsigned long)frame, p, d[0], d[1]);
+      return false;
+    }
+  }
+  return true;
+}
+
+//
+//  The receiver
+//
+class Receiver {
+public:
+  Receiver(unsigned port, unsigned batch, bool legacy) :
+    _legacy(legacy), _recv(0), _complete(0), _incomplete(0), _errors(0), _syscalls(0) {
+    _fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    unsigned sz = sizeof(jungfrau_dgram)*JF_PACKET_NUM*JF_EVENTS_TO_BUFFER;
+    ::setsockopt(_fd, SOL_SOCKET, SO_RCVBUF, &sz, sizeof(sz));
+    sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family      = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_ANY);
+    sa.sin_port        = htons(port);
+    if (::bind(_fd, (sockaddr*)&sa, sizeof(sa)) < 0)
+      perror("Receiver bind");
+    if (_legacy) {
+      timeval tv;
+      tv.tv_sec = 0; tv.tv_usec = 200000;
+      ::setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    }
+    else
+      _recv = new PacketReceiver(_fd, batch);
+    _data = new uint16_t[JF_PACKET_NUM*JF_DATA_ELEM];
+  }
+  ~Receiver() { delete _recv; delete[] _data; ::close(_fd); }
+public:
+  void run() {
+    double c0 = now(CLOCK_THREAD_CPUTIME_ID);
+    _t1 = _t0 = now();
+    while(_complete + _incomplete < nframes) {
+      uint64_t frame;
+      bool ok;
+      if (_legacy) {
+        ok = legacy_frame(_fd, &frame, _data, _syscalls);
+        if (!ok && errno==EAGAIN) break;
+      }
+      else {
+        ok = _recv->get_frame(&frame, _data);
+        if (!ok && _recv->aborted()) break;
+      }
+      if (ok) {
+        _complete++;
+        if (lverbose && !verify(frame, _data)) _errors++;
+      }
+      else
+        _incomplete++;
+      _t1 = now();
+    }
+    _cpu = now(CLOCK_THREAD_CPUTIME_ID) - c0;
+    if (_recv) _syscalls = _recv->syscalls();
+  }
+  void abort() { if (_recv) _recv->abort(); }
+  void report() const {
+    double dt = _t1 - _t0;
+    printf("%s receiver: %u complete %u incomplete frames", _legacy ? "legacy" : "batched",
+           _complete, _incomplete);
+    if (lverbose) printf(" (%u misplaced)", _errors);
+    printf("\n  %.0f frames/s  %.0f frames/cpu-s  %.1f syscalls/frame",
+           double(_complete)/dt, double(_complete)/_cpu,
+           double(_syscalls)/double(_complete+_incomplete));
+    if (_recv) printf("  %.1f%% packets moved", 100.*double(_recv->misplaced())/double(_recv->packets()));
+    printf("\n");
+  }
+private:
+  int             _fd;
+  bool            _legacy;
+  PacketReceiver* _recv;
+  uint16_t*       _data;
+  unsigned        _complete, _incomplete, _errors, _syscalls;
+  double          _t0, _t1, _cpu;
+};
+
+static void* receiver_thread(void* arg) { ((Receiver*)arg)->run(); return 0; }
+
+void usage(const char* p)
+{
+  printf("Usage: %s [-n <frames>] [-p <port>] [-b <batch>] [-R <frames/s>] [-o <swap every n>] [-l] [-v]\n"
+         "          [-s <host> (generate only)] [-r (receive only)]\n"
+         "  -l : use the legacy (peek and read) receiver\n"
+         "  -v : verify the packet placement\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned port  = 32410;
+  unsigned batch = JF_RECV_BATCH;
+  bool     legacy= false;
+  bool     lsend = true;
+  bool     lrecv = true;
+  const char* host = "127.0.0.1";
+
+  int c;
+  while ((c = getopt(argc, argv, "n:p:b:R:o:s:rlvh")) != -1) {
+    switch(c) {
+    case 'n': nframes = strtoul(optarg,NULL,0); break;
+    case 'p': port    = strtoul(optarg,NULL,0); break;
+    case 'b': batch   = strtoul(optarg,NULL,0); break;
+    case 'R': rate    = strtoul(optarg,NULL,0); break;
+    case 'o': swap    = strtoul(optarg,NULL,0); break;
+    case 's': host    = optarg; lrecv = false; break;
+    case 'r': lsend   = false; break;
+    case 'l': legacy  = true; break;
+    case 'v': lverbose= true; break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  Receiver* recv = 0;
+  pthread_t tid;
+  if (lrecv) {
+    recv = new Receiver(port, batch, legacy);
+    pthread_create(&tid, 0, receiver_thread, recv);
+  }
+
+  if (lsend) {
+    hostent* entries = gethostbyname(host);
+    if (!entries) {
+      printf("Unknown host %s\n", host);
+      return 1;
+    }
+    sockaddr_in dst;
+    memset(&dst, 0, sizeof(dst));
+    dst.sin_family = AF_INET;
+    dst.sin_addr.s_addr = *(in_addr_t*)entries->h_addr_list[0];
+    dst.sin_port = htons(port);
+
+    Generator gen(dst);
+    double t0 = now();
+    gen.run();
+    double dt = now()-t0;
+    printf("generator: %u frames in %.3f s : %.0f frames/s\n", gen.sent(), dt, double(gen.sent())/dt);
+  }
+
+  if (recv) {
+    if (lsend) {
+      //  let the receiver drain, then stop it waiting for frames that were dropped
+      usleep(200000);
+      recv->abort();
+    }
+    pthread_join(tid, 0);
+    recv->report();
+    delete recv;
+  }
+  return 0;
+}
@@ -37,6 +37,7 @@ ControlStreams::ControlStreams(PartitionMember& cmgr) :
     //    vmoneb);
 
     eb->no_build(Sequence::Event,1<<TransitionId::L1Accept);
+    eb->peek(true);  // receive event level datagrams directly into their event
 
     _inlet_wires[s] = eb;
   }
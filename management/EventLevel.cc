@@ -14,7 +14,9 @@
 #include "pds/utility/InletWireServer.hh"
 #include "pds/utility/InletWireIns.hh"
 #include "pds/utility/NetDgServer.hh"
+#include "pds/utility/Eb.hh"
 #include "pds/utility/EbSGroup.hh"
+#include "pds/utility/EbShards.hh"
 
 using namespace Pds;
 
@@ -24,13 +26,17 @@ EventLevel::EventLevel(unsigned platform,
                        Arp* arp,
                        unsigned max_eventsize,
                        unsigned max_buffers,
-		       bool     is_triggered
+		       bool     is_triggered,
+                       unsigned nshards,
+                       PoolPolicy::Pages datagram_pages
                        ) :
   PartitionMember(platform, Level::Event, slowEb, arp),
   _callback   (callback),
   _streams    (0),
   _max_eventsize(max_eventsize),
-  _max_buffers  (max_buffers)
+  _max_buffers  (max_buffers),
+  _nshards      (nshards),
+  _datagram_pages(datagram_pages)
 {
   if (!_max_eventsize)
     _max_eventsize = EventStreams::MaxSize;
@@ -50,14 +56,23 @@ bool EventLevel::attach()
   start();
   while(1) {
     if (connect()) {
+      //  The builders' datagram pools are faulted in before the first event
+      if (_datagram_pages != PoolPolicy::Normal)
+        Eb::datagram_policy(_datagram_pages, true);
+
       if (_max_eventsize)
         _streams = new EventStreams(*this,
                                     slowEb(),
                                     _max_eventsize,
                                     EventStreams::netbufdepth,
-                                    _max_buffers);
+                                    _max_buffers,
+                                    _nshards);
       else
-        _streams = new EventStreams(*this, slowEb());
+        _streams = new EventStreams(*this, slowEb(),
+                                    EventStreams::MaxSize,
+                                    EventStreams::netbufdepth,
+                                    EventStreams::EbDepth,
+                                    _nshards);
 
       _streams->connect();
 
@@ -130,6 +145,7 @@ void    EventLevel::allocated(const Allocation& alloc,
       NetDgServer* srv = new NetDgServer(srvIns,
            node.procInfo(),
            EventStreams::netbufdepth*EventStreams::MaxSize);
+      srv->server().batch(EventStreams::netbatchdepth);
       Ins mcastIns(ins.address());
       srv->server().join(mcastIns, Ins(header().ip()));
       Ins bcastIns = StreamPorts::bcast(partition, Level::Event);
@@ -158,7 +174,11 @@ void    EventLevel::allocated(const Allocation& alloc,
   //!!! segment group support
   for (int iGroup = 0; iGroup < (int) lGroupSegMask.size(); ++iGroup)
     printf("Group %d Segment Mask 0x%04x%04x\n", iGroup, lGroupSegMask[iGroup].value(1), lGroupSegMask[iGroup].value(0) );
-  ((EbSGroup*) inlet)-> setClientMask(lGroupSegMask);
+  EbShards* shards = dynamic_cast<EbShards*>(inlet);
+  if (shards)
+    shards->setClientMask(lGroupSegMask);
+  else
+    ((EbSGroup*) inlet)-> setClientMask(lGroupSegMask);
 
   OutletWire* owire = _streams->stream(StreamParams::FrameWork)->outlet()->wire();
   owire->bind(OutletWire::Bcast, StreamPorts::bcast(partition,
@@ -3,6 +3,7 @@
 
 #include "PartitionMember.hh"
 #include "pds/collection/PingReply.hh"
+#include "pds/service/PoolPolicy.hh"
 
 namespace Pds {
 
@@ -18,7 +19,9 @@ public:
 	     Arp*           arp,
              unsigned       max_eventsize = 0,
              unsigned       max_buffers = 0,
-	     bool           is_triggered = false);
+	     bool           is_triggered = false,
+             unsigned       nshards = 0,
+             PoolPolicy::Pages datagram_pages = PoolPolicy::Normal);
   virtual ~EventLevel();
 
   bool attach();
@@ -38,6 +41,8 @@ private:
   PingReply      _reply;
   unsigned       _max_eventsize;
   unsigned       _max_buffers;
+  unsigned       _nshards;
+  PoolPolicy::Pages _datagram_pages;
 };
 
 }
@@ -5,6 +5,7 @@
 #include "pds/management/VmonServerAppliance.hh"
 #include "pds/service/VmonSourceId.hh"
 #include "pds/service/BitList.hh"
+#include "pds/utility/EbShards.hh"
 #include "pds/vmon/VmonEb.hh"
 #include "pds/xtc/XtcType.hh"
 
@@ -17,7 +18,8 @@ EventStreams::EventStreams(PartitionMember& cmgr,
          int      slowEb,
          unsigned max_size,
          unsigned net_buf_depth,
-         unsigned eb_depth
+         unsigned eb_depth,
+         unsigned nshards
          ) :
   WiredStreams(VmonSourceId(cmgr.header().level(), cmgr.header().ip()))
 {
@@ -33,7 +35,25 @@ EventStreams::EventStreams(PartitionMember& cmgr,
           max_size*net_buf_depth,
           cmgr.occurrences());
 
-    _inlet_wires[s] = new SegEventBuilder(src,
+    if (nshards) {
+      EbShards* eb = new EbShards(src,
+                                  _xtcType,
+                                  level,
+                                  *stream(s)->inlet(),
+                                  *_outlets[s],
+                                  s,
+                                  ipaddress,
+                                  max_size, eb_depth,
+                                  slowEb,
+                                  nshards,
+                                  new VmonEb(src,32,eb_depth,(1<<23),max_size));
+      eb->key_index(true);
+      eb->peek(true);
+      eb->multiplexer(ServerManager::UseEpoll);
+      _inlet_wires[s] = eb;
+    }
+    else {
+      SegEventBuilder* eb = new SegEventBuilder(src,
                _xtcType,
                level,
                *stream(s)->inlet(),
@@ -43,6 +63,11 @@ EventStreams::EventStreams(PartitionMember& cmgr,
                max_size, eb_depth,
                slowEb,
                new VmonEb(src,32,eb_depth,(1<<23),max_size));
+      eb->key_index(true);  // deep pending queues with slow contributors
+      eb->peek(true);       // receive contributions directly into their event
+      eb->multiplexer(ServerManager::UseEpoll);  // one server per segment
+      _inlet_wires[s] = eb;
+    }
 
     (new VmonServerAppliance(src))->connect(stream(s)->inlet());
   }
@@ -55,5 +80,3 @@ EventStreams::~EventStreams()
     delete _outlets[s];
   }
 }
-
-
@@ -12,6 +12,7 @@ namespace Pds {
 
 //#ifdef BUILD_LARGE_STREAM_BUFFER
 //    enum { netbufdepth = 16 };
+    enum { netbatchdepth = 32 };  // contributions per batched receive
 //#else
 //    enum { netbufdepth = 8 };
 //#endif
@@ -24,7 +25,8 @@ namespace Pds {
      int      slowEb,
      unsigned max_size      = MaxSize,
      unsigned net_buf_depth = netbufdepth,
-     unsigned eb_depth      = EbDepth);
+     unsigned eb_depth      = EbDepth,
+     unsigned nshards       = 0);   // builder threads per stream (0 = not split)
     virtual ~EventStreams();
   };
 
@@ -10,6 +10,7 @@
 #include "pds/utility/InletWire.hh"
 #include "pds/utility/InletWireServer.hh"
 #include "pds/utility/InletWireIns.hh"
+#include "pds/utility/Eb.hh"
 #include "pds/utility/EvrServer.hh"
 #include "pds/utility/TagServer.hh"
 #include "pds/utility/ToEventWireScheduler.hh"
@@ -71,6 +72,8 @@ bool SegmentLevel::attach()
         vname = DetInfo::name(static_cast<const DetInfo&>(_settings.sources().front()));
       if (_settings.is_triggered())
 	_header.setTrigger(_settings.module(),_settings.channel());
+      if (_settings.datagram_pages() != PoolPolicy::Normal)
+        Eb::datagram_policy(_settings.datagram_pages(), true);
 
       if (_settings.has_fiducial()) {
         _streams = new TaggedStreams(*this,
@@ -2,6 +2,7 @@
 
 #include "pds/mon/MonCds.hh"
 #include "pds/mon/MonGroup.hh"
+#include "pds/mon/MonEntry.hh"
 #include "pds/service/Semaphore.hh"
 
 static const unsigned short Step = 16;
@@ -109,6 +110,15 @@ MonEntry* MonCds::entry(int signature)
     return 0;
 }
 
+void MonCds::merge() const
+{
+  for (unsigned short g=0; g<ngroups(); g++) {
+    const MonGroup* group = _groups[g];
+    for (unsigned short e=0; e<group->nentries(); e++)
+      group->entry(e)->merge();
+  }
+}
+
 void MonCds::reset()
 {
   if (_groups) {
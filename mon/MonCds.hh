@@ -33,6 +33,9 @@ namespace Pds {
     void reset();
     void showentries() const;
 
+    //  Adds the fills of the entries' shards to their payloads
+    void merge() const;
+
     //  serialize the description
     unsigned description(iovec*) const;
 
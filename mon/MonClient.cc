@@ -9,6 +9,7 @@
 #include "pds/mon/MonDescEntry.hh"
 #include "pds/mon/MonConsumerClient.hh"
 #include "pds/mon/MonEntryFactory.hh"
+#include "pds/mon/MonDelta.hh"
 #include "pds/utility/Mtu.hh"
 
 #include <stdlib.h>
@@ -30,7 +31,10 @@ MonClient::MonClient(MonConsumerClient& consumer,
   _desc   (0),
   _descsize(0),
   _maxdescsize(0),
-  _usage()
+  _usage(),
+  _delta  (false),
+  _load   (0),
+  _maxloadsize(0)
 {
   _iovreq[0].iov_base = &_request;
   _iovreq[0].iov_len = sizeof(_request);
@@ -51,7 +55,10 @@ MonClient::MonClient(MonConsumerClient& consumer,
   _desc   (0),
   _descsize(0),
   _maxdescsize(0),
-  _usage()
+  _usage(),
+  _delta  (false),
+  _load   (0),
+  _maxloadsize(0)
 {
   _iovreq[0].iov_base = &_request;
   _iovreq[0].iov_len = sizeof(_request);
@@ -67,6 +74,8 @@ MonClient::~MonClient()
     delete [] _iovload;
   if (_desc)
     delete [] _desc;
+  if (_load)
+    delete [] _load;
 }
 
 MonSocket& MonClient::socket() { return _socket; }
@@ -98,7 +107,7 @@ int MonClient::askdesc()
 int MonClient::askload()
 {
   if (_usage.ismodified()) payload();
-  _request.type(MonMessage::PayloadReq);
+  _request.type(_delta ? MonMessage::PayloadDeltaReq : MonMessage::PayloadReq);
   _request.payload(_iovreq[1].iov_len);
   return _socket.writev(_iovreq, 2);
 }
@@ -127,6 +136,9 @@ int MonClient::processIo()
   case MonMessage::Payload:
     read_payload();
     break;
+  case MonMessage::PayloadDelta:
+    read_delta(_reply.payload());
+    break;
   default:
     break;
   }
@@ -157,6 +169,8 @@ const MonCds& MonClient::cds() const {return *_cds;}
 const Ins& MonClient::dst() const {return _dst;}
 void MonClient::dst(const Ins& d) { _dst=d; }
 bool MonClient::needspayload() const {return _usage.used();}
+void MonClient::delta(bool d) { _delta=d; }
+bool MonClient::delta() const { return _delta; }
 
 void MonClient::payload()
 {
@@ -177,6 +191,28 @@ void MonClient::read_payload()
   _consumer.process(*this, MonConsumerClient::Payload);
 }
 
+void MonClient::read_delta(int size)
+{
+  if (unsigned(size) > _maxloadsize) {
+    delete [] _load;
+    _load = new char[size];
+    _maxloadsize = size;
+  }
+  if (_socket.read(_load, size) < 0) {
+    printf("payload error : reason %s\n", strerror(errno));
+  }
+  else {
+    //  The entries follow in the order requested
+    const char* p   = _load;
+    const char* end = _load+size;
+    for (unsigned short u=0; p && u<_usage.used(); u++)
+      p = MonDelta::apply(p, end, _iovload[u]);
+    if (!p)
+      printf("payload error : delta doesn't match entries\n");
+  }
+  _consumer.process(*this, MonConsumerClient::Payload);
+}
+
 void MonClient::read_description(int descsize)
 {
   _descsize = descsize;
@@ -39,8 +39,14 @@ namespace Pds {
     int askdesc();
     int askload();
 
+    //  Ask for only what changed in the payload since the last reply.
+    //  The client's entries must not be modified in between.
+    void delta(bool);
+    bool delta() const;
+
     void read_description(int size);
     void read_payload();
+    void read_delta(int size);
 
     MonCds& cds();
     const MonCds& cds() const;
@@ -73,6 +79,9 @@ namespace Pds {
     unsigned short _descsize;
     unsigned short _maxdescsize;
     MonUsage _usage;
+    bool _delta;
+    char* _load;
+    unsigned _maxloadsize;
   };
 };
 
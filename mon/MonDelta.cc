@@ -0,0 +1,125 @@
+#include <string.h>
+#include <sys/uio.h>
+
+#include "pds/mon/MonDelta.hh"
+
+using namespace Pds;
+
+static inline unsigned pad(unsigned n) { return (n+7)&~7; }
+
+MonDelta::MonDelta() : _size(0) {}
+
+MonDelta::~MonDelta() {}
+
+void MonDelta::reset() { _copies.clear(); }
+
+void MonDelta::retain(const int* signatures, unsigned n)
+{
+  std::map<int, std::vector<char> >::iterator it = _copies.begin();
+  while (it != _copies.end()) {
+    unsigned i=0;
+    while (i<n && signatures[i]!=it->first) i++;
+    if (i==n)
+      _copies.erase(it++);
+    else
+      ++it;
+  }
+}
+
+void MonDelta::clear() { _size = 0; }
+
+const char* MonDelta::data() const { return _buffer.empty() ? 0 : &_buffer[0]; }
+
+unsigned MonDelta::size() const { return _size; }
+
+char* MonDelta::_append(unsigned size)
+{
+  if (_size+size > _buffer.size())
+    _buffer.resize(2*(_size+size));
+  char* p = &_buffer[_size];
+  _size += size;
+  return p;
+}
+
+void MonDelta::empty()
+{
+  unsigned* hdr = reinterpret_cast<unsigned*>(_append(2*sizeof(unsigned)));
+  hdr[0] = 0;
+  hdr[1] = 0;
+}
+
+void MonDelta::encode(int signature, const iovec& payload)
+{
+  const char* cur  = static_cast<const char*>(payload.iov_base);
+  unsigned    size = payload.iov_len;
+
+  std::vector<char>& copy = _copies[signature];
+  bool whole = copy.size() != size;
+  if (whole)
+    copy.resize(size);
+  char* prev = size ? &copy[0] : 0;
+
+  unsigned hdroff = _size;
+  _append(2*sizeof(unsigned));
+  unsigned nruns = 0;
+
+  unsigned offset = 0;
+  while (offset < size) {
+    //  Find the next changed block, and the end of the run of changed blocks
+    unsigned begin = offset;
+    if (!whole) {
+      while (begin < size) {
+        unsigned len = size-begin < unsigned(BlockSize) ? size-begin : unsigned(BlockSize);
+        if (memcmp(cur+begin, prev+begin, len)) break;
+        begin += len;
+      }
+      if (begin == size) break;
+    }
+    unsigned end = begin;
+    while (end < size) {
+      unsigned len = size-end < unsigned(BlockSize) ? size-end : unsigned(BlockSize);
+      if (!whole && !memcmp(cur+end, prev+end, len)) break;
+      end += len;
+    }
+
+    unsigned len = end-begin;
+    unsigned* run = reinterpret_cast<unsigned*>(_append(2*sizeof(unsigned)+pad(len)));
+    run[0] = begin;
+    run[1] = len;
+    memcpy(run+2, cur+begin, len);
+    memcpy(prev+begin, cur+begin, len);
+    nruns++;
+    offset = end;
+  }
+
+  unsigned* hdr = reinterpret_cast<unsigned*>(&_buffer[hdroff]);
+  hdr[0] = nruns;
+  hdr[1] = size;
+}
+
+const char* MonDelta::apply(const char* p, const char* end, const iovec& payload)
+{
+  if (p + 2*sizeof(unsigned) > end)
+    return 0;
+  const unsigned* hdr = reinterpret_cast<const unsigned*>(p);
+  unsigned nruns = hdr[0];
+  unsigned size  = hdr[1];
+  p += 2*sizeof(unsigned);
+  if (nruns && size != payload.iov_len)
+    return 0;
+
+  char* dst = static_cast<char*>(payload.iov_base);
+  for(unsigned r=0; r<nruns; r++) {
+    if (p + 2*sizeof(unsigned) > end)
+      return 0;
+    const unsigned* run = reinterpret_cast<const unsigned*>(p);
+    unsigned offset = run[0];
+    unsigned len    = run[1];
+    p += 2*sizeof(unsigned);
+    if (offset+len > size || p + pad(len) > end)
+      return 0;
+    memcpy(dst+offset, p, len);
+    p += pad(len);
+  }
+  return p;
+}
@@ -0,0 +1,60 @@
+#ifndef Pds_MonDELTA_HH
+#define Pds_MonDELTA_HH
+
+#include <map>
+#include <vector>
+
+class iovec;
+
+namespace Pds {
+
+  //
+  //  Encodes the payloads of entries as the blocks which changed since
+  //  they were last sent to a client.  The server keeps a copy of each
+  //  payload as sent, and compares it block by block with the current
+  //  one; the client applies the changed runs to its own copy.  An entry
+  //  without a copy, or whose size changed, is sent whole.
+  //
+  //  The encoding of each entry is
+  //
+  //    unsigned nruns, size;                       // size of the payload
+  //    nruns x { unsigned offset, length; char data[length]; }
+  //
+  //  with the data padded to 8 bytes.
+  //
+  class MonDelta {
+  public:
+    enum { BlockSize = 64 };
+    MonDelta();
+    ~MonDelta();
+
+    //  Forget all copies; the next payloads are sent whole
+    void reset();
+    //  Forget the copies of entries other than these
+    void retain(const int* signatures, unsigned n);
+
+    //  Start a new message
+    void clear();
+    //  Append the changes to an entry's payload
+    void encode(int signature, const iovec& payload);
+    //  Append an entry with no payload
+    void empty();
+
+    const char* data() const;
+    unsigned    size() const;
+
+    //  Apply one encoded entry to the client's payload.  Returns the next
+    //  entry, or 0 if the encoding doesn't fit the payload.
+    static const char* apply(const char* encoded, const char* end, const iovec& payload);
+
+  private:
+    char* _append(unsigned size);
+
+  private:
+    std::map<int, std::vector<char> > _copies;
+    std::vector<char>                 _buffer;
+    unsigned                          _size;
+  };
+};
+
+#endif
@@ -8,11 +8,14 @@ using namespace Pds;
 
 MonEntry::MonEntry() : 
   _payloadsize(0),
-  _payload(0)
+  _payload(0),
+  _element(MonShards::Double),
+  _shards(0)
 {}
 
 MonEntry::~MonEntry()
 {
+  delete _shards;
   delete [] _payload;  
 }
 
@@ -34,11 +37,16 @@ void MonEntry::reset()
   time(ClockTime(0));
 }
 
-void* MonEntry::allocate(unsigned size)
+void* MonEntry::allocate(unsigned size, MonShards::Element element)
 {
   if (_payload)
     delete [] _payload;  
 
+  //  The shards no longer match the payload
+  delete _shards;
+  _shards  = 0;
+  _element = element;
+
   _payloadsize = sizeof(unsigned long long)+size;
   _payload = new unsigned long long[(_payloadsize>>3)+1];
 
@@ -63,3 +71,29 @@ void MonEntry::time(const ClockTime& t)
   *_payload = *(reinterpret_cast<const unsigned long long*>(&t));
 }
 
+
+MonShard& MonEntry::shard()
+{
+  MonShards* shards = _shards;
+  if (!shards) {
+    unsigned esize = _element==MonShards::Double ? sizeof(double) : sizeof(float);
+    shards = new MonShards((_payloadsize-sizeof(unsigned long long))/esize, _element);
+    if (!__sync_bool_compare_and_swap(&_shards, (MonShards*)0, shards)) {
+      delete shards;
+      shards = _shards;
+    }
+  }
+  return shards->local();
+}
+
+void MonEntry::merge() const
+{
+  if (!_shards) return;
+
+  unsigned long long latest = _shards->merge(_payload+1);
+  if (latest) {
+    ClockTime t(unsigned(latest>>32), unsigned(latest));
+    if (t > time())
+      memcpy(_payload, &t, sizeof(t));
+  }
+}
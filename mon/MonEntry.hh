@@ -1,6 +1,8 @@
 #ifndef Pds_MonENTRY_HH
 #define Pds_MonENTRY_HH
 
+#include "pds/mon/MonShard.hh"
+
 class iovec;
 
 namespace Pds {
@@ -26,12 +28,21 @@ namespace Pds {
 
     void reset();
 
+    //  The calling thread's shard, for fills from threads other than the
+    //  one serving the payload; see MonShard.  It is valid until the
+    //  entry's parameters change.
+    MonShard& shard();
+    //  Adds the fills of the shards to the payload; called by the server
+    void merge() const;
+
   protected:
-    void* allocate(unsigned size);
+    void* allocate(unsigned size, MonShards::Element element=MonShards::Double);
 
   private:
     unsigned _payloadsize;
     unsigned long long* _payload;
+    MonShards::Element _element;
+    MonShards* volatile _shards;
   };
 };
 
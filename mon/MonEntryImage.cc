@@ -39,7 +39,7 @@ void MonEntryImage::params(const MonDescImage& desc)
 
 void MonEntryImage::build(unsigned nbinsx, unsigned nbinsy)
 {
-  _y = static_cast<unsigned*>(allocate(sizeof(unsigned)*SIZE(nbinsx,nbinsy)));
+  _y = static_cast<unsigned*>(allocate(sizeof(unsigned)*SIZE(nbinsx,nbinsy), MonShards::Unsigned));
 }
 
 const MonDescImage& MonEntryImage::desc() const {return _desc;}
@@ -38,6 +38,10 @@ namespace Pds {
     void   info(double, Info);
     void   addinfo(double, Info);
 
+    //  As above, through the calling thread's shard (see shard())
+    void   addy   (double y, unsigned bin, MonShard&);
+    void   addinfo(double, Info, MonShard&);
+
     void setto(const MonEntryProf& entry);
     void setto(const MonEntryProf& curr, const MonEntryProf& prev);
 
@@ -110,6 +114,16 @@ namespace Pds {
   inline double MonEntryProf::info(Info i) const { return *(_nentries+_desc.nbins()+int(i)); }
   inline void   MonEntryProf::info(double y,Info i) { *(_nentries+_desc.nbins()+int(i)) = y; }
   inline void   MonEntryProf::addinfo(double y,Info i) { *(_nentries+_desc.nbins()+int(i)) += y; }
+
+  inline void MonEntryProf::addy(double y, unsigned bin, MonShard& s) 
+  {
+    unsigned nbins = _desc.nbins();
+    s.add(y  , bin);
+    s.add(y*y, bin+nbins);
+    s.add(1  , bin+2*nbins);
+  }
+
+  inline void   MonEntryProf::addinfo(double y,Info i,MonShard& s) { s.add(y, 3*_desc.nbins()+int(i)); }
 };
 
 #endif
@@ -24,6 +24,9 @@ namespace Pds {
 
     void   addvalue(double);
     void   addvalue(double,unsigned);
+    //  As above, through the calling thread's shard (see shard())
+    void   addvalue(double,MonShard&);
+    void   addvalue(double,unsigned,MonShard&);
     void   setvalue(double);
     void   setvalue(double,unsigned);
     void   setvalues(const double*);
@@ -48,6 +51,10 @@ namespace Pds {
 
   inline void   MonEntryScalar::addvalue(double v,unsigned i) { _y[i]+=v; }
 
+  inline void   MonEntryScalar::addvalue(double v,MonShard& s) { s.add(v,0); }
+
+  inline void   MonEntryScalar::addvalue(double v,unsigned i,MonShard& s) { s.add(v,i); }
+
   inline void   MonEntryScalar::setvalue(double v) { _y[0]=v; }
 
   inline void   MonEntryScalar::setvalue(double v,unsigned i) { _y[i]=v; }
@@ -30,6 +30,10 @@ namespace Pds {
     void   info(double y, Info);
     void   addinfo(double y, Info);
 
+    //  As above, through the calling thread's shard (see shard())
+    void   addcontent(double y, unsigned bin, MonShard&);
+    void   addinfo   (double y, Info, MonShard&);
+
     void setto(const MonEntryTH1F& entry);
     void setto(const MonEntryTH1F& curr, const MonEntryTH1F& prev);
     void stats();
@@ -56,6 +60,9 @@ namespace Pds {
   inline double MonEntryTH1F::info   (Info i) const   {return *(_y+_desc.nbins()+int(i));}
   inline void   MonEntryTH1F::info   (double y, Info i) {*(_y+_desc.nbins()+int(i)) = y;}
   inline void   MonEntryTH1F::addinfo(double y, Info i) {*(_y+_desc.nbins()+int(i)) += y;}
+
+  inline void   MonEntryTH1F::addcontent(double y, unsigned bin, MonShard& s) { s.add(y, bin); }
+  inline void   MonEntryTH1F::addinfo   (double y, Info i, MonShard& s) { s.add(y, _desc.nbins()+int(i)); }
 };
 
 #endif
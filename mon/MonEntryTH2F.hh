@@ -29,6 +29,10 @@ namespace Pds {
     void  info   (float y, Info);
     void  addinfo(float y, Info);
 
+    //  As above, through the calling thread's shard (see shard())
+    void  addcontent(float y, unsigned binx, unsigned biny, MonShard&);
+    void  addinfo   (float y, Info, MonShard&);
+
     void setto(const MonEntryTH2F& entry);
     void setto(const MonEntryTH2F& curr, const MonEntryTH2F& prev);
     void stats();
@@ -76,6 +80,15 @@ namespace Pds {
   {
     *(_y+_desc.nbinsx()*_desc.nbinsy()+int(i)) += y;
   }
+
+  inline void MonEntryTH2F::addcontent(float y, unsigned binx, unsigned biny, MonShard& s) 
+  {
+    s.add(y, binx+biny*_desc.nbinsx());
+  }
+  inline void MonEntryTH2F::addinfo(float y, Info i, MonShard& s) 
+  {
+    s.add(y, _desc.nbinsx()*_desc.nbinsy()+int(i));
+  }
 };
 
 #endif
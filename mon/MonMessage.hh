@@ -16,7 +16,9 @@ namespace Pds {
 	      DescriptionReq, 
 	      Description, 
 	      PayloadReq, 
-	      Payload};
+	      Payload,
+	      PayloadDeltaReq,
+	      PayloadDelta};
 
     MonMessage(Type type, unsigned payload=0);
     MonMessage(const Src& src, Type type, unsigned payload=0);
@@ -86,6 +86,7 @@ void MonServer::reply(MonMessage::Type type,int cnt)
   _reply.type(type);
   _reply.payload(_iovreply+1, cnt-1);
   _cds.payload_sem().take();
+  _cds.merge();
   int bytessent = _socket.writev(_iovreply, cnt);
   _cds.payload_sem().give();
   if (bytessent < 0) {
@@ -101,6 +102,9 @@ void MonServer::description()
   iovec* iov = _iovreply+1;
   unsigned element = _cds.description(iov);
 
+  //  The client rebuilds its entries
+  _delta.reset();
+
   reply(MonMessage::Description,element+1);
 }
 
@@ -125,6 +129,9 @@ void MonServer::payload(unsigned loadsize)
 
   _socket.read(_signatures, loadsize);
 
+  //  The client's copies no longer match ours
+  _delta.reset();
+
   unsigned used = loadsize>>2;
   iovec* iov = _iovreply+1;
   const int* signatures = _signatures;
@@ -139,3 +146,40 @@ void MonServer::payload(unsigned loadsize)
   reply(MonMessage::Payload,used+1);
 }
 
+void MonServer::delta(unsigned loadsize)
+{
+  adjust();
+
+  _socket.read(_signatures, loadsize);
+
+  unsigned used = loadsize>>2;
+  _delta.retain(_signatures, used);
+  _delta.clear();
+
+  _cds.payload_sem().take();
+  _cds.merge();
+  const int* signatures = _signatures;
+  for (unsigned u=0; u<used; u++, signatures++) {
+    const MonEntry* entry = _cds.entry(*signatures); 
+    if (entry) {
+      iovec iov;
+      entry->payload(iov);
+      _delta.encode(*signatures, iov);
+      _usage.use(*signatures);
+    }
+    else
+      _delta.empty();
+  }
+  _cds.payload_sem().give();
+
+  _reply.type(MonMessage::PayloadDelta);
+  _reply.payload(_delta.size());
+  iovec iov[2];
+  iov[0] = _iovreply[0];
+  iov[1].iov_base = const_cast<char*>(_delta.data());
+  iov[1].iov_len  = _delta.size();
+  if (_socket.writev(iov, 2) < 0) {
+    printf("*** MonServer::delta send error socket [%d]: %s\n", 
+	   _socket.socket(), strerror(errno));
+  }
+}
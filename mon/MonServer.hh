@@ -5,6 +5,7 @@
 
 #include "pds/mon/MonSocket.hh"
 #include "pds/mon/MonMessage.hh"
+#include "pds/mon/MonDelta.hh"
 
 namespace Pds {
 
@@ -29,6 +30,8 @@ namespace Pds {
     void description();
     void payload();
     void payload(unsigned size);
+    //  As payload(size), but only what changed since the last reply
+    void delta  (unsigned size);
 
   private:
     void adjust();
@@ -44,6 +47,7 @@ namespace Pds {
     int* _signatures;
     unsigned _sigcnt;
     bool _enabled;
+    MonDelta _delta;
   };
 };
 
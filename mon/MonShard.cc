@@ -0,0 +1,112 @@
+#include "pds/mon/MonShard.hh"
+#include "pdsdata/xtc/ClockTime.hh"
+
+#include <string.h>
+
+using namespace Pds;
+
+//  Each thread which fills a shard is numbered once
+static unsigned     _nthreads = 0;
+static __thread int _thread   = -1;
+
+MonShard::MonShard(unsigned elements, bool shared) :
+  _y     (new double[elements]),
+  _merged(new double[elements]),
+  _latest(0),
+  _shared(shared)
+{
+  for(unsigned i=0; i<elements; i++)
+    _y[i] = _merged[i] = 0;
+}
+
+MonShard::~MonShard()
+{
+  delete[] _y;
+  delete[] _merged;
+}
+
+void MonShard::time(const ClockTime& t)
+{
+  unsigned long long v = (static_cast<unsigned long long>(t.seconds())<<32) | t.nanoseconds();
+  if (_shared)
+    _time(v);
+  else
+    _latest = v;
+}
+
+void MonShard::_add(double y, unsigned element)
+{
+  union { double d; unsigned long long u; } o, n;
+  volatile unsigned long long* p = reinterpret_cast<volatile unsigned long long*>(&_y[element]);
+  do {
+    o.u  = *p;
+    n.d  = o.d + y;
+  } while(!__sync_bool_compare_and_swap(p, o.u, n.u));
+}
+
+void MonShard::_time(unsigned long long t)
+{
+  unsigned long long o;
+  do {
+    o = _latest;
+    if (o >= t) return;
+  } while(!__sync_bool_compare_and_swap(&_latest, o, t));
+}
+
+MonShards::MonShards(unsigned elements, Element element) :
+  _elements(elements),
+  _element (element)
+{
+  for(unsigned i=0; i<MaxThreads; i++)
+    _shards[i] = 0;
+}
+
+MonShards::~MonShards()
+{
+  for(unsigned i=0; i<MaxThreads; i++)
+    delete _shards[i];
+}
+
+MonShard& MonShards::local()
+{
+  if (_thread < 0)
+    _thread = __sync_fetch_and_add(&_nthreads, 1);
+
+  unsigned s = unsigned(_thread) < unsigned(MaxThreads) ? _thread : MaxThreads-1;
+  MonShard* shard = _shards[s];
+  if (!shard) {
+    shard = new MonShard(_elements, s==MaxThreads-1);
+    if (!__sync_bool_compare_and_swap(&_shards[s], (MonShard*)0, shard)) {
+      delete shard;
+      shard = _shards[s];
+    }
+  }
+  return *shard;
+}
+
+unsigned long long MonShards::merge(void* values)
+{
+  unsigned long long latest = 0;
+  for(unsigned s=0; s<MaxThreads; s++) {
+    MonShard* shard = _shards[s];
+    if (!shard) continue;
+
+    //  Only the differences are added, so that the entry may be reset or
+    //  filled directly in between
+    for(unsigned i=0; i<_elements; i++) {
+      double y  = shard->_y[i];
+      double dy = y - shard->_merged[i];
+      if (dy == 0) continue;
+      shard->_merged[i] = y;
+      switch(_element) {
+      case Double  : static_cast<double  *>(values)[i] += dy; break;
+      case Float   : static_cast<float   *>(values)[i] += dy; break;
+      case Unsigned: static_cast<unsigned*>(values)[i] += static_cast<int>(dy); break;
+      }
+    }
+
+    unsigned long long t = shard->_latest;
+    if (t > latest) latest = t;
+  }
+  return latest;
+}
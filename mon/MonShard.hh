@@ -0,0 +1,69 @@
+#ifndef Pds_MonSHARD_HH
+#define Pds_MonSHARD_HH
+
+namespace Pds {
+
+  class ClockTime;
+
+  //
+  //  One thread's share of the fills of a MonEntry, laid out as the
+  //  entry's values.  Only the thread which owns it writes to it, with
+  //  plain stores; the serving thread adds what changed since it last
+  //  looked to the entry's payload (MonShards::merge).  Neither waits on
+  //  the other.  Threads beyond MonShards::MaxThreads share a last shard,
+  //  which is then written with compare-and-swap.
+  //
+  class MonShard {
+  public:
+    MonShard(unsigned elements, bool shared);
+    ~MonShard();
+
+    void add (double y, unsigned element);
+    void time(const ClockTime& t);
+
+  private:
+    void _add (double y, unsigned element);
+    void _time(unsigned long long t);
+
+  private:
+    friend class MonShards;
+    volatile double*            _y;
+    double*                     _merged;  // _y as of the last merge
+    volatile unsigned long long _latest;  // seconds<<32 | nanoseconds
+    bool                        _shared;
+  };
+
+  //
+  //  The shards of one entry, created as threads first fill it.
+  //
+  class MonShards {
+  public:
+    enum Element { Double, Float, Unsigned };
+    enum { MaxThreads = 64 };
+
+    MonShards(unsigned elements, Element);
+    ~MonShards();
+
+    //  The calling thread's shard
+    MonShard& local();
+
+    //  Adds the fills since the last merge to "values", and returns the
+    //  time of the latest fill (seconds<<32 | nanoseconds), or 0
+    unsigned long long merge(void* values);
+
+  private:
+    unsigned            _elements;
+    Element             _element;
+    MonShard* volatile  _shards[MaxThreads];
+  };
+
+  inline void MonShard::add(double y, unsigned element)
+  {
+    if (_shared)
+      _add(y, element);
+    else
+      _y[element] += y;
+  }
+};
+
+#endif
@@ -43,6 +43,9 @@ int MonStreamServer::processIo()
   case MonMessage::PayloadReq:
     payload(loadsize);
     break;
+  case MonMessage::PayloadDeltaReq:
+    delta(loadsize);
+    break;
   default:
     //    reply(MonMessage::NoOp,1);
     break;
@@ -1,4 +1,15 @@
 libnames := mon
 
-libsrcs_mon := $(wildcard *.cc)
-libincs_mon := pdsdata/include
\ No newline at end of file
+libsrcs_mon := $(filter-out mondeltabench.cc monshardbench.cc,$(wildcard *.cc))
+libincs_mon := pdsdata/include
+
+tgtnames := mondeltabench monshardbench
+tgtsrcs_mondeltabench := mondeltabench.cc
+tgtincs_mondeltabench := pdsdata/include
+tgtlibs_mondeltabench := pds/mon pds/service pdsdata/xtcdata
+tgtslib_mondeltabench := $(USRLIBDIR)/rt $(USRLIBDIR)/pthread
+
+tgtsrcs_monshardbench := monshardbench.cc
+tgtincs_monshardbench := pdsdata/include
+tgtlibs_monshardbench := pds/mon pds/service pdsdata/xtcdata
+tgtslib_monshardbench := $(USRLIBDIR)/rt $(USRLIBDIR)/pthread
@@ -0,0 +1,151 @@
+//
+//  Bytes sent per poll by MonServer for a monitoring setup like that of the
+//  DAQ (vmon), in full and as deltas.  Events fill a few bins of each
+//  histogram between polls; the deltas are applied to a client's copies
+//  and checked against the server's entries.
+//
+#include "pds/mon/MonDelta.hh"
+#include "pds/mon/MonEntryTH1F.hh"
+#include "pds/mon/MonEntryTH2F.hh"
+#include "pds/mon/MonEntryImage.hh"
+#include "pds/mon/MonEntryScalar.hh"
+#include "pds/mon/MonDescTH1F.hh"
+#include "pds/mon/MonDescTH2F.hh"
+#include "pds/mon/MonDescImage.hh"
+#include "pds/mon/MonDescScalar.hh"
+#include "pdsdata/xtc/ClockTime.hh"
+
+#include <sys/uio.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <vector>
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+static void usage(const char* p)
+{
+  printf("Usage: %s [-n <polls>] [-e <events per poll>] [-1 <TH1Fs>] [-2 <TH2Fs>] [-i <images>]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned npolls  = 100;
+  unsigned nevents = 120;  // 120 Hz polled at 1 Hz
+  unsigned nth1f   = 64;
+  unsigned nth2f   = 8;
+  unsigned nimage  = 2;
+
+  int c;
+  while ((c = getopt(argc, argv, "n:e:1:2:i:h")) != -1) {
+    switch(c) {
+    case 'n': npolls  = strtoul(optarg,NULL,0); break;
+    case 'e': nevents = strtoul(optarg,NULL,0); break;
+    case '1': nth1f   = strtoul(optarg,NULL,0); break;
+    case '2': nth2f   = strtoul(optarg,NULL,0); break;
+    case 'i': nimage  = strtoul(optarg,NULL,0); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  //  Timing and size histograms, correlation plots, binned camera images
+  //  and counters
+  std::vector<MonEntryTH1F*>   th1f;
+  std::vector<MonEntryTH2F*>   th2f;
+  std::vector<MonEntryImage*>  image;
+  std::vector<MonEntry*>       entries;
+  for(unsigned i=0; i<nth1f; i++) {
+    th1f.push_back(new MonEntryTH1F(MonDescTH1F("th1f","x","y",1000,0.,1000.)));
+    entries.push_back(th1f.back());
+  }
+  for(unsigned i=0; i<nth2f; i++) {
+    th2f.push_back(new MonEntryTH2F(MonDescTH2F("th2f","x","y",128,0.,128.,128,0.,128.)));
+    entries.push_back(th2f.back());
+  }
+  for(unsigned i=0; i<nimage; i++) {
+    image.push_back(new MonEntryImage(MonDescImage("image",256,256,4,4)));
+    entries.push_back(image.back());
+  }
+  MonEntryScalar* scalar = new MonEntryScalar(MonDescScalar("events"));
+  entries.push_back(scalar);
+
+  //  The client's copies
+  std::vector< std::vector<char> > copies(entries.size());
+  std::vector<iovec> iovs(entries.size());
+  unsigned full = 0;
+  for(unsigned i=0; i<entries.size(); i++) {
+    entries[i]->payload(iovs[i]);
+    copies[i].resize(iovs[i].iov_len);
+    full += iovs[i].iov_len;
+  }
+
+  MonDelta delta;
+  unsigned long long fullBytes = 0, deltaBytes = 0;
+  double tencode = 0;
+  bool lexact = true;
+  unsigned t = 0;
+  for(unsigned p=0; p<npolls; p++) {
+    for(unsigned e=0; e<nevents; e++, t++) {
+      ClockTime clk(t/120, (t%120)*8333333);
+      for(unsigned i=0; i<th1f.size(); i++) {
+        //  a narrow peak, as of a latency
+        th1f[i]->addcontent(1., unsigned(100 + (random()%32)));
+        th1f[i]->time(clk);
+      }
+      for(unsigned i=0; i<th2f.size(); i++) {
+        th2f[i]->addcontent(1., 60+random()%8, 60+random()%8);
+        th2f[i]->time(clk);
+      }
+      for(unsigned i=0; i<image.size(); i++) {
+        //  a beam spot
+        for(unsigned k=0; k<16; k++)
+          image[i]->addcontent(1, 120+random()%16, 120+random()%16);
+        image[i]->time(clk);
+      }
+      scalar->addvalue(1.);
+      scalar->time(clk);
+    }
+
+    double t0 = now();
+    delta.clear();
+    for(unsigned i=0; i<entries.size(); i++)
+      delta.encode(i, iovs[i]);
+    tencode += now()-t0;
+
+    fullBytes  += full;
+    deltaBytes += delta.size();
+
+    const char* d   = delta.data();
+    const char* end = d+delta.size();
+    for(unsigned i=0; i<entries.size(); i++) {
+      iovec iov;
+      iov.iov_base = &copies[i][0];
+      iov.iov_len  = copies[i].size();
+      if (!(d = MonDelta::apply(d, end, iov))) {
+        printf("delta doesn't apply to entry %u\n", i);
+        return 1;
+      }
+      lexact &= memcmp(&copies[i][0], iovs[i].iov_base, iovs[i].iov_len)==0;
+    }
+  }
+
+  printf("%u entries (%u TH1F, %u TH2F, %u Image, 1 Scalar), %u events per poll, %u polls\n",
+         unsigned(entries.size()), nth1f, nth2f, nimage, nevents, npolls);
+  printf("full  : %10.1f kB/poll\n", 1.e-3*double(fullBytes)/double(npolls));
+  printf("delta : %10.1f kB/poll (%.1f%% of full), encoded in %.1f us/poll\n",
+         1.e-3*double(deltaBytes)/double(npolls),
+         100.*double(deltaBytes)/double(fullBytes),
+         1.e6*tencode/double(npolls));
+  printf("client copies %s\n", lexact ? "identical" : "DIFFER");
+
+  return lexact ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+//
+//  Cost of a fill of a MonEntryTH1F from several threads while a server
+//  thread merges it: through per-thread shards, and directly under a
+//  lock as the entries were filled before.  The totals are checked
+//  against the number of fills.
+//
+#include "pds/mon/MonEntryTH1F.hh"
+#include "pds/mon/MonDescTH1F.hh"
+#include "pdsdata/xtc/ClockTime.hh"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+static MonEntryTH1F*   _entry;
+static pthread_mutex_t _lock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned        _fills;
+static bool            _sharded;
+static volatile bool   _done;
+
+static void* fill(void* arg)
+{
+  unsigned bins = _entry->desc().nbins();
+  unsigned bin  = reinterpret_cast<long>(arg);
+  for(unsigned i=0; i<_fills; i++, bin++) {
+    if (bin >= bins) bin = 0;
+    if (_sharded) {
+      MonShard& shard = _entry->shard();
+      _entry->addcontent(1., bin, shard);
+      shard.time(ClockTime(i,0));
+    }
+    else {
+      pthread_mutex_lock(&_lock);
+      _entry->addcontent(1., bin);
+      _entry->time(ClockTime(i,0));
+      pthread_mutex_unlock(&_lock);
+    }
+  }
+  return 0;
+}
+
+//  The server, polling every millisecond
+static void* serve(void*)
+{
+  timespec ts = { 0, 1000000 };
+  do {
+    nanosleep(&ts, 0);
+    pthread_mutex_lock(&_lock);
+    _entry->merge();
+    pthread_mutex_unlock(&_lock);
+  } while(!_done);
+  return 0;
+}
+
+static void usage(const char* p)
+{
+  printf("Usage: %s [-n <fills per thread>] [-t <threads>] [-b <bins>]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned nthreads = 4;
+  unsigned nbins    = 100;
+  _fills = 10000000;
+
+  int c;
+  while ((c = getopt(argc, argv, "n:t:b:h")) != -1) {
+    switch(c) {
+    case 'n': _fills   = strtoul(optarg,NULL,0); break;
+    case 't': nthreads = strtoul(optarg,NULL,0); break;
+    case 'b': nbins    = strtoul(optarg,NULL,0); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  bool lexact = true;
+  for(unsigned m=0; m<2; m++) {
+    _sharded = (m==1);
+    _entry   = new MonEntryTH1F(MonDescTH1F("bench","x","y",nbins,0.,float(nbins)));
+    _done    = false;
+
+    pthread_t server;
+    pthread_create(&server, 0, serve, 0);
+
+    double t0 = now();
+    pthread_t* threads = new pthread_t[nthreads];
+    for(unsigned i=0; i<nthreads; i++)
+      pthread_create(&threads[i], 0, fill, reinterpret_cast<void*>(long(i)));
+    for(unsigned i=0; i<nthreads; i++)
+      pthread_join(threads[i], 0);
+    double dt = now()-t0;
+
+    _done = true;
+    pthread_join(server, 0);
+    _entry->merge();
+
+    double sum = 0;
+    for(unsigned b=0; b<nbins; b++)
+      sum += _entry->content(b);
+    bool lsame = (sum == double(nthreads)*double(_fills)) &&
+      (_entry->time().seconds() == _fills-1);
+    lexact &= lsame;
+
+    printf("%-7s %u thread%s: %6.1f ns/fill  %s\n",
+           _sharded ? "sharded" : "locked", nthreads, nthreads>1 ? "s":" ",
+           1.e9*dt/double(_fills),
+           lsame ? "complete" : "INCOMPLETE");
+
+    delete[] threads;
+    delete _entry;
+  }
+
+  return lexact ? 0 : 1;
+}
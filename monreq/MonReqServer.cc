@@ -1,4 +1,5 @@
 #include "pds/monreq/MonReqServer.hh"
+#include "pds/monreq/ShmServer.hh"
 #include <stdio.h>
 #include <stdlib.h>
 #include <poll.h>
@@ -19,16 +20,40 @@ MonReqServer::MonReqServer(unsigned int nodenumber, unsigned int platform) :
   _connMgr(Route::interface(), StreamPorts::monRequest(platform), nodenumber, _servers),
   _queued(0),
   _handled(0),
-  _sem(Semaphore::EMPTY)
+  _sem(Semaphore::EMPTY),
+  _shm(0)
 {
   _task->call(this);
   _id=nodenumber;
   _platform=platform;
 }
 
+MonReqServer::MonReqServer(unsigned int nodenumber, unsigned int platform,
+                           const char* shmName, unsigned nslots, unsigned slotSize,
+                           unsigned maxClients, MonReq::ShmRing::Policy policy) :
+  _task(new Task(TaskObject("monlisten"))), 
+  _task2(new Task(TaskObject("que"))), 
+  _servers(0),
+  _connMgr(Route::interface(), StreamPorts::monRequest(platform), nodenumber, _servers),
+  _queued(0),
+  _handled(0),
+  _sem(Semaphore::EMPTY),
+  _shm(new MonReq::ShmServer(shmName, nslots, slotSize, maxClients, policy))
+{
+  if (!_shm->valid()) {
+    delete _shm;
+    _shm = 0;
+  }
+  _task->call(this);
+  _id=nodenumber;
+  _platform=platform;
+}
+
 MonReqServer::~MonReqServer()
 {
   _task->destroy();
+  if (_shm)
+    delete _shm;
 }
 
 Transition* MonReqServer::transitions(Transition* tr)
@@ -84,6 +109,9 @@ InDatagram* MonReqServer::fire (InDatagram* dg)
 
   _handled++;
     if (_queued - _handled < 32) {
+  //  One copy for all the clients on this node
+  if (_shm)
+    _shm->send(dg->datagram());
   for(unsigned i=0; i<_servers.size(); i++)
     _servers[i].send(dg->datagram());
 	}
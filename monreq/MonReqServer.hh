@@ -9,14 +9,23 @@
 
 #include "pds/monreq/ConnectionManager.hh"
 #include "pds/monreq/ServerConnection.hh"
+#include "pds/monreq/ShmRing.hh"
 
 #include <vector>
 
 namespace Pds {
-  
+  namespace MonReq { class ShmServer; }
+
   class MonReqServer : public Appliance, public Routine, public Action {
   public:
     MonReqServer(unsigned int nodenumber, unsigned int platform);
+    //
+    //  Also publish every datagram to the clients on this node through the
+    //  shared-memory ring "shmName" (see ShmRing.hh)
+    //
+    MonReqServer(unsigned int nodenumber, unsigned int platform,
+                 const char* shmName, unsigned nslots, unsigned slotSize,
+                 unsigned maxClients, MonReq::ShmRing::Policy policy);
   public:
     ~MonReqServer();
   public:
@@ -36,7 +45,7 @@ namespace Pds {
     int      _queued;
     int      _handled;
     Semaphore _sem;
-
+    Pds::MonReq::ShmServer* _shm;
   };
 };
 
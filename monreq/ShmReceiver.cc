@@ -0,0 +1,148 @@
+//ShmReceiver.cc
+
+#include "pds/monreq/ShmReceiver.hh"
+#include "pds/xtc/Datagram.hh"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace Pds;
+using namespace Pds::MonReq;
+
+ShmReceiver::ShmReceiver(const char* name) :
+  _size  (0),
+  _base  (0),
+  _ring  (0),
+  _client(0)
+{
+  int fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0) {
+    perror("ShmReceiver shm_open");
+    return;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 || size_t(st.st_size) < sizeof(ShmRing::Header)) {
+    printf("ShmReceiver %s is not ready\n", name);
+    close(fd);
+    return;
+  }
+  void* p = mmap(0, st.st_size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    perror("ShmReceiver mmap");
+    return;
+  }
+  _size = st.st_size;
+  _base = p;
+  _ring = ShmRing(_base);
+
+  const ShmRing::Header& h = _ring.header();
+  if (h.magic != ShmRing::Magic || h.version != ShmRing::Version ||
+      ShmRing::size(h.nslots, h.slotSize, h.maxClients) > _size) {
+    printf("ShmReceiver %s is not a ring of version %d\n", name, ShmRing::Version);
+    return;
+  }
+
+  //  Claim a free client entry; the server admits it on its next datagram
+  for(unsigned i=0; i<h.maxClients; i++) {
+    ShmRing::Client& c = _ring.client(i);
+    if (__sync_bool_compare_and_swap(&c.state, unsigned(ShmRing::Free), unsigned(ShmRing::Joining))) {
+      c.pid   = getpid();
+      _client = &c;
+      return;
+    }
+  }
+  printf("ShmReceiver %s has no free client entries (%u)\n", name, h.maxClients);
+}
+
+ShmReceiver::~ShmReceiver()
+{
+  if (_client) {
+    //  Not yet admitted: it holds no slots, so give up the entry
+    int pid = _client->pid;
+    _client->pid = 0;
+    if (!__sync_bool_compare_and_swap(&_client->state, unsigned(ShmRing::Joining), unsigned(ShmRing::Free))) {
+      _client->pid   = pid;
+      _client->state = ShmRing::Leaving;  // the server releases its slots
+    }
+  }
+  if (_base)
+    munmap(_base, _size);
+}
+
+bool ShmReceiver::valid() const { return _client!=0; }
+
+uint64_t ShmReceiver::dropped() const { return _client ? _client->dropped : 0; }
+
+const Datagram* ShmReceiver::receive(int timeout_ms)
+{
+  if (!_client)
+    return 0;
+
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  ts.tv_sec  += timeout_ms/1000;
+  ts.tv_nsec += (timeout_ms%1000)*1000000;
+  if (ts.tv_nsec >= 1000000000) { ts.tv_sec++; ts.tv_nsec -= 1000000000; }
+
+  while(1) {
+    if (_ring.header().magic != ShmRing::Magic)  // the server has gone
+      return 0;
+    if (_client->state == ShmRing::Active) {
+      uint64_t cursor = _client->cursor;
+      if (cursor & 1)           // still holding the last one
+        return reinterpret_cast<const Datagram*>(ShmRing::payload(_ring.slot(cursor>>1)));
+      if (_skip(cursor))
+        continue;
+      ShmRing::Slot& s = _ring.slot(cursor>>1);
+      if (s.seq == (cursor>>1) &&
+          __sync_bool_compare_and_swap(&_client->cursor, cursor, cursor|1))
+        return reinterpret_cast<const Datagram*>(ShmRing::payload(s));
+      if (s.seq == (cursor>>1))  // the server skipped it meanwhile
+        continue;
+    }
+    if (sem_timedwait(&_client->ready, &ts) < 0 && errno == ETIMEDOUT)
+      return 0;
+  }
+}
+
+//
+//  Under DropOldest, a client more than half the ring behind skips to the
+//  newest datagram, so that it doesn't pin the oldest slots and make the
+//  server drop datagrams for all.
+//
+bool ShmReceiver::_skip(uint64_t cursor)
+{
+  ShmRing::Header& h = _ring.header();
+  uint64_t seq  = cursor>>1;
+  uint64_t head = h.head;
+  if (h.policy != ShmRing::DropOldest || head - seq <= h.nslots/2)
+    return false;
+  if (!__sync_bool_compare_and_swap(&_client->cursor, cursor, (head-1)<<1))
+    return true;                // the server skipped it meanwhile
+  for(; seq < head-1; seq++)
+    if (__sync_sub_and_fetch(&_ring.slot(seq).refs, 1)==0)
+      sem_post(&h.space);
+  __sync_fetch_and_add(&_client->dropped, head-1-(cursor>>1));
+  return true;
+}
+
+void ShmReceiver::release()
+{
+  if (!_client)
+    return;
+  uint64_t cursor = _client->cursor;
+  if (!(cursor & 1))
+    return;
+  ShmRing::Slot& s = _ring.slot(cursor>>1);
+  _client->cursor = ((cursor>>1)+1)<<1;
+  __sync_synchronize();
+  if (__sync_sub_and_fetch(&s.refs, 1)==0)
+    sem_post(&_ring.header().space);
+}
@@ -0,0 +1,53 @@
+#ifndef Pds_MonReq_ShmReceiver_hh
+#define Pds_MonReq_ShmReceiver_hh
+
+#include "pds/monreq/ShmRing.hh"
+
+namespace Pds {
+  class Datagram;
+
+  namespace MonReq {
+
+    class ShmReceiver {
+    public:
+      //
+      //  Attach to the shared-memory ring "name" of a ShmServer on this node
+      //
+      ShmReceiver(const char* name);
+      ~ShmReceiver();
+
+    public:
+      //
+      //  True if attached
+      //
+      bool valid() const;
+
+      //
+      //  Wait up to "timeout_ms" for the next datagram.  It is read in place,
+      //  and remains valid until released.  Returns 0 on timeout, or if the
+      //  server has gone.
+      //
+      const Datagram* receive(int timeout_ms);
+
+      //
+      //  Release the datagram returned by receive
+      //
+      void release();
+
+      //
+      //  Datagrams skipped because this client fell behind
+      //
+      uint64_t dropped() const;
+
+    private:
+      bool _skip(uint64_t cursor);
+    private:
+      size_t            _size;
+      void*             _base;
+      ShmRing           _ring;
+      ShmRing::Client*  _client;
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,94 @@
+#ifndef Pds_MonReq_ShmRing_hh
+#define Pds_MonReq_ShmRing_hh
+
+#include <stdint.h>
+#include <stddef.h>
+#include <semaphore.h>
+
+namespace Pds {
+  namespace MonReq {
+
+    //
+    //  The layout of the shared-memory ring through which a MonReqServer
+    //  hands datagrams to the monitoring clients on its own node.  The
+    //  server copies each datagram once into a slot, and every client reads
+    //  the slots in place from its own mapping of the ring.
+    //
+    //  Slots are reference counted.  A slot is published with a count of
+    //  the clients attached at the time, each client releases it when done,
+    //  and the server reuses it only when the count has dropped to zero.
+    //  Each client has its own cursor: the sequence number of the next slot
+    //  it will read, and whether it holds that slot now.  When the slot to
+    //  be reused is still referenced, the server either skips it for the
+    //  clients which have not yet started on it (DropOldest) or waits for
+    //  it to be released (Block).  Under DropOldest a client which falls
+    //  more than half the ring behind also skips ahead to the newest slot.
+    //
+    class ShmRing {
+    public:
+      enum Policy      { DropOldest, Block };
+      //  A client claims a Free entry as Joining, and the server admits it
+      //  (Joining to Active).  A client which is admitted leaves as Leaving,
+      //  and the server then releases its slots and frees the entry; one
+      //  which is not yet admitted frees the entry itself.
+      enum ClientState { Free, Joining, Active, Leaving };
+      enum { Magic = 0x4d6f6e52, Version = 1, Align = 64 };
+
+      class Header {
+      public:
+        uint32_t          magic;
+        uint32_t          version;
+        uint32_t          nslots;
+        uint32_t          slotSize;     // bytes for each datagram
+        uint32_t          maxClients;
+        uint32_t          policy;
+        int32_t           serverPid;
+        volatile uint64_t head;         // sequence number of the next slot published
+        sem_t             space;        // posted when a slot's count drops to zero
+      };
+
+      class Client {
+      public:
+        volatile uint32_t state;        // ClientState
+        volatile int32_t  pid;
+        volatile uint64_t cursor;       // next sequence number << 1, | 1 while held
+        volatile uint64_t dropped;      // slots skipped by DropOldest
+        sem_t             ready;        // posted for each slot published
+      };
+
+      class Slot {
+      public:
+        volatile uint64_t seq;          // of the datagram in it, ~0 while written
+        volatile uint32_t refs;         // clients yet to release it
+        uint32_t          size;         // of the datagram which follows
+      };
+
+    public:
+      ShmRing(void* base) : _base(reinterpret_cast<char*>(base)) {}
+    public:
+      static size_t size(unsigned nslots, unsigned slotSize, unsigned maxClients) {
+        return _clients_offset() + maxClients*_client_size() + size_t(nslots)*_slot_size(slotSize);
+      }
+    public:
+      Header& header() const { return *reinterpret_cast<Header*>(_base); }
+      Client& client(unsigned i) const {
+        return *reinterpret_cast<Client*>(_base + _clients_offset() + i*_client_size());
+      }
+      Slot&   slot(uint64_t seq) const {
+        const Header& h = header();
+        return *reinterpret_cast<Slot*>(_base + _clients_offset() + h.maxClients*_client_size() +
+                                        size_t(seq % h.nslots)*_slot_size(h.slotSize));
+      }
+      static char* payload(Slot& s) { return reinterpret_cast<char*>(&s+1); }
+    private:
+      static size_t _round  (size_t n) { return (n+Align-1)&~size_t(Align-1); }
+      static size_t _clients_offset() { return _round(sizeof(Header)); }
+      static size_t _client_size   () { return _round(sizeof(Client)); }
+      static size_t _slot_size     (unsigned slotSize) { return _round(sizeof(Slot)+slotSize); }
+    private:
+      char* _base;
+    };
+
+  }
+}
+#endif
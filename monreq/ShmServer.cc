@@ -0,0 +1,250 @@
+//ShmServer.cc
+
+#include "pds/monreq/ShmServer.hh"
+#include "pds/xtc/Datagram.hh"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace Pds;
+using namespace Pds::MonReq;
+
+static const uint64_t Unwritten = ~0ULL;
+
+//  Check that attached clients are still alive this often
+static const unsigned CheckAliveMask = 0xff;
+//  and while blocked on a slot
+static const long BlockWaitNs = 100000000;
+
+ShmServer::ShmServer(const char* name, unsigned nslots, unsigned slotSize,
+                     unsigned maxClients, ShmRing::Policy policy) :
+  _name   (strdup(name)),
+  _size   (ShmRing::size(nslots, slotSize, maxClients)),
+  _base   (0),
+  _ring   (0),
+  _policy (policy),
+  _clients(0),
+  _dropped(0)
+{
+  shm_unlink(_name);
+  int fd = shm_open(_name, O_CREAT|O_EXCL|O_RDWR, 0666);
+  if (fd < 0) {
+    perror("ShmServer shm_open");
+    return;
+  }
+  fchmod(fd, 0666);  // not masked by the umask
+  if (ftruncate(fd, _size) < 0) {
+    perror("ShmServer ftruncate");
+    close(fd);
+    return;
+  }
+  void* p = mmap(0, _size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    perror("ShmServer mmap");
+    return;
+  }
+  _base = p;
+  _ring = ShmRing(_base);
+
+  ShmRing::Header& h = _ring.header();
+  h.nslots     = nslots;
+  h.slotSize   = slotSize;
+  h.maxClients = maxClients;
+  h.policy     = policy;
+  h.serverPid  = getpid();
+  h.head       = 0;
+  sem_init(&h.space, 1, 0);
+  for(unsigned i=0; i<maxClients; i++) {
+    ShmRing::Client& c = _ring.client(i);
+    c.state   = ShmRing::Free;
+    c.pid     = 0;
+    c.cursor  = 0;
+    c.dropped = 0;
+    sem_init(&c.ready, 1, 0);
+  }
+  for(unsigned i=0; i<nslots; i++) {
+    ShmRing::Slot& s = _ring.slot(i);
+    s.seq  = Unwritten;
+    s.refs = 0;
+    s.size = 0;
+  }
+  h.version = ShmRing::Version;
+  __sync_synchronize();
+  h.magic   = ShmRing::Magic;
+
+  printf("ShmServer %s: %u slots of %u bytes for %u clients, %s\n",
+         _name, nslots, slotSize, maxClients,
+         policy==ShmRing::Block ? "blocking" : "dropping oldest");
+}
+
+ShmServer::~ShmServer()
+{
+  if (_base) {
+    _ring.header().magic = 0;
+    munmap(_base, _size);
+    shm_unlink(_name);
+  }
+  free(_name);
+}
+
+bool ShmServer::valid() const { return _base!=0; }
+
+unsigned ShmServer::clients() const { return _clients; }
+
+uint64_t ShmServer::published() const { return _base ? _ring.header().head : 0; }
+
+uint64_t ShmServer::dropped() const { return _dropped; }
+
+//
+//  Admit joining clients, and release the slots of those which have left
+//  or died.  Only admitted clients hold slots: a client which leaves
+//  before it is admitted frees its own entry.
+//
+void ShmServer::_reap(bool checkAlive)
+{
+  ShmRing::Header& h = _ring.header();
+  unsigned n = 0;
+  for(unsigned i=0; i<h.maxClients; i++) {
+    ShmRing::Client& c = _ring.client(i);
+    switch(c.state) {
+    case ShmRing::Joining:
+      if (c.pid) {
+        c.cursor  = h.head<<1;
+        c.dropped = 0;
+        __sync_synchronize();
+        //  The client may give up its entry before it is admitted
+        if (__sync_bool_compare_and_swap(&c.state, unsigned(ShmRing::Joining), unsigned(ShmRing::Active))) {
+          sem_post(&c.ready);
+          printf("ShmServer %s: client %u (pid %d) attached\n", _name, i, c.pid);
+          n++;
+        }
+        else if (c.state == ShmRing::Leaving)
+          _free(c);           // it holds no slots
+        else
+          c.cursor = 0;
+      }
+      break;
+    case ShmRing::Active:
+      if (checkAlive && kill(c.pid, 0) < 0 && errno == ESRCH) {
+        printf("ShmServer %s: client %u (pid %d) died\n", _name, i, c.pid);
+        _detach(c);
+      }
+      else
+        n++;
+      break;
+    case ShmRing::Leaving:
+      printf("ShmServer %s: client %u (pid %d) detached\n", _name, i, c.pid);
+      _detach(c);
+      break;
+    default:
+      break;
+    }
+  }
+  _clients = n;
+}
+
+void ShmServer::_detach(ShmRing::Client& c)
+{
+  ShmRing::Header& h = _ring.header();
+  for(uint64_t seq=c.cursor>>1; seq<h.head; seq++) {
+    if (__sync_sub_and_fetch(&_ring.slot(seq).refs, 1)==0)
+      sem_post(&h.space);
+  }
+  _free(c);
+}
+
+void ShmServer::_free(ShmRing::Client& c)
+{
+  c.pid    = 0;
+  c.cursor = 0;
+  __sync_synchronize();
+  c.state  = ShmRing::Free;
+}
+
+//
+//  Skip the oldest slot for the clients which haven't started on it.
+//  Returns false if one of them is reading it.
+//
+bool ShmServer::_drop(ShmRing::Slot& s, uint64_t seq)
+{
+  ShmRing::Header& h = _ring.header();
+  for(unsigned i=0; i<h.maxClients; i++) {
+    ShmRing::Client& c = _ring.client(i);
+    if (c.state != ShmRing::Active)
+      continue;
+    while(1) {
+      uint64_t cursor = c.cursor;
+      if ((cursor>>1) != seq)
+        break;
+      if (cursor & 1)
+        return false;
+      if (__sync_bool_compare_and_swap(&c.cursor, cursor, (seq+1)<<1)) {
+        __sync_fetch_and_add(&c.dropped, 1);
+        __sync_sub_and_fetch(&s.refs, 1);
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+int ShmServer::send(const Datagram& dg)
+{
+  if (!_base)
+    return -1;
+
+  ShmRing::Header& h = _ring.header();
+  uint64_t seq = h.head;
+  _reap((seq & CheckAliveMask)==0);
+
+  unsigned size = sizeof(dg) + dg.xtc.sizeofPayload();
+  if (size > h.slotSize) {
+    _dropped++;
+    return -1;
+  }
+
+  ShmRing::Slot& s = _ring.slot(seq);
+  while(s.refs) {
+    if (_policy == ShmRing::DropOldest) {
+      if (_drop(s, seq-h.nslots) && s.refs)
+        _reap(true);  // held by a client which left or died
+      if (s.refs) {
+        _dropped++;
+        return -1;
+      }
+    }
+    else {
+      timespec ts;
+      clock_gettime(CLOCK_REALTIME, &ts);
+      ts.tv_nsec += BlockWaitNs;
+      if (ts.tv_nsec >= 1000000000) { ts.tv_sec++; ts.tv_nsec -= 1000000000; }
+      if (sem_timedwait(&h.space, &ts) < 0)
+        _reap(true);
+    }
+  }
+
+  s.seq  = Unwritten;
+  __sync_synchronize();
+  memcpy(ShmRing::payload(s), &dg, size);
+  s.size = size;
+  s.refs = _clients;
+  __sync_synchronize();
+  s.seq  = seq;
+  h.head = seq+1;
+
+  for(unsigned i=0; i<h.maxClients; i++) {
+    ShmRing::Client& c = _ring.client(i);
+    if (c.state == ShmRing::Active)
+      sem_post(&c.ready);
+  }
+  return 0;
+}
@@ -0,0 +1,57 @@
+#ifndef Pds_MonReq_ShmServer_hh
+#define Pds_MonReq_ShmServer_hh
+
+#include "pds/monreq/ShmRing.hh"
+
+namespace Pds {
+  class Datagram;
+
+  namespace MonReq {
+
+    class ShmServer {
+    public:
+      //
+      //  Create the shared-memory ring "name" (a POSIX shm name, "/...")
+      //  of "nslots" datagrams of up to "slotSize" bytes, for up to
+      //  "maxClients" clients
+      //
+      ShmServer(const char* name, unsigned nslots, unsigned slotSize,
+                unsigned maxClients, ShmRing::Policy policy);
+      ~ShmServer();
+
+    public:
+      //
+      //  True if the ring was created
+      //
+      bool valid() const;
+
+      //
+      //  Copy a datagram into the ring for all attached clients.
+      //  Returns 0, or -1 if it was dropped.
+      //
+      int send(const Datagram&);
+
+    public:
+      unsigned clients  () const;
+      uint64_t published() const;
+      uint64_t dropped  () const;  // datagrams not published
+
+    private:
+      void _reap(bool checkAlive);
+      bool _drop(ShmRing::Slot&, uint64_t seq);
+      void _detach(ShmRing::Client&);
+      void _free  (ShmRing::Client&);
+
+    private:
+      char*    _name;
+      size_t   _size;
+      void*    _base;
+      ShmRing  _ring;
+      ShmRing::Policy _policy;
+      unsigned _clients;
+      uint64_t _dropped;
+    };
+
+  }
+}
+#endif
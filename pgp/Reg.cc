@@ -66,3 +66,42 @@ Reg::operator unsigned() const {
     }
   }
 }
+
+// write registers
+void Reg::write(const std::vector<Reg*>& regs, const std::vector<uint32_t>& v) {
+  if (regs.empty()) return;
+  std::vector<uint64_t> addr(regs.size());
+  for(unsigned i=0; i<regs.size(); i++)
+    addr[i] = reinterpret_cast<uint64_t>(regs[i]);
+  if (_debug)
+    printf("Reg::write %zu @%08x.. %x\n", regs.size(), unsigned(addr[0]), _dest->dest());
+  if (_pgp->writeRegisters(DESTV, &addr[0], &v[0], addr.size())) {
+    std::stringstream o;
+    o << "Pgp::Reg write error @ addresses " << std::hex << addr[0]
+      << ".. [" << std::dec << addr.size() << "] dest[" << std::hex << _dest->dest()
+      << "] pgp[" << PGPV << "]";
+    printf("Reg::write: %s\n",o.str().c_str());
+    throw o.str();
+  }
+}
+
+// read registers
+void Reg::read(const std::vector<const Reg*>& regs, std::vector<uint32_t>& v) {
+  v.resize(regs.size());
+  if (regs.empty()) return;
+  std::vector<uint64_t> addr(regs.size());
+  for(unsigned i=0; i<regs.size(); i++)
+    addr[i] = reinterpret_cast<uint64_t>(regs[i]);
+  unsigned errorCount = 0;
+  while (_pgp->readRegisters(DESTV, &addr[0], &v[0], addr.size())) {
+    std::stringstream o;
+    o << "Pgp::Reg read error @ addresses " << std::hex << addr[0]
+      << ".. [" << std::dec << addr.size() << "] dest[" << std::hex << _dest->dest()
+      << "] pgp[" << PGPV << "] errorCount[" << ++errorCount << "]";
+    printf("Reg::read: %s\n",o.str().c_str());
+    if (errorCount > 3)
+      throw o.str();
+    else
+      usleep(errorCount*_backofftime);
+  }
+}
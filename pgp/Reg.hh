@@ -2,6 +2,7 @@
 #define Pds_Pgp_Reg_hh
 
 #include <stdint.h>
+#include <vector>
 
 namespace Pds {
   namespace Pgp {
@@ -14,6 +15,10 @@ namespace Pds {
     public:
       static void     setPgp (SrpV3::Protocol*);
       static void     setDest(unsigned);
+    public:
+      //  Many registers, with their transactions in flight together
+      static void     write(const std::vector<Reg*>&, const std::vector<uint32_t>&);
+      static void     read (const std::vector<const Reg*>&, std::vector<uint32_t>&);
     private:
       uint32_t _v;
     };
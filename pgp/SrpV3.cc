@@ -52,7 +52,8 @@ void RegisterSlaveFrame::print(unsigned nw) const {
 Protocol::Protocol(int fd, unsigned lane, bool isDataDev) :
   _fd       (fd),
   _lane     (lane),
-  _isDataDev(isDataDev)
+  _isDataDev(isDataDev),
+  _tid      (0)
 {
   memset(_readBuffer, 0, BufferWords*sizeof(unsigned));
 }
@@ -256,3 +257,189 @@ unsigned Protocol::readRegister(Destination* dest,
 }
 
 
+
+unsigned Protocol::writeRegisters(Destination*    dest,
+                                  const uint64_t* addr,
+                                  const uint32_t* vals,
+                                  unsigned        n) {
+  return _transact(PgpRSBits::write, dest, addr, const_cast<uint32_t*>(vals), n);
+}
+
+unsigned Protocol::readRegisters(Destination*    dest,
+                                 const uint64_t* addr,
+                                 uint32_t*       vals,
+                                 unsigned        n) {
+  return _transact(PgpRSBits::read, dest, addr, vals, n);
+}
+
+unsigned Protocol::_transact(PgpRSBits::opcode oc,
+                             Destination*      dest,
+                             const uint64_t*   addr,
+                             uint32_t*         vals,
+                             unsigned          n) {
+  class Pending {
+  public:
+    unsigned tid;
+    unsigned first;
+    unsigned words;
+  };
+  Pending  pending[MaxOutstanding];
+  unsigned npending = 0;
+  unsigned next     = 0;
+  unsigned ret      = Success;
+
+  while(next < n || npending) {
+    while(next < n && npending < MaxOutstanding && ret == Success) {
+      unsigned words = 1;
+      while(next+words < n && words < MaxWords &&
+            addr[next+words] == addr[next]+words*sizeof(uint32_t))
+        words++;
+
+      //  Apart from the IDs of readRegister and writeRegister
+      unsigned tid = 0x80000000 | (_tid++ & 0x3fffff);
+      SrpV3::RegisterSlaveFrame* hdr =
+        new (_writeBuffer) SrpV3::RegisterSlaveFrame(oc, dest, addr[next], tid, words);
+      unsigned size = sizeof(*hdr);
+      if (oc == PgpRSBits::write) {
+        memcpy(hdr->array(), &vals[next], words*sizeof(uint32_t));
+        size += words*sizeof(uint32_t);
+      }
+      if (_post(dest, hdr, size) != Success)
+        ret = Failure;
+      else {
+        pending[npending].tid   = tid;
+        pending[npending].first = next;
+        pending[npending].words = words;
+        npending++;
+        next += words;
+      }
+    }
+
+    if (ret != Success && npending == 0)
+      break;
+
+    unsigned words;
+    bool     failed;
+    SrpV3::RegisterSlaveFrame* rsf = _reply(words, failed);
+    if (!rsf) {
+      printf("SrpV3::_transact %u transactions lost: fd[%d] dest[%x]\n",
+             npending, _fd, dest->dest());
+      return Failure;
+    }
+
+    //  Replies to writeRegister, which are not waited for, are passed over
+    unsigned i=0;
+    while(i < npending && pending[i].tid != rsf->tid())
+      i++;
+    if (i == npending)
+      continue;
+
+    if (failed || words != pending[i].words || rsf->opcode() != oc) {
+      printf("SrpV3::_transact failed @ 0x%" PRIx64 " words %u(%u)\n",
+             addr[pending[i].first], words, pending[i].words);
+      ret = Failure;
+    }
+    else if (oc == PgpRSBits::read)
+      memcpy(&vals[pending[i].first], rsf+1, words*sizeof(uint32_t));
+
+    pending[i] = pending[--npending];
+  }
+
+  return ret;
+}
+
+unsigned Protocol::_post(Destination*                     dest,
+                         const SrpV3::RegisterSlaveFrame* hdr,
+                         unsigned                         size) {
+  struct timeval  timeout;
+  timeout.tv_sec=0;
+  timeout.tv_usec=100000;
+  fd_set          fds;
+  FD_ZERO(&fds);
+  FD_SET(_fd,&fds);
+
+  struct DmaWriteData  pgpCardTx;
+  pgpCardTx.is32   = (sizeof(&pgpCardTx) == 4);
+  pgpCardTx.flags  = 0;
+  pgpCardTx.dest   = Destination::build(dest->lane() + _lane, dest->vc(), _isDataDev);
+  pgpCardTx.index  = 0;
+  pgpCardTx.size   = size;
+  pgpCardTx.data   = (__u64)hdr;
+
+  int ret;
+  if ((ret = select( _fd+1, NULL, &fds, NULL, &timeout)) <= 0) {
+    if (ret < 0) {
+      perror("SrpV3 post select error: ");
+    } else {
+      printf("SrpV3 post select timed out: fd[%u] dest[%x]\n", _fd, pgpCardTx.dest);
+    }
+    return Failure;
+  }
+  if (::write(_fd, &pgpCardTx, sizeof(pgpCardTx)) < 0) {
+    perror("SrpV3 post write error: ");
+    return Failure;
+  }
+  return Success;
+}
+
+//
+//  The next reply of any kind, with the number of data words it carries;
+//  0 if none arrived in time.
+//
+RegisterSlaveFrame* Protocol::_reply(unsigned& words,
+                                     bool&     failed) {
+  struct timeval  timeout;
+  timeout.tv_sec  = 0;
+  timeout.tv_usec = SelectSleepTimeUSec;
+  fd_set          fds;
+  FD_ZERO(&fds);
+  FD_SET(_fd,&fds);
+
+  int sret = select(_fd+1,&fds,NULL,NULL,&timeout);
+  if (sret <= 0) {
+    if (sret < 0)
+      perror("SrpV3::_reply select error: ");
+    else
+      printf("SrpV3::_reply select timed out! fd[%u]\n", _fd);
+    return 0;
+  }
+
+  struct DmaReadData       pgpCardRx;
+  pgpCardRx.flags   = 0;
+  pgpCardRx.dest    = 0;
+  pgpCardRx.ret     = 0;
+  pgpCardRx.size    = BufferWords*sizeof(uint32_t);
+  pgpCardRx.data    = (uint64_t)(&(_readBuffer));
+  pgpCardRx.is32    = sizeof(&pgpCardRx)==4;
+  if (::read(_fd, &pgpCardRx, sizeof(struct DmaReadData)) < 0) {
+    perror("SrpV3::_reply ERROR ! ");
+    return 0;
+  }
+
+  SrpV3::RegisterSlaveFrame* rsf =
+    reinterpret_cast<SrpV3::RegisterSlaveFrame*>(_readBuffer);
+  unsigned hdrWords = sizeof(SrpV3::RegisterSlaveFrame)/sizeof(uint32_t);
+  unsigned n        = pgpCardRx.ret/sizeof(uint32_t);
+
+  failed = false;
+  words  = 0;
+  if (pgpCardRx.error) {
+    Destination dest(pgpCardRx.dest, _isDataDev);
+    printError(pgpCardRx.error, dest.dest());
+    failed = true;
+  }
+  else if (n < hdrWords+1) {
+    printf("SrpV3::_reply read returned %u bytes\n", pgpCardRx.ret);
+    failed = true;
+  }
+  else {
+    LastBits* l = reinterpret_cast<LastBits*>(_readBuffer+n-1);
+    if (l->failed || l->timeout) {
+      printf("SrpV3::_reply received HW %s\n", l->failed ? "failure" : "timeout");
+      rsf->print();
+      failed = true;
+    }
+    words = n-hdrWords-1;
+  }
+  return rsf;
+}
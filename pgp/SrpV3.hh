@@ -49,14 +49,41 @@ namespace Pds {
                                     unsigned     tid,
                                     uint32_t*    retp);
         RegisterSlaveImportFrame*  read(unsigned size);
+        //
+        //  Many registers at once: each run of consecutive addresses is one
+        //  transaction, and up to MaxOutstanding transactions are in flight,
+        //  their replies matched by transaction ID.  Unlike writeRegister,
+        //  the writes are acknowledged.
+        //
+        unsigned      writeRegisters( Destination*    dest,
+                                      const uint64_t* addr,
+                                      const uint32_t* vals,
+                                      unsigned        n);
+        unsigned      readRegisters ( Destination*    dest,
+                                      const uint64_t* addr,
+                                      uint32_t*       vals,
+                                      unsigned        n);
+        enum {MaxOutstanding=8, MaxWords=256};
       public:
         int       fd  () const { return _fd; }
         unsigned  lane() const { return _lane; }
+      private:
+        unsigned      _transact( PgpRSBits::opcode,
+                                 Destination*,
+                                 const uint64_t*,
+                                 uint32_t*,
+                                 unsigned );
+        unsigned      _post    ( Destination*,
+                                 const RegisterSlaveFrame*,
+                                 unsigned );
+        RegisterSlaveFrame* _reply( unsigned& words,
+                                    bool&     failed );
       private:
         enum {BufferWords=8192};
         int                    _fd;
         unsigned               _lane;
         bool                   _isDataDev;
+        unsigned               _tid;
         unsigned               _readBuffer [BufferWords];
         unsigned               _writeBuffer[BufferWords];
       };
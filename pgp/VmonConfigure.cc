@@ -0,0 +1,68 @@
+#include "pds/pgp/VmonConfigure.hh"
+
+#include "pds/mon/MonDescTH1F.hh"
+#include "pds/mon/MonEntryTH1F.hh"
+#include "pds/mon/MonGroup.hh"
+#include "pds/vmon/VmonServerManager.hh"
+#include "pdsdata/xtc/ClockTime.hh"
+
+#include <math.h>
+
+using namespace Pds::Pgp;
+
+//  0.1 ms to 100 s, ten bins a decade
+static const unsigned Bins = 60;
+static const float    Low  = -1;
+static const float    High = 5;
+
+static double log_ms(const timespec& b, const timespec& e)
+{
+  double ms = 1.e3*double(e.tv_sec - b.tv_sec) + 1.e-6*(double(e.tv_nsec) - double(b.tv_nsec));
+  return ms > 0 ? log10(ms) : Low-1;
+}
+
+VmonConfigure::VmonConfigure(const char* name, unsigned nphases, const char* const* phases)
+{
+  Pds::MonGroup* group = new Pds::MonGroup(name);
+  Pds::VmonServerManager::instance()->cds().add(group);
+
+  for(unsigned i=0; i<nphases; i++) {
+    Pds::MonDescTH1F desc(phases[i], "log10 [ms]", "", Bins, Low, High);
+    _phase.push_back(new Pds::MonEntryTH1F(desc));
+    group->add(_phase.back());
+  }
+
+  Pds::MonDescTH1F total("Configure", "log10 [ms]", "", Bins, Low, High);
+  _total = new Pds::MonEntryTH1F(total);
+  group->add(_total);
+
+  clock_gettime(CLOCK_REALTIME, &_start);
+  _last = _start;
+}
+
+void VmonConfigure::start()
+{
+  clock_gettime(CLOCK_REALTIME, &_start);
+  _last = _start;
+}
+
+void VmonConfigure::phase(unsigned i)
+{
+  timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  if (i < _phase.size())
+    _phase[i]->addcontent(1., log_ms(_last, now));
+  _last = now;
+}
+
+void VmonConfigure::end()
+{
+  timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  _total->addcontent(1., log_ms(_start, now));
+
+  Pds::ClockTime clock(now.tv_sec, now.tv_nsec);
+  for(unsigned i=0; i<_phase.size(); i++)
+    _phase[i]->time(clock);
+  _total->time(clock);
+}
@@ -0,0 +1,31 @@
+#ifndef Pds_Pgp_VmonConfigure_hh
+#define Pds_Pgp_VmonConfigure_hh
+
+#include <time.h>
+#include <vector>
+
+namespace Pds {
+  class MonEntryTH1F;
+  namespace Pgp {
+    //
+    //  Histograms in vmon of the time taken by each phase of a configure,
+    //  and by the whole, on a log scale.
+    //
+    class VmonConfigure {
+    public:
+      VmonConfigure(const char* name, unsigned nphases, const char* const* phases);
+    public:
+      void start();
+      //  The time since the last phase ended, or since start
+      void phase(unsigned);
+      void end  ();
+    private:
+      std::vector<MonEntryTH1F*> _phase;
+      MonEntryTH1F*              _total;
+      timespec                   _start;
+      timespec                   _last;
+    };
+  };
+};
+
+#endif
@@ -21,6 +21,8 @@
 **            to AckHandler
 **      002 - July 11, 2001 reintroduce the array bit-mask
 **      003 - July 17, 2001 add "timeout" methods.
+**      004 - add "count", "first" and "next" for iterating set bits
+**            without shifting a probe mask through every position.
 **
 ** --
 */
@@ -78,6 +80,10 @@ namespace Pds {
     inline unsigned     hasBitClear  (unsigned index)     const;
     inline unsigned     value        (unsigned index = 0) const;
 
+    inline unsigned     count        (void)               const;  // # of bits set
+    inline unsigned     first        (void)               const;  // lowest bit set
+    inline unsigned     next         (unsigned index)     const;  // lowest bit set above index
+
     inline int          setValue     (unsigned index, unsigned mask);
 
     void print() const;
@@ -469,6 +475,47 @@ template<unsigned N> inline unsigned Pds::BitMaskArray<N>::hasBitClear(unsigned
   return !hasBitSet(index);
 }
 
+template<unsigned N> inline unsigned Pds::BitMaskArray<N>::count(void) const
+{
+  unsigned n = 0;
+  for (unsigned i = 0; i < N; i++)
+    n += __builtin_popcount(_mask[i]);
+  return n;
+}
+
+/*
+** ++
+**
+**    "first" and "next" return BitMaskBits when no (further) bit is set,
+**    so the set bits of a mask are visited with:
+**
+**      for(unsigned i=m.first(); i<m.BitMaskBits; i=m.next(i))
+**
+** --
+*/
+
+template<unsigned N> inline unsigned Pds::BitMaskArray<N>::first(void) const
+{
+  for (unsigned i = 0; i < N; i++)
+    if (_mask[i])
+      return (i << 5) + __builtin_ctz(_mask[i]);
+  return BitMaskBits;
+}
+
+template<unsigned N> inline unsigned Pds::BitMaskArray<N>::next(unsigned index) const
+{
+  unsigned start = index + 1;
+  if (start >= BitMaskBits) return BitMaskBits;
+
+  unsigned i = start >> 5;
+  unsigned w = _mask[i] & (0xffffffff << (start & 0x1f));
+  while (!w) {
+    if (++i == N) return BitMaskBits;
+    w = _mask[i];
+  }
+  return (i << 5) + __builtin_ctz(w);
+}
+
 template<unsigned N> inline Pds::BitMaskArray<N> Pds::BitMaskArray<N>::setBit(unsigned index)
 {
   // index / 32 integer division
@@ -1,4 +1,5 @@
 #include "pds/service/BldBitMask.hh"
+#include "pds/service/EbBitMaskSize.hh"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -74,4 +75,10 @@ namespace Pds {
   template void BitMaskArray<PDS_BLD_MASKSIZE>::print() const;
   template int  BitMaskArray<PDS_BLD_MASKSIZE>::read(const char* arg, char** end);
   template int  BitMaskArray<PDS_BLD_MASKSIZE>::write(char* buf) const;
+
+  // ...and for a wide event builder mask (the 64 bit one is specialized)
+#if PDS_EB_MASKSIZE != 2 && PDS_EB_MASKSIZE != PDS_BLD_MASKSIZE
+  template int  BitMaskArray<PDS_EB_MASKSIZE>::read(const char* arg, char** end);
+  template int  BitMaskArray<PDS_EB_MASKSIZE>::write(char* buf) const;
+#endif
 }
@@ -60,7 +60,9 @@ Client::Client(const Ins& src,
           src,
           sizeofDatagram,
           maxPayload,
-	  maxDatagrams)
+	  maxDatagrams),
+  _batches(0),
+  _batched(0)
   {
     in_addr address;
     address.s_addr = htonl(interface.address());
@@ -101,7 +103,9 @@ Client::Client(const Ins& src,
           src,
           sizeofDatagram,
           maxPayload,
-	  maxDatagrams)
+	  maxDatagrams),
+  _batches(0),
+  _batched(0)
   {
     in_addr address;
     address.s_addr = htonl(interface.address());
@@ -136,7 +140,9 @@ Client::Client(int sizeofDatagram,
   Port(Port::ClientPort,
           sizeofDatagram,
           maxPayload,
-          maxDatagrams)
+          maxDatagrams),
+  _batches(0),
+  _batched(0)
   {
 #ifdef ODF_LITTLE_ENDIAN
     _swap_buffer = new char[sizeofDatagram+maxPayload];
@@ -168,7 +174,9 @@ Client::Client(int sizeofDatagram,
   Port(Port::ClientPort,
           sizeofDatagram,
           maxPayload,
-          maxDatagrams)
+          maxDatagrams),
+  _batches(0),
+  _batched(0)
   {
     in_addr address;
     address.s_addr = htonl(interface.address());
@@ -208,7 +216,9 @@ Client::Client(int sizeofDatagram,
   Port(Port::ClientPort,
           sizeofDatagram,
           maxPayload,
-          maxDatagrams)
+          maxDatagrams),
+  _batches(0),
+  _batched(0)
   {
     in_addr address;
     address.s_addr = htonl(interface.address());
@@ -552,6 +562,77 @@ int Client::send(char*         datagram,
   return (length == - 1) ? errno : 0;
 }
 
+/*
+** ++
+**
+**    This function is used to transmit an array of "msgCount" datagrams,
+**    each to its own destination, with as few system calls as possible.
+**    Messages are handed to the kernel "MaxBatch" at a time with
+**    "sendmmsg"; a partial transmission is resumed from the first
+**    message not sent. The function returns the transmission status
+**    with the same convention as the single datagram functions above.
+**    On little endian hosts each message requires its own swap and the
+**    messages are transmitted one at a time.
+**
+** --
+*/
+
+int Client::send(const Message* msgArray, unsigned msgCount)
+{
+#ifdef ODF_LITTLE_ENDIAN
+  for(unsigned i=0; i<msgCount; i++) {
+    const Message& m = msgArray[i];
+    int status = send(m.datagram, m.payload, m.sizeofPayload, m.dst);
+    if (status) return status;
+  }
+  return 0;
+#else
+  struct mmsghdr hdr[MaxBatch];
+  struct iovec   iov[MaxBatch][2];
+  Sockaddr       sa [MaxBatch];
+
+  while(msgCount) {
+    unsigned count = msgCount < unsigned(MaxBatch) ? msgCount : unsigned(MaxBatch);
+    for(unsigned i=0; i<count; i++) {
+      const Message& m   = msgArray[i];
+      struct msghdr& h   = hdr[i].msg_hdr;
+      struct iovec*  v   = iov[i];
+      if (m.datagram) {
+        v[0].iov_base = (caddr_t)(m.datagram);
+        v[0].iov_len  = sizeofDatagram();
+        v[1].iov_base = (caddr_t)(m.payload);
+        v[1].iov_len  = m.sizeofPayload;
+        h.msg_iovlen  = 2;
+      }
+      else {
+        v[0].iov_base = (caddr_t)(m.payload);
+        v[0].iov_len  = m.sizeofPayload;
+        h.msg_iovlen  = 1;
+      }
+      sa[i].get(m.dst);
+      h.msg_name        = (caddr_t)sa[i].name();
+      h.msg_namelen     = sa[i].sizeofName();
+      h.msg_iov         = v;
+      h.msg_control     = (caddr_t)0;
+      h.msg_controllen  = 0;
+      h.msg_flags       = 0;
+      hdr[i].msg_len    = 0;
+    }
+
+    int sent = sendmmsg(_socket, hdr, count, SendFlags);
+    if (sent == -1) {
+      if (errno == EINTR) continue;
+      return errno;
+    }
+    _batches++;
+    _batched += sent;
+    msgArray += sent;
+    msgCount -= sent;
+  }
+  return 0;
+#endif
+}
+
 /*
 ** ++
 **
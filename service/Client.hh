@@ -77,8 +77,24 @@ class Client : public Port
              int sizeofPayload1,
              int sizeofPayload2,
              const Ins&);
+  public:
+    //  Batched send: each message is a header (datagram) and payload
+    //  pair with its own destination, and up to MaxBatch messages are
+    //  handed to the network stack per system call (sendmmsg).
+    struct Message {
+      char* datagram;
+      char* payload;
+      int   sizeofPayload;
+      Ins   dst;
+    };
+    enum {MaxBatch = 64};
+    int send(const Message* msgArray, unsigned msgCount);
+    unsigned batches() const;
+    unsigned batched() const;
   private:
      enum {SendFlags = 0};
+     unsigned _batches;   // # of batched send calls
+     unsigned _batched;   // # of messages sent in batches
 #ifdef ODF_LITTLE_ENDIAN
     // Would prefer to have _swap_buffer in the stack, but it triggers
     // a g++ bug (tried release 2.96) with pointers to member
@@ -93,4 +109,15 @@ class Client : public Port
 #endif
   };
 }
+
+inline unsigned Pds::Client::batches() const
+  {
+  return _batches;
+  }
+
+inline unsigned Pds::Client::batched() const
+  {
+  return _batched;
+  }
+
 #endif
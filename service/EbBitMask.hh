@@ -21,7 +21,8 @@
 #define PDS_EBBITMASK_
 
 #include "pds/service/BitMaskArray.hh"
+#include "pds/service/EbBitMaskSize.hh"
 
-typedef Pds::BitMaskArray<2> EbBitMask;
+typedef Pds::BitMaskArray<PDS_EB_MASKSIZE> EbBitMask;
 
 #endif
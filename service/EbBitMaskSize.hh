@@ -0,0 +1,13 @@
+#ifndef PDS_EBBITMASKSIZE_
+#define PDS_EBBITMASKSIZE_
+
+/* Defines the number of 32bit words needed for
+   holding the event builder's client bit masks.
+   Example where mask size is 2: 2 * 32 = 64 allowed
+   contributors.  Larger partitions may build with
+   -DPDS_EB_MASKSIZE=4 (128), 8 (256) or 16 (512). */
+#ifndef PDS_EB_MASKSIZE
+#define PDS_EB_MASKSIZE 2
+#endif
+
+#endif
@@ -4,8 +4,8 @@ using namespace Pds;
 
 void GenericPool::dump() const 
 {
-  printf("  bounds %zu  buffer %p  current %zu\n",
-	 _bounds, _buffer, _current);
+  printf("  bounds %zu  buffer %p  current %zu  mapped %zu\n",
+	 _bounds, _buffer, _current, _mapped);
   printf("  sizeofObject %zu  numofObjects %u  allocs %u  frees %u\n",
 	 sizeofObject(), numberofObjects(),
 	 numberofAllocs(), numberofFrees() );
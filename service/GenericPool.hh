@@ -22,6 +22,7 @@
 
 #include "Pool.hh"
 #include "Queue.hh"
+#include "PoolPolicy.hh"
 
 namespace Pds {
 class GenericPool : public Queue<PoolEntry>, public Pool
@@ -29,6 +30,7 @@ class GenericPool : public Queue<PoolEntry>, public Pool
   public:
     GenericPool(size_t sizeofObject, int numberofObjects);
     GenericPool(size_t sizeofObject, int numberofObjects, unsigned alignBoundary);
+    GenericPool(size_t sizeofObject, int numberofObjects, const PoolPolicy& policy);
     ~GenericPool();
   protected:
     virtual void* deque(); 
@@ -38,6 +40,7 @@ class GenericPool : public Queue<PoolEntry>, public Pool
     void dump() const;
   private:
     size_t _bounds;
+    size_t _mapped;
     char* _buffer;
     size_t _current;
   };
@@ -53,12 +56,32 @@ inline
 Pds::GenericPool::GenericPool(size_t sizeofObject, int numberofObjects) :
   Pds::Pool(sizeofObject, numberofObjects),
   _bounds(sizeofAllocate()*numberofObjects),
+  _mapped(0),
   _buffer(new char[_bounds]),
   _current(0)
 {
 populate();
 }
 
+/*
+** ++
+**   A constructor which obtains the pool's memory according to "policy"
+**   (page size, NUMA placement, prefaulting)
+**
+** --
+*/
+
+inline
+Pds::GenericPool::GenericPool(size_t sizeofObject, int numberofObjects, const PoolPolicy& policy) :
+  Pds::Pool(sizeofObject, numberofObjects),
+  _bounds(sizeofAllocate()*numberofObjects),
+  _mapped(0),
+  _buffer(policy.allocate(_bounds, _mapped)),
+  _current(0)
+{
+populate();
+}
+
 /*
 ** ++
 **   A constructor which provides aligned memory accesses
@@ -70,6 +93,7 @@ inline
 Pds::GenericPool::GenericPool(size_t sizeofObject, int numberofObjects, unsigned alignBoundary) :
   Pds::Pool(sizeofObject, numberofObjects, alignBoundary),
   _bounds(sizeofAllocate()*numberofObjects+alignBoundary),
+  _mapped(0),
   _buffer(new char[_bounds]),
   _current(alignBoundary-(((size_t)_buffer+sizeof(PoolEntry))%alignBoundary))
 {
@@ -85,7 +109,7 @@ populate();
 
 inline Pds::GenericPool::~GenericPool()
   {
-  delete[] _buffer;
+  PoolPolicy::release(_buffer, _mapped);
   }
 
 /*
@@ -16,6 +16,15 @@ GenericPoolW::GenericPoolW(size_t sizeofObject, int numberofObjects) :
     _sem.give();
 }
 
+GenericPoolW::GenericPoolW(size_t sizeofObject, int numberofObjects,
+                           const PoolPolicy& policy) :
+  GenericPool(sizeofObject, numberofObjects, policy),
+  _sem(Semaphore::EMPTY)
+{
+  for(int i=0; i<numberofObjects; i++)
+    _sem.give();
+}
+
 GenericPoolW::~GenericPoolW()
 {
 }
@@ -10,6 +10,7 @@ namespace Pds {
   class GenericPoolW : public GenericPool {
   public:
     GenericPoolW(size_t sizeofObject, int numberofObjects);
+    GenericPoolW(size_t sizeofObject, int numberofObjects, const PoolPolicy& policy);
     virtual ~GenericPoolW();
     int           depth()           const;
   protected:
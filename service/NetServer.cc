@@ -28,6 +28,8 @@
 
 using namespace Pds;
 
+static const size_t MaxDatagram = 0x10000;  // IP limit on a UDP datagram
+
 /*
 ** ++
 **
@@ -47,11 +49,21 @@ void NetServer::_construct(int sizeofDatagram, int maxPayload)
   {
   memset((void*)&_hdr, 0, sizeof(_hdr));
 
+  _mhdr     = 0;
+  _miov     = 0;
+  _mbuffer  = 0;
+  _mdepth   = 0;
+  _mhead    = 0;
+  _mcount   = 0;
+  _mbatches = 0;
+  _mbatched = 0;
+
   _hdr.msg_name         = (caddr_t)&_src;
   _hdr.msg_namelen      = sizeof(_src);
   _hdr.msg_iov          = &_iov[0];
 
   _hdro = _hdr;
+  _hdro.msg_iovlen      = 1;  // header only
 
   if((_sizeofDatagram = sizeofDatagram))
     {
@@ -180,6 +192,12 @@ NetServer::NetServer(unsigned id,
 
 int NetServer::fetch      (char* payload, int flags)
   {
+  if (_mdepth)
+    {
+    int length = _fetch_batch(payload, _maxPayload, flags);
+    return length > int(_maxPayload) ? int(_maxPayload) : length;
+    }
+
   *_payload  = payload;
 
   int length = recvmsg(_socket, &_hdr, flags);
@@ -202,6 +220,203 @@ int NetServer::fetch      (char* payload, int flags)
   return length;
   }
 
+/*
+** ++
+**
+**    Enable (depth > 0) or disable (depth = 0) batched receives for
+**    "fetch".  A ring of "depth" buffers, each large enough for a header
+**    and maximum payload (but no larger than the largest UDP datagram, so
+**    servers with large payloads reassembled from many datagrams do not
+**    reserve a payload per slot), is posted to the socket with a single
+**    "recvmmsg" whenever the ring is empty; the header of each buffered
+**    datagram is then presented through "datagram" and its payload is
+**    copied to the caller's buffer on fetch.  The batch size may only be
+**    changed when no datagrams are buffered.  Returns zero if successful,
+**    otherwise an error number.
+**
+** --
+*/
+
+int NetServer::batch(unsigned depth)
+  {
+  if (_mcount) return EBUSY;
+
+  delete[] _mhdr;
+  delete[] _miov;
+  delete[] _mbuffer;
+  _mhdr    = 0;
+  _miov    = 0;
+  _mbuffer = 0;
+  _mhead   = 0;
+
+  if ((_mdepth = depth))
+    {
+    size_t sizeofBuffer = sizeofDatagram() + _maxPayload;
+    if (sizeofBuffer > MaxDatagram)  // no larger datagram can arrive
+      sizeofBuffer = MaxDatagram;
+    _mhdr    = new struct mmsghdr[depth];
+    _miov    = new struct iovec  [depth];
+    _mbuffer = new char[depth*sizeofBuffer];
+    memset((void*)_mhdr, 0, depth*sizeof(struct mmsghdr));
+    for(unsigned i=0; i<depth; i++)
+      {
+      _miov[i].iov_base            = _mbuffer + i*sizeofBuffer;
+      _miov[i].iov_len             = sizeofBuffer;
+      _mhdr[i].msg_hdr.msg_iov     = &_miov[i];
+      _mhdr[i].msg_hdr.msg_iovlen  = 1;
+      }
+    }
+  return 0;
+  }
+
+/*
+** ++
+**
+**    Batched version of "fetch" (see above).  Only when the ring has been
+**    emptied is the socket read; MSG_WAITFORONE makes a blocking read
+**    return as soon as one datagram has arrived.
+**
+** --
+*/
+
+int NetServer::_fill_batch(int flags)
+  {
+  int n = recvmmsg(_socket, _mhdr, _mdepth, flags | MSG_WAITFORONE, 0);
+  if (n < 0)
+    {
+    printf("NetServer::fetch failed flags %x  socket %d\n",
+           flags, _socket);
+    handleError(errno);
+    return n;
+    }
+  _mhead     = 0;
+  _mcount    = n;
+  _mbatches++;
+  _mbatched += n;
+  return n;
+  }
+
+int NetServer::_fetch_batch(char* payload, int size, int flags)
+  {
+  if (!_mcount)
+    {
+    int n = _fill_batch(flags);
+    if (n <= 0) return n;
+    }
+
+  const struct mmsghdr& m = _mhdr[_mhead];
+  char* buffer = (char*)m.msg_hdr.msg_iov[0].iov_base;
+  int length = m.msg_len;
+  _mhead++;
+  _mcount--;
+
+  int header = sizeofDatagram();
+
+#ifdef ODF_LITTLE_ENDIAN
+  unsigned* buf = (unsigned*)buffer;
+  unsigned* end = buf + (length >> 2);
+  while (buf < end) {
+    *buf = ntohl(*buf);
+    buf++;
+  }
+#endif
+
+  if (length < header)
+    {
+    memcpy(_datagram, buffer, length);
+    return 0;
+    }
+
+  //  The payload is copied once, from the ring to its place.  Datagrams
+  //  of one contribution (Mtu sized chunks) and of one event land in
+  //  separate slots, so the event cannot be built in the ring itself.
+  if (header)
+    memcpy(_datagram, buffer, header);
+  length -= header;
+  if (length)
+    memcpy(payload, buffer+header, length < size ? length : size);
+
+  return length;
+  }
+
+/*
+** ++
+**
+**    As "fetch" (see above), but receives no more than "size" bytes of
+**    payload, for callers whose buffer is smaller than the server's
+**    maximum payload.  A larger datagram is consumed and discarded;
+**    -1 is returned with errno set to EMSGSIZE.
+**
+** --
+*/
+
+int NetServer::fetch(char* payload, int size, int flags)
+  {
+  int length;
+  if (_mdepth)
+    length = _fetch_batch(payload, size, flags);
+  else
+    {
+    struct iovec& iov = _iov[_hdr.msg_iovlen-1];
+    size_t maxPayload = iov.iov_len;
+    if (_maxPayload && size < int(_maxPayload))
+      iov.iov_len = size;
+    length = NetServer::fetch(payload, flags | MSG_TRUNC);
+    iov.iov_len = maxPayload;
+    }
+
+  if (length > size)
+    {
+    errno = EMSGSIZE;
+    return -1;
+    }
+  return length;
+  }
+
+/*
+** ++
+**
+**    Receives the header of the next datagram into the buffer returned
+**    by "datagram", without consuming the datagram; the following
+**    "fetch" returns the same datagram.  This lets the caller choose
+**    where the payload is to land before receiving it.  When batching,
+**    the header is taken from the ring (filling it if empty); otherwise
+**    the socket is read with MSG_PEEK into the header buffer alone.
+**    Returns the size of the header received, or -1 on error (errno is
+**    EAGAIN when nothing has arrived).
+**
+** --
+*/
+
+int NetServer::peek(int flags)
+  {
+#ifdef ODF_LITTLE_ENDIAN
+  errno = ENOTSUP;   // the header is swapped on fetch
+  return -1;
+#endif
+  int header = sizeofDatagram();
+  if (!header)
+    {
+    errno = ENOTSUP;
+    return -1;
+    }
+
+  if (_mdepth)
+    {
+    if (!_mcount && _fill_batch(flags) <= 0)
+      {
+      if (!_mcount) errno = EAGAIN;
+      return -1;
+      }
+    const struct mmsghdr& m = _mhdr[_mhead];
+    int length = m.msg_len < unsigned(header) ? m.msg_len : header;
+    memcpy(_datagram, m.msg_hdr.msg_iov[0].iov_base, length);
+    return length;
+    }
+
+  return recvmsg(_socket, &_hdro, flags | MSG_PEEK);
+  }
+
 /*
 ** ++
 **
@@ -345,6 +560,9 @@ NetServer::~NetServer()
   {
     resign();
     delete [] _datagram;
+    delete [] _mhdr;
+    delete [] _miov;
+    delete [] _mbuffer;
 #ifdef ODF_LITTLE_ENDIAN
     delete [] _swap_buffer;
 #endif
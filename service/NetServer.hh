@@ -33,8 +33,20 @@ class NetServer : public Port, public OobServer
   public:
     virtual int      pend        (int flag = 0);
     virtual int      fetch       (char* payload, int flags);
+    int              fetch       (char* payload, int size, int flags);
   public:
     const char* datagram() const;
+  public:
+    //  Batched receive: "fetch" drains up to "depth" datagrams from the
+    //  socket per system call into an internal ring, and subsequent
+    //  fetches are satisfied from the ring until it is empty.
+    int      batch   (unsigned depth);
+    unsigned buffered() const;
+    unsigned batches () const;
+    unsigned batched () const;
+    //  Header-only receive: presents the header of the next datagram
+    //  through "datagram" while leaving the datagram for "fetch".
+    int      peek    (int flags);
   private:
     virtual char*    payload();
     virtual int      commit(char* datagram,
@@ -52,6 +64,8 @@ class NetServer : public Port, public OobServer
     enum {SendFlags = 0};
   private:
     void _construct(int sizeofDatagram, int maxPayload);
+    int  _fetch_batch(char* payload, int size, int flags);
+    int  _fill_batch (int flags);
   private:
     char*              _datagram;       // -> buffer for current  datagram
     char**             _payload;        // Pointer to -> buffer current payload
@@ -68,6 +82,15 @@ class NetServer : public Port, public OobServer
     };
     std::list<McastSubscription> _mcasts;
 
+    struct mmsghdr*    _mhdr;           // Batched receive descriptors
+    struct iovec*      _miov;           // Batched receive buffer descriptions
+    char*              _mbuffer;        // Batched receive buffers
+    unsigned           _mdepth;         // # of batched receive buffers
+    unsigned           _mhead;          // Next buffered datagram to fetch
+    unsigned           _mcount;         // # of buffered datagrams remaining
+    unsigned           _mbatches;       // # of batched receive calls
+    unsigned           _mbatched;       // # of datagrams received in batches
+
 #ifdef ODF_LITTLE_ENDIAN
     char* _swap_buffer;
     void _swap(int length);
@@ -86,4 +109,19 @@ inline const char* Pds::NetServer::datagram() const
   return _datagram;
   }
 
+inline unsigned Pds::NetServer::buffered() const
+  {
+  return _mcount;
+  }
+
+inline unsigned Pds::NetServer::batches() const
+  {
+  return _mbatches;
+  }
+
+inline unsigned Pds::NetServer::batched() const
+  {
+  return _mbatched;
+  }
+
 #endif
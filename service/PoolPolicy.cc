@@ -0,0 +1,149 @@
+#include "PoolPolicy.hh"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB     0x40000
+#endif
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT  26
+#endif
+#ifndef MADV_HUGEPAGE
+#define MADV_HUGEPAGE   14
+#endif
+
+//  From <linux/mempolicy.h>, to avoid depending upon libnuma
+static const int mpol_preferred = 1;
+
+using namespace Pds;
+
+static const unsigned page_shift[] = { 12, 21, 30 };
+
+static size_t round_up(size_t size, unsigned shift)
+{
+  size_t mask = (size_t(1)<<shift)-1;
+  return (size+mask)&~mask;
+}
+
+static char* map(size_t size, PoolPolicy::Pages pages)
+{
+  int flags = MAP_PRIVATE|MAP_ANONYMOUS;
+  if (pages != PoolPolicy::Normal)
+    flags |= MAP_HUGETLB | (page_shift[pages]<<MAP_HUGE_SHIFT);
+  void* p = mmap(0, size, PROT_READ|PROT_WRITE, flags, -1, 0);
+  return p==MAP_FAILED ? 0 : (char*)p;
+}
+
+char* PoolPolicy::allocate(size_t size, size_t& mapped) const
+{
+  if (_pages==Normal && _node==AnyNode && !_prefault) {
+    mapped = 0;
+    return new char[size];
+  }
+
+  //  Try the requested page size and fall back to smaller pages
+  char* buffer = 0;
+  int pages = _pages;
+  for(; pages>=Normal; pages--) {
+    mapped = round_up(size, page_shift[pages]);
+    if ((buffer = map(mapped, Pages(pages))))
+      break;
+  }
+  if (!buffer) {
+    printf("PoolPolicy::allocate failed to map %zu bytes : %s\n",
+           size, strerror(errno));
+    mapped = 0;
+    return new char[size];
+  }
+  if (pages != _pages)
+    printf("PoolPolicy::allocate %uKB pages unavailable for %zu bytes.  Using %uKB pages.\n",
+           1U<<(page_shift[_pages]-10), size, 1U<<(page_shift[pages]-10));
+  if (pages == Normal)
+    madvise(buffer, mapped, MADV_HUGEPAGE);
+
+  if (_node != AnyNode) {
+    unsigned long nodemask[4];
+    memset(nodemask, 0, sizeof(nodemask));
+    const unsigned bits = 8*sizeof(unsigned long);
+    if (unsigned(_node) < 4*bits) {
+      nodemask[_node/bits] = 1UL<<(_node%bits);
+      if (syscall(SYS_mbind, buffer, mapped, mpol_preferred,
+                  nodemask, 4*bits, 0) < 0)
+        printf("PoolPolicy::allocate mbind to node %d failed : %s\n",
+               _node, strerror(errno));
+    }
+  }
+
+  //  Fault in the pages now, from the node chosen above
+  if (_prefault) {
+    size_t step = size_t(1)<<page_shift[pages];
+    for(size_t offset=0; offset<mapped; offset+=step)
+      *(volatile char*)(buffer+offset) = 0;
+  }
+
+  return buffer;
+}
+
+void PoolPolicy::release(char* buffer, size_t mapped)
+{
+  if (mapped)
+    munmap(buffer, mapped);
+  else
+    delete[] buffer;
+}
+
+/*
+** ++
+**
+**   Looks up the interface holding "ipaddress" and returns the NUMA node
+**   of its PCI device, or AnyNode if that can't be determined.
+**
+** --
+*/
+
+int PoolPolicy::nodeOfInterface(int ipaddress)
+{
+  int node = AnyNode;
+  struct ifaddrs* ifap;
+  if (getifaddrs(&ifap) < 0)
+    return node;
+
+  for(struct ifaddrs* ifa=ifap; ifa; ifa=ifa->ifa_next) {
+    if (ifa->ifa_addr==0 || ifa->ifa_addr->sa_family!=AF_INET)
+      continue;
+    const sockaddr_in* sa = (const sockaddr_in*)ifa->ifa_addr;
+    if (int(ntohl(sa->sin_addr.s_addr)) != ipaddress)
+      continue;
+
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/class/net/%s/device/numa_node", ifa->ifa_name);
+    FILE* f = fopen(path, "r");
+    if (f) {
+      if (fscanf(f, "%d", &node) != 1 || node < 0)
+        node = AnyNode;
+      fclose(f);
+    }
+    break;
+  }
+
+  freeifaddrs(ifap);
+  return node;
+}
+
+int PoolPolicy::nodeOfCaller()
+{
+  unsigned cpu, node;
+  if (syscall(SYS_getcpu, &cpu, &node, 0) < 0)
+    return AnyNode;
+  return int(node);
+}
@@ -0,0 +1,55 @@
+#ifndef PDS_POOLPOLICY_HH
+#define PDS_POOLPOLICY_HH
+
+#include <stddef.h>
+
+/*
+** ++
+**
+**   Describes how the backing store of a pool is obtained: the page size,
+**   the NUMA node the memory should be placed on, and whether the pages
+**   should be faulted in when the pool is constructed rather than on first
+**   use.  Hugepages are taken from the hugetlb pool when it has enough
+**   pages of the requested size; otherwise the next smaller size is tried,
+**   ending with normal pages advised for transparent hugepages.  The
+**   default policy keeps the plain heap allocation.
+**
+** --
+*/
+
+namespace Pds {
+class PoolPolicy
+  {
+  public:
+    enum Pages { Normal, Huge2MB, Huge1GB };
+    enum { AnyNode = -1 };
+    PoolPolicy(Pages pages=Normal, int node=AnyNode, bool prefault=false);
+  public:
+    Pages pages()    const;
+    int   node()     const;
+    bool  prefault() const;
+  public:
+    //  Returns the backing store and the size of its mapping ("mapped"),
+    //  which is zero for heap allocations.
+    char*       allocate(size_t size, size_t& mapped) const;
+    static void release (char* buffer, size_t mapped);
+  public:
+    static int  nodeOfInterface(int ipaddress); // node owning the NIC
+    static int  nodeOfCaller();                 // node of the calling thread's cpu
+  private:
+    Pages _pages;
+    int   _node;
+    bool  _prefault;
+  };
+}
+
+inline Pds::PoolPolicy::PoolPolicy(Pages pages, int node, bool prefault) :
+  _pages(pages), _node(node), _prefault(prefault)
+  {
+  }
+
+inline Pds::PoolPolicy::Pages Pds::PoolPolicy::pages() const { return _pages; }
+inline int  Pds::PoolPolicy::node    () const { return _node; }
+inline bool Pds::PoolPolicy::prefault() const { return _prefault; }
+
+#endif
@@ -49,6 +49,7 @@ using namespace Pds;
 RingPool::RingPool(const size_t size,
                          const size_t wrap) :
   _allocatedList(),
+  _mapped(0),
   _pool(new char[size]),                // Naturally quadword aligned
   _size(size),
   _wrap(&_pool[size - wrap - sizeof(RingEntry)]),
@@ -70,6 +71,7 @@ RingPool::RingPool(const size_t size,
                          const size_t wrap,
                          VoidFuncPtr  freeFn) :
   _allocatedList(),
+  _mapped(0),
   _pool(new char[size]),                // Naturally quadword aligned
   _size(size),
   _wrap(&_pool[size - wrap - sizeof(RingEntry)]),
@@ -87,6 +89,28 @@ RingPool::RingPool(const size_t size,
   if (wrap & 0x7)             _bugCheck("wrap", wrap);
 }
 
+RingPool::RingPool(const size_t      size,
+                   const size_t      wrap,
+                   const PoolPolicy& policy) :
+  _allocatedList(),
+  _mapped(0),
+  _pool(policy.allocate(size, _mapped)),  // Page aligned when mapped
+  _size(size),
+  _wrap(&_pool[size - wrap - sizeof(RingEntry)]),
+  _next(_pool),
+  _freeFn(&RingPool::_free),
+  _frees(0),
+  _allocs(0),
+  _empties(0),
+  _atHeads(0),
+  _maxSize(0)
+{
+  if (!_pool)                 _bugCheck(size);
+  if (!wrap || wrap >= size)  _bugCheck(wrap, size);
+  if (size & 0x7)             _bugCheck("size", size);
+  if (wrap & 0x7)             _bugCheck("wrap", wrap);
+}
+
 void RingPool::_bugCheck(const size_t size) const
 {
   char msg[128];
@@ -380,7 +404,7 @@ void RingPool::free(void* buffer)
 
 RingPool::~RingPool()
 {
-  delete[] _pool;
+  PoolPolicy::release(_pool, _mapped);
 }
 
 /*
@@ -23,6 +23,7 @@
 
 #include <stddef.h>                     // for size_t
 #include "Queue.hh"
+#include "PoolPolicy.hh"
 
 typedef void (*VoidFuncPtr)(void* entry, void* buffer);
 
@@ -35,6 +36,7 @@ class RingPool
 public:
   RingPool(const size_t size, const size_t wrap);
   RingPool(const size_t size, const size_t wrap, VoidFuncPtr freeFn);
+  RingPool(const size_t size, const size_t wrap, const PoolPolicy& policy);
   ~RingPool();
 public:
          void*  alloc(const size_t minSize, size_t* size);
@@ -66,6 +68,7 @@ private:
   void          _bugCheck(const char*  name, const size_t size) const;
 private:
   Queue<RingEntry> _allocatedList;// Listhead of free buffer entries
+  size_t                 _mapped;       // Size of the pool's mapping (0 if heap)
   char* const            _pool;         // Pool from which to allocate
   const size_t           _size;         // Size of the pool
   char* const            _wrap;         // Point after which to go back to top
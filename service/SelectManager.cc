@@ -22,6 +22,9 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
 
 using namespace Pds;
 
@@ -98,10 +101,12 @@ void SelectManager<T>::_verify() const
 template<class T>
 SelectManager<T>::SelectManager(OobServer& oobServer, unsigned timeout) :
   _timeout(timeout),
-  _oobServer(oobServer)
+  _oobServer(oobServer),
+  _epollFd(-1)
   {
   _managedList.clearAll();
   _activeList .clearAll();
+  _polledList .clearAll();
   _ioList            = (char*)&_ioListBuffer;
 
   memset(&_ioListBuffer, 0, sizeof(_ioListBuffer));
@@ -110,6 +115,13 @@ SelectManager<T>::SelectManager(OobServer& oobServer, unsigned timeout) :
   enable(&oobServer);
   }
 
+template<class T>
+SelectManager<T>::~SelectManager()
+{
+  if (_epollFd >= 0)
+    ::close(_epollFd);
+}
+
 /*
 ** ++
 **
@@ -154,6 +166,9 @@ int SelectManager<T>::manage(T* server)
   _servers[server->id()] = server;
   _managedList           = managedList | id;
 
+  if (_epollFd >= 0)
+    _epollCtl(EPOLL_CTL_ADD, socket, server->id(), 0);
+
   return 1;
 }
 
@@ -189,7 +204,10 @@ int SelectManager<T>::arm(T* server)
 
   _activeList = active | id;
 
-  enable(server);
+  if (_epollFd >= 0)
+    _epollSync();
+  else
+    enable(server);
 
   _verify();
 
@@ -209,12 +227,14 @@ int SelectManager<T>::arm(T* server)
 template<class T>
 EbBitMask SelectManager<T>::arm(EbBitMask mask)
   {
-  EbBitMask    id(EbBitMask::ONE);
-  T**             server    = &_servers[0]; 
   EbBitMask    managed   = _managedList & mask;
-  EbBitMask    remaining = managed;
 
-  _activeList = remaining;
+  _activeList = managed;
+
+  if (_epollFd >= 0) {
+    _epollSync();
+    return managed;
+  }
 
 #if 1
   // Keep _ioList and _activeList in sync
@@ -222,13 +242,8 @@ EbBitMask SelectManager<T>::arm(EbBitMask mask)
   enable(&_oobServer);
 #endif
 
-  do
-    {
-    if((id & remaining).isZero()) continue;
-    enable(*server);
-    remaining &= ~id;
-    }
-  while(server++, (id <<= 1).isNotZero(), remaining.isNotZero());
+  for(unsigned i=managed.first(); i<EbBitMask::BitMaskBits; i=managed.next(i))
+    enable(_servers[i]);
 
   _verify();
 
@@ -263,7 +278,10 @@ EbBitMask SelectManager<T>::safe(T* server)
   if(on.isNotZero())
     {
     _activeList = active & ~id;
-    disable(server);
+    if (_epollFd >= 0)
+      _epollSync();
+    else
+      disable(server);
     }
 
   _verify();
@@ -292,6 +310,8 @@ T* SelectManager<T>::unmanage(T* thisServer)
 	{
 	  _managedList = managed & ~id;
 	  safe(server);
+	  if (_epollFd >= 0)
+	    _epollCtl(EPOLL_CTL_DEL, server->fd(), server->id(), 0);
 	  server->disconnect();
 	}
     }
@@ -326,28 +346,23 @@ int SelectManager<T>::_dispatchIo()
       }
     }
   EbBitMask active    = _activeList;
-  EbBitMask id(EbBitMask::ONE);
-  T**  next    = _servers;
   T*   server;
 
   remaining &= active; // some servers may have been deleted
 
-  do
+  for(unsigned i=remaining.first(); i<EbBitMask::BitMaskBits; i=remaining.next(i))
     {
-    if((id & remaining).isZero()) continue;
-    server = *next;    
+    server = _servers[i];
     if(disable(server)) {
       if(!processIo(server)) {
-        active &= ~id;
+        active.clearBit(i);
       }
       else
         enable(server);
     }
     else
       enable(server);
-    remaining &= ~id;
     }
-  while(next++, (id <<= 1).isNotZero(), remaining.isNotZero());
 
   _activeList = active;
 
@@ -356,6 +371,110 @@ int SelectManager<T>::_dispatchIo()
   return 1;
 }
 
+/*
+** ++
+**
+**    These functions replace the "select" database with an epoll instance
+**    (see "ServerManager::multiplexer").  Every managed server is registered
+**    with the instance, with input events only while it is armed, so that
+**    a poll only reports the armed servers and the out-of-band server.
+**    Registration is level-triggered, since a server reads one datagram
+**    each time its I/O is processed.  Arming or making safe the servers
+**    changes only the registrations of those whose state changed.
+**
+** --
+*/
+
+static const unsigned OobId = EbBitMask::BitMaskBits;
+
+template<class T>
+int SelectManager<T>::epoll(bool on)
+{
+  if (on == (_epollFd >= 0)) return 0;
+
+  if (!on) {
+    ::close(_epollFd);
+    _epollFd = -1;
+    _polledList.clearAll();
+    arm(_activeList);
+    return 0;
+  }
+
+  _epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (_epollFd < 0) {
+    int err = errno;
+    printf("SelectManager::epoll failed to create instance: %s\n", strerror(err));
+    return err;
+  }
+
+  _epollCtl(EPOLL_CTL_ADD, _oobServer.fd(), OobId, EPOLLIN);
+  for(unsigned i=_managedList.first(); i<EbBitMask::BitMaskBits; i=_managedList.next(i))
+    _epollCtl(EPOLL_CTL_ADD, _servers[i]->fd(), i, 0);
+  _polledList.clearAll();
+  _epollSync();
+  return 0;
+}
+
+template<class T>
+void SelectManager<T>::_epollCtl(int op, int fd, unsigned id, unsigned events)
+{
+  epoll_event ev;
+  ev.events   = events;
+  ev.data.u64 = id;
+  if (epoll_ctl(_epollFd, op, fd, &ev) < 0)
+    printf("SelectManager::epoll_ctl(%d) fd %d failed: %s\n", op, fd, strerror(errno));
+}
+
+template<class T>
+void SelectManager<T>::_epollSync()
+{
+  EbBitMask armed   = _activeList & _managedList;
+  EbBitMask changed = (armed & ~_polledList) | (_polledList & ~armed);
+
+  for(unsigned i=changed.first(); i<EbBitMask::BitMaskBits; i=changed.next(i))
+    _epollCtl(EPOLL_CTL_MOD, _servers[i]->fd(), i, armed.hasBitSet(i) ? EPOLLIN : 0);
+
+  _polledList = armed;
+}
+
+/*
+** ++
+**
+**    As "_dispatchIo", for the events returned by "epoll_wait".  The ready
+**    servers are processed in the order of their IDs, as with "select".
+**
+** --
+*/
+
+template<class T>
+int SelectManager<T>::_dispatchEpoll(const epoll_event* events, int n)
+{
+  EbBitMask ready;
+  bool      oob = false;
+  for(int k=0; k<n; k++) {
+    unsigned id = events[k].data.u64;
+    if (id == OobId)
+      oob = true;
+    else
+      ready.setBit(id);
+  }
+
+  if (oob && !_oobServer.pend())
+    return 0;
+
+  EbBitMask active    = _activeList;
+  EbBitMask remaining = ready & active;
+
+  for(unsigned i=remaining.first(); i<EbBitMask::BitMaskBits; i=remaining.next(i))
+    if (!processIo(_servers[i]))
+      active.clearBit(i);
+
+  _activeList = active;
+  _epollSync();
+
+  return 1;
+}
+
 template<class T>
 void SelectManager<T>::dump() const
 {
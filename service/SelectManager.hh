@@ -41,12 +41,14 @@
 #include "EbBitMask.hh"
 #include "OobServer.hh"
 
+struct epoll_event;
+
 namespace Pds {
 template<class T> class SelectManager
 {
 public:
   SelectManager(OobServer& oobServer, unsigned timeout);
-  virtual ~SelectManager() {}
+  virtual ~SelectManager();
 
 public:
   EbBitMask arm(EbBitMask mask = EbBitMask(EbBitMask::FULL));
@@ -74,8 +76,17 @@ protected:
   fd_set* ioList() {return (fd_set*)_ioList;}
   int _dispatchIo();
 
+  //  Multiplexing with epoll rather than select.  The armed servers are
+  //  registered for input, the others are registered without events.
+  //  Returns zero, or the error of creating the epoll instance.
+  int  epoll(bool);
+  int  epollFd() const {return _epollFd;}
+  int  _dispatchEpoll(const epoll_event*, int);
+
 private:
   void _verify() const;
+  void _epollSync();
+  void _epollCtl(int op, int fd, unsigned id, unsigned events);
 
 private:
   LinkedList<T> _managed;      // Listhead of managed servers
@@ -86,6 +97,8 @@ private:
   unsigned         _timeout;      // Timeout definition for "select" 
   T*               _servers[EbBitMask::BitMaskBits];  // Lookup table of servers (by ID)
   OobServer&       _oobServer;
+  int              _epollFd;      // epoll instance, or -1 for select
+  EbBitMask        _polledList;   // Bit-list of servers registered for input
 };
 }
 /*
@@ -20,8 +20,19 @@
 
 #include "ServerManager.hh"
 
+#include <sys/epoll.h>
+#include <time.h>
+
 using namespace Pds;
 
+static bool expired(const timespec& end)
+{
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec > end.tv_sec ||
+    (now.tv_sec == end.tv_sec && now.tv_nsec >= end.tv_nsec);
+}
+
 /*
 ** ++
 **
@@ -45,7 +56,8 @@ ServerManager::ServerManager(const Ins& ins,
 			     unsigned      timeout,
 			     int           maxDatagrams) :
   NetServer((unsigned) -1, ins, sizeofDatagram, maxPayload, maxDatagrams),
-  SelectManager<Server>(*this, timeout)
+  SelectManager<Server>(*this, timeout),
+  _multiplexer(UseSelect)
   {
     dotimeout(timeout);
   }
@@ -56,7 +68,8 @@ ServerManager::ServerManager(int          sizeofDatagram,
 			     unsigned     timeout,
 			     int          maxDatagrams) :
   NetServer((unsigned) -1, sizeofDatagram, maxPayload, maxDatagrams),
-  SelectManager<Server>(*this, timeout)
+  SelectManager<Server>(*this, timeout),
+  _multiplexer(UseSelect)
   {
     dotimeout(timeout);
   }
@@ -78,6 +91,9 @@ ServerManager::ServerManager(int          sizeofDatagram,
 
 int ServerManager::poll()
   {
+    if (_multiplexer != UseSelect)
+      return _pollEpoll();
+
     fd_set* const readfds = ioList();
     fd_set* const writfds = 0;
     fd_set* const excefds = 0;
@@ -104,6 +120,63 @@ int ServerManager::poll()
       }
   }
 
+/*
+** ++
+**
+**    As "poll", with "epoll_wait".  When busy-polling, the wait does not
+**    sleep, but repeats until a server is ready or the timeout expires.
+**
+** --
+*/
+
+int ServerManager::_pollEpoll()
+  {
+    enum { MaxEvents = 64 };
+    epoll_event events[MaxEvents];
+
+    int n;
+    if (_multiplexer == UseEpollBusyPoll)
+      {
+      timespec end;
+      if (_tmoptr)
+        {
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        end.tv_sec  += _tmoBuffer.tv_sec;
+        end.tv_nsec += _tmoBuffer.tv_usec*1000;
+        if (end.tv_nsec >= 1000000000) { end.tv_sec++; end.tv_nsec -= 1000000000; }
+        }
+      do
+        n = epoll_wait(epollFd(), events, MaxEvents, 0);
+      while (n == 0 && !(_tmoptr && expired(end)));
+      }
+    else
+      {
+      int tmo = _tmoptr ? _tmoBuffer.tv_sec*1000 + _tmoBuffer.tv_usec/1000 : -1;
+      n = epoll_wait(epollFd(), events, MaxEvents, tmo);
+      }
+
+    if ( n > 0 )
+      {
+	return _dispatchEpoll(events, n);
+      }
+    else if ( n == 0 )    
+      {
+	return processTmo();
+      }
+    else 
+      {
+	return 1;
+      }
+  }
+
+int ServerManager::multiplexer(Multiplexer m)
+{
+  int err = SelectManager<Server>::epoll(m != UseSelect);
+  if (!err)
+    _multiplexer = m;
+  return err;
+}
+
 void ServerManager::dotimeout(unsigned timeout) 
 {
   _tmoBuffer.tv_usec = (timeout%1000)*1000;
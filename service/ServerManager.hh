@@ -61,12 +61,23 @@ public:
   void dotimeout();
   void donottimeout();
 
+  //  How "poll" waits on the servers: "select" (the default), "epoll", or
+  //  "epoll" without sleeping, for the latency-critical.  Like the other
+  //  database functions, it is not to be called while waiting.
+  enum Multiplexer { UseSelect, UseEpoll, UseEpollBusyPoll };
+  int         multiplexer(Multiplexer);
+  Multiplexer multiplexer() const {return _multiplexer;}
+
   // Implements Select
   virtual int poll();
 
+private:
+  int _pollEpoll();
+
 private:
   struct timeval  _tmoBuffer;    // Timeout definition for "select" 
   struct timeval* _tmoptr;       // Pointer to tmo struct (can be null)
+  Multiplexer     _multiplexer;
 };
 }
 #endif
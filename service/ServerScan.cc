@@ -35,14 +35,8 @@ void ServerScan<T>::iterate(EbBitMask servers)
   {   
   T**               server    = _list->table(); 
   EbBitMask      remaining = servers & _list->managed();
-  EbBitMask      id(EbBitMask::ONE);
 
-  do
-    {
-    if((id & remaining).isZero()) continue;
-    process(*server);
-    remaining &= ~id;
-    }
-  while(server++, (id <<= 1).isNotZero(), remaining.isNotZero());
+  for(unsigned i=remaining.first(); i<EbBitMask::BitMaskBits; i=remaining.next(i))
+    process(server[i]);
   }
 
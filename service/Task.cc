@@ -2,6 +2,7 @@
 #include "Semaphore.hh"
 
 #include "Task.hh"
+#include <sched.h>
 
 using namespace Pds;
 
@@ -17,6 +18,25 @@ Task::Task(const TaskObject& tobj)
   _refCount = new int(1);
   _jobs = new Queue<Routine>;
   _pending = new Semaphore(Semaphore::EMPTY);
+  _ring = 0;
+
+  int err = createTask(*_taskObj, (TaskFunction) TaskMainLoop );
+  if ( err != 0 ) {
+    //error occured, throw exception
+  }
+}
+
+
+/*
+ *
+ */
+Task::Task(const TaskObject& tobj, unsigned depth, unsigned spin)
+{
+  _taskObj = new TaskObject(tobj);
+  _refCount = new int(1);
+  _jobs = new Queue<Routine>;
+  _pending = new Semaphore(Semaphore::EMPTY);
+  _ring = new TaskRing(depth, spin);
 
   int err = createTask(*_taskObj, (TaskFunction) TaskMainLoop );
   if ( err != 0 ) {
@@ -34,6 +54,7 @@ Task::Task(const Task& aTask)
   _taskObj = aTask._taskObj;
   _jobs = aTask._jobs;
   _pending = aTask._pending;
+  _ring = aTask._ring;
 }
 
 /*
@@ -45,6 +66,7 @@ void Task::operator =(const Task& aTask)
   _taskObj = aTask._taskObj;
   _jobs = aTask._jobs;
   _pending = aTask._pending;
+  _ring = aTask._ring;
 }
 
 /*
@@ -56,6 +78,8 @@ Task::Task(MakeThisATaskFlag dummy)
   _refCount = new int(1);
   _jobs = new Queue<Routine>;
   _pending = new Semaphore(Semaphore::EMPTY);
+  _ring = 0;
+  attach();
 }
 
 /*
@@ -107,9 +131,22 @@ const TaskObject& Task::parameters() const
  * Inserts an entry on the tasks processing queue.
  * give the jobs pending semaphore only when the queue goes empty to non-empty
  *
+ * With a ring work queue, wait for space when it is full unless called
+ * from the task itself.
  */
 void Task::call(Routine* routine)
 {
+  if (_ring) {
+    while(!_ring->insert(routine)) {
+      if (is_self()) {
+        _ring->overflow(routine);
+        return;
+      }
+      sched_yield();
+    }
+    return;
+  }
+
   if( _jobs->insert(routine) == _jobs->empty()) {
     _pending->give();
   }
@@ -135,6 +172,13 @@ void* Pds::TaskMainLoop(void* task)
   Task* t = (Task*) task;
   Routine *aJob;
 
+  t->attach();
+
+  if (t->_ring) {
+    for(;;)
+      t->_ring->wait()->routine();
+  }
+
   for(;;) {
     while( (aJob=t->_jobs->remove()) != t->_jobs->empty() ) {
       aJob->routine();
@@ -5,6 +5,7 @@
 #include "Semaphore.hh"
 #include "TaskObject.hh"
 #include "Routine.hh"
+#include "TaskRing.hh"
 
 
 namespace Pds {
@@ -42,6 +43,11 @@ class Task {
   Task(const TaskObject&);
   Task(const Task&);
 
+  // this ctor uses a lock-free ring of "depth" entries as the work
+  // queue.  The task thread polls "spin" times before sleeping when
+  // the ring is empty.
+  Task(const TaskObject&, unsigned depth, unsigned spin=0);
+
   // this ctor makes current task the Task.  make c++ signature
   // distinct so it isn't used by accident.
   enum MakeThisATaskFlag {MakeThisATask};
@@ -57,6 +63,9 @@ class Task {
 
   bool is_self() const;
 
+  // prints the cpu and scheduling of each running task
+  static void dump();
+
   friend class TaskDelete;
   friend void* TaskMainLoop(void*);
 
@@ -65,12 +74,15 @@ class Task {
   ~Task();
   int createTask( TaskObject&, TaskFunction );
   void deleteTask();
+  void attach();
+  void detach();
 
   TaskObject*        _taskObj;
   int*                  _refCount;
   Queue<Routine>* _jobs;
   Semaphore*         _pending;
   Routine*           _destroyRoutine;
+  TaskRing*          _ring;
 };
 }
 
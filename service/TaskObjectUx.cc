@@ -38,7 +38,9 @@ TaskObject::TaskObject(const char* name, int priority,
 			     int stackSize, char* stackBase) :
   _stacksize((size_t)stackSize), 
   _stackbase(stackBase),
-  _priority(priority)
+  _priority(priority),
+  _tid(0),
+  _policy(TaskPolicy::lookup(name))
 {
   _name = new char[strlen(name)+1];
   strcpy(_name, name);
@@ -73,7 +75,8 @@ TaskObject::TaskObject(const char* name, int priority,
 TaskObject::TaskObject() : 
   _name(0), 
   _stacksize(0), 
-  _stackbase(0)
+  _stackbase(0),
+  _tid(0)
 {
   pthread_attr_init(&_flags);
   _threadID = pthread_self();
@@ -98,6 +101,8 @@ TaskObject::TaskObject(const TaskObject& tobject )
   _priority = tobject._priority;
   memcpy(&_flags,&tobject._flags,sizeof(pthread_attr_t));
   memcpy(&_threadID,&tobject._threadID,sizeof(pthread_t));
+  _tid = tobject._tid;
+  _policy = tobject._policy;
 }
 
 /*
@@ -114,6 +119,8 @@ void TaskObject::operator= (const TaskObject& tobject)
   _priority = tobject._priority;
   memcpy(&_flags,&tobject._flags,sizeof(pthread_attr_t));
   memcpy(&_threadID,&tobject._threadID,sizeof(pthread_t));
+  _tid = tobject._tid;
+  _policy = tobject._policy;
 }
 
 /*
@@ -3,6 +3,9 @@
 
 #include <string.h>
 #include <pthread.h>
+#include <sys/types.h>
+
+#include "TaskPolicy.hh"
 
 namespace Pds {
 
@@ -17,6 +20,10 @@ class Task;
  *     of 0 to 255. The sense of this priority is opposite that for
  *     threads so the value is renormalized to the unix version inside
  *     the constructor.
+ *
+ * Note on policy: the cpu affinity and scheduler class are looked up
+ *     by task name (see TaskPolicy.hh) unless set explicitly before the
+ *     Task is created.
  */
 
 class TaskObject {
@@ -35,6 +42,9 @@ class TaskObject {
   char* stackBase() const {return (char*)_stackbase;}
   int stackSize() const {return _stacksize;}
   pthread_t taskID() const {return _threadID;}
+  pid_t threadID() const {return _tid;}  // kernel thread id, once running
+  const TaskPolicy& policy() const {return _policy;}
+  void policy(const TaskPolicy& p) {_policy = p;}
 
   friend class Task;
  private:
@@ -44,6 +54,8 @@ class TaskObject {
   int _priority;
   pthread_attr_t _flags;
   pthread_t _threadID;
+  pid_t _tid;
+  TaskPolicy _policy;
 };
 
 }
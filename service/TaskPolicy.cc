@@ -0,0 +1,244 @@
+#include "TaskPolicy.hh"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+using namespace Pds;
+
+namespace Pds {
+  class TaskRule {
+  public:
+    std::string name;
+    bool        prefix;
+    TaskPolicy  policy;
+  };
+}
+
+static std::vector<TaskRule> _rules;
+static pthread_mutex_t       _rules_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t        _rules_once = PTHREAD_ONCE_INIT;
+
+static cpu_set_t _isolated;
+static cpu_set_t _housekeeping;
+
+static const char* _sched_names[] = { "inherit", "other", "fifo", "rr" };
+
+//
+//  Parses a cpu list such as "0,2-5"
+//
+static bool parse_list(const char* p, cpu_set_t& cpus)
+{
+  CPU_ZERO(&cpus);
+  while(*p && *p!='\n') {
+    char* e;
+    unsigned lo = strtoul(p,&e,0), hi = lo;
+    if (e==p) return false;
+    if (*e=='-') {
+      p = e+1;
+      hi = strtoul(p,&e,0);
+      if (e==p) return false;
+    }
+    for(unsigned i=lo; i<=hi && i<CPU_SETSIZE; i++)
+      CPU_SET(i,&cpus);
+    if (*e==',') e++;
+    p = e;
+  }
+  return true;
+}
+
+static bool parse_cpus(const char* p, cpu_set_t& cpus)
+{
+  if      (strcmp(p,"isolated")==0)     cpus = _isolated;
+  else if (strcmp(p,"housekeeping")==0) cpus = _housekeeping;
+  else if (strcmp(p,"any")==0)          CPU_ZERO(&cpus);
+  else return parse_list(p,cpus);
+  return true;
+}
+
+static void read_topology()
+{
+  CPU_ZERO(&_isolated);
+  CPU_ZERO(&_housekeeping);
+
+  char line[256];
+  FILE* f = fopen("/sys/devices/system/cpu/isolated","r");
+  if (f) {
+    if (fgets(line,sizeof(line),f))
+      parse_list(line,_isolated);
+    fclose(f);
+  }
+
+  cpu_set_t online;
+  CPU_ZERO(&online);
+  if ((f = fopen("/sys/devices/system/cpu/online","r"))) {
+    if (fgets(line,sizeof(line),f))
+      parse_list(line,online);
+    fclose(f);
+  }
+  CPU_XOR(&_housekeeping, &online, &_isolated);
+  CPU_AND(&_housekeeping, &_housekeeping, &online);
+}
+
+//
+//  Appends the rules in "text", one per line
+//
+static void parse_rules(const char* text, const char* source)
+{
+  std::string s(text);
+  size_t pos = 0;
+  for(unsigned line=1; pos < s.size(); line++) {
+    size_t end = s.find('\n',pos);
+    if (end == std::string::npos) end = s.size();
+    std::string l = s.substr(pos,end-pos);
+    pos = end+1;
+
+    size_t c = l.find('#');
+    if (c != std::string::npos) l.erase(c);
+
+    char name[64], cpus[128], sched[16];
+    int  priority = TaskPolicy::DefaultPriority;
+    int  n = sscanf(l.c_str(),"%63s %127s %15s %d",name,cpus,sched,&priority);
+    if (n <= 0)
+      continue;
+    if (n < 2) {
+      printf("TaskPolicy %s:%u missing cpus\n",source,line);
+      continue;
+    }
+
+    TaskRule rule;
+    rule.name   = name;
+    rule.prefix = rule.name[rule.name.size()-1]=='*';
+    if (rule.prefix)
+      rule.name.erase(rule.name.size()-1);
+
+    cpu_set_t set;
+    if (!parse_cpus(cpus,set)) {
+      printf("TaskPolicy %s:%u bad cpu list \"%s\"\n",source,line,cpus);
+      continue;
+    }
+
+    TaskPolicy::Scheduler sch = TaskPolicy::Inherit;
+    if (n > 2) {
+      if      (strcmp(sched,"other")==0) sch = TaskPolicy::Other;
+      else if (strcmp(sched,"fifo" )==0) sch = TaskPolicy::Fifo;
+      else if (strcmp(sched,"rr"   )==0) sch = TaskPolicy::RoundRobin;
+      else {
+        printf("TaskPolicy %s:%u unknown scheduler \"%s\"\n",source,line,sched);
+        continue;
+      }
+    }
+
+    rule.policy = TaskPolicy(set, sch, priority);
+    _rules.push_back(rule);
+  }
+}
+
+static void load_rules()
+{
+  read_topology();
+
+  const char* path = getenv("PDS_TASK_POLICY");
+  if (path) {
+    FILE* f = fopen(path,"r");
+    if (!f)
+      printf("TaskPolicy failed to open %s\n",path);
+    else {
+      std::string text;
+      char buff[256];
+      while(fgets(buff,sizeof(buff),f))
+        text += buff;
+      fclose(f);
+      parse_rules(text.c_str(),path);
+    }
+  }
+
+  const char* env = getenv("PDS_TASK_AFFINITY");
+  if (env) {
+    std::string text(env);
+    for(size_t p=0; (p=text.find(';',p))!=std::string::npos; )
+      text[p] = '\n';
+    parse_rules(text.c_str(),"PDS_TASK_AFFINITY");
+  }
+}
+
+void TaskPolicy::apply(pthread_attr_t& attr, int priority) const
+{
+  if (pinned())
+    pthread_attr_setaffinity_np(&attr, sizeof(_cpus), &_cpus);
+
+  if (_sched != Inherit) {
+    static const int policies[] = { SCHED_OTHER, SCHED_OTHER, SCHED_FIFO, SCHED_RR };
+    int policy = policies[_sched];
+    int lo = sched_get_priority_min(policy);
+    int hi = sched_get_priority_max(policy);
+    struct sched_param param;
+    param.sched_priority = _priority==DefaultPriority ? priority : _priority;
+    if (param.sched_priority < lo) param.sched_priority = lo;
+    if (param.sched_priority > hi) param.sched_priority = hi;
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy (&attr, policy);
+    pthread_attr_setschedparam  (&attr, &param);
+  }
+}
+
+TaskPolicy TaskPolicy::lookup(const char* name)
+{
+  pthread_once(&_rules_once, load_rules);
+
+  TaskPolicy policy;
+  if (!name)
+    return policy;
+
+  pthread_mutex_lock(&_rules_lock);
+  for(unsigned i=0; i<_rules.size(); i++) {
+    const TaskRule& r = _rules[i];
+    if (r.prefix ? strncmp(name, r.name.c_str(), r.name.size())==0 :
+                   r.name == name) {
+      policy = r.policy;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&_rules_lock);
+  return policy;
+}
+
+void TaskPolicy::load(const char* rules)
+{
+  pthread_once(&_rules_once, load_rules);
+
+  pthread_mutex_lock(&_rules_lock);
+  _rules.clear();
+  parse_rules(rules,"TaskPolicy::load");
+  pthread_mutex_unlock(&_rules_lock);
+}
+
+bool TaskPolicy::isolated(unsigned cpu)
+{
+  pthread_once(&_rules_once, load_rules);
+  return cpu < CPU_SETSIZE && CPU_ISSET(cpu,&_isolated);
+}
+
+const char* TaskPolicy::name(Scheduler s)
+{
+  return _sched_names[s];
+}
+
+const char* TaskPolicy::format(const cpu_set_t& cpus, char* buff, unsigned size)
+{
+  unsigned len = 0;
+  buff[0] = 0;
+  for(unsigned i=0; i<CPU_SETSIZE && len<size; i++) {
+    if (!CPU_ISSET(i,&cpus)) continue;
+    unsigned j=i;
+    while(j+1<CPU_SETSIZE && CPU_ISSET(j+1,&cpus)) j++;
+    len += (j==i) ?
+      snprintf(buff+len, size-len, "%s%u", len ? ",":"", i) :
+      snprintf(buff+len, size-len, "%s%u-%u", len ? ",":"", i, j);
+    i = j;
+  }
+  return buff;
+}
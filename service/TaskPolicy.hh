@@ -0,0 +1,80 @@
+#ifndef PDS_TASKPOLICY_HH
+#define PDS_TASKPOLICY_HH
+
+#include <sched.h>
+#include <pthread.h>
+
+/*
+** ++
+**
+**   Describes where a task's thread may run and how it is scheduled: the
+**   set of cpus it is pinned to (empty for no pinning), the scheduler
+**   class, and the realtime priority.  The default policy leaves the
+**   thread as it was created before, inheriting from its creator.
+**
+**   Policies are looked up by task name from rules read once from the
+**   file named by $PDS_TASK_POLICY and then from $PDS_TASK_AFFINITY, where
+**   rules are separated by ';'.  One rule per line:
+**
+**     <name>[*]  <cpus>  [other|fifo|rr]  [priority]
+**
+**   The first rule whose name matches (a trailing '*' matches a prefix)
+**   applies.  <cpus> is a list such as "2,4-7", "isolated" for the cores
+**   isolated from the kernel scheduler (isolcpus), "housekeeping" for
+**   the others, or "any".  For example:
+**
+**     oEbDsp*  2-3           fifo  60
+**     FCAtsk   isolated
+**     *        housekeeping
+**
+**   keeps every task not named above off the isolated cores.
+**
+** --
+*/
+
+namespace Pds {
+class TaskPolicy
+  {
+  public:
+    enum Scheduler { Inherit, Other, Fifo, RoundRobin };
+    enum { DefaultPriority = -1 };
+    TaskPolicy();
+    TaskPolicy(const cpu_set_t& cpus, Scheduler sched=Inherit, int priority=DefaultPriority);
+  public:
+    bool             pinned   () const;
+    const cpu_set_t& cpus     () const;
+    Scheduler        scheduler() const;
+    int              priority () const;
+  public:
+    //  Sets the thread attributes; "priority" is used when the policy has none
+    void apply(pthread_attr_t&, int priority) const;
+  public:
+    static TaskPolicy  lookup  (const char* name);
+    static void        load    (const char* rules);  // replaces the rules
+    static bool        isolated(unsigned cpu);
+    static const char* name    (Scheduler);
+    static const char* format  (const cpu_set_t&, char* buff, unsigned size);
+  private:
+    cpu_set_t _cpus;
+    Scheduler _sched;
+    int       _priority;
+  };
+}
+
+inline Pds::TaskPolicy::TaskPolicy() :
+  _sched(Inherit), _priority(DefaultPriority)
+  {
+  CPU_ZERO(&_cpus);
+  }
+
+inline Pds::TaskPolicy::TaskPolicy(const cpu_set_t& cpus, Scheduler sched, int priority) :
+  _cpus(cpus), _sched(sched), _priority(priority)
+  {
+  }
+
+inline bool Pds::TaskPolicy::pinned() const { return CPU_COUNT(&_cpus)!=0; }
+inline const cpu_set_t& Pds::TaskPolicy::cpus() const { return _cpus; }
+inline Pds::TaskPolicy::Scheduler Pds::TaskPolicy::scheduler() const { return _sched; }
+inline int Pds::TaskPolicy::priority() const { return _priority; }
+
+#endif
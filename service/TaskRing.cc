@@ -0,0 +1,124 @@
+#include "TaskRing.hh"
+
+using namespace Pds;
+
+static inline void cpu_relax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+  asm volatile("pause" ::: "memory");
+#else
+  __sync_synchronize();
+#endif
+}
+
+TaskRing::TaskRing(unsigned depth, unsigned spin) :
+  _spin    (spin),
+  _tail    (0),
+  _head    (0),
+  _sleeping(0),
+  _sleeps  (0),
+  _wakeup  (Semaphore::EMPTY)
+{
+  unsigned size = 2;
+  while(size < depth) size <<= 1;
+  _mask  = size-1;
+  _slots = new Slot[size];
+  for(unsigned i=0; i<size; i++) {
+    _slots[i].seq     = i;
+    _slots[i].routine = 0;
+  }
+}
+
+TaskRing::~TaskRing()
+{
+  delete[] _slots;
+}
+
+/*
+ * Claim the slot at the tail by advancing the tail index, fill it, then
+ * publish it by setting its sequence one past its position.  A slot
+ * whose sequence lags its position hasn't been released by the consumer
+ * yet, i.e. the ring is full.
+ */
+bool TaskRing::insert(Routine* routine)
+{
+  unsigned pos = _tail;
+  Slot* slot;
+  for(;;) {
+    slot = &_slots[pos & _mask];
+    int dif = int(slot->seq - pos);
+    if (dif == 0) {
+      if (__sync_bool_compare_and_swap(&_tail, pos, pos+1))
+        break;
+      pos = _tail;
+    }
+    else if (dif < 0)
+      return false;
+    else
+      pos = _tail;
+  }
+
+  slot->routine = routine;
+  __sync_synchronize();
+  slot->seq = pos+1;
+
+  //  Order the publication above before the check of the consumer state
+  __sync_synchronize();
+  if (_sleeping && __sync_bool_compare_and_swap(&_sleeping, 1, 0))
+    _wakeup.give();
+
+  return true;
+}
+
+void TaskRing::overflow(Routine* routine)
+{
+  _overflow.insert(routine);
+}
+
+Routine* TaskRing::remove()
+{
+  Slot* slot = &_slots[_head & _mask];
+  if (slot->seq == _head+1) {
+    __sync_synchronize();
+    Routine* routine = slot->routine;
+    __sync_synchronize();
+    slot->seq = _head + _mask + 1;
+    _head++;
+    return routine;
+  }
+
+  Routine* routine = _overflow.remove();
+  return routine == _overflow.empty() ? 0 : routine;
+}
+
+/*
+ * Poll, then announce that we are going to sleep and look once more
+ * before doing so.  A producer which sees the announcement clears it
+ * and gives the semaphore; if we find work after announcing and a
+ * producer has already cleared the flag, take the extra give now so
+ * that it doesn't cause a spurious wakeup later.
+ */
+Routine* TaskRing::wait()
+{
+  Routine* routine;
+  for(;;) {
+    if ((routine = remove()))
+      return routine;
+
+    for(unsigned i=0; i<_spin; i++) {
+      if ((routine = remove()))
+        return routine;
+      cpu_relax();
+    }
+
+    _sleeping = 1;
+    __sync_synchronize();
+    if ((routine = remove())) {
+      if (!__sync_bool_compare_and_swap(&_sleeping, 1, 0))
+        _wakeup.take();
+      return routine;
+    }
+    _sleeps++;
+    _wakeup.take();
+  }
+}
@@ -0,0 +1,59 @@
+#ifndef PDS_TASKRING_HH
+#define PDS_TASKRING_HH
+
+#include "Queue.hh"
+#include "Routine.hh"
+#include "Semaphore.hh"
+
+/*
+ * A bounded, lock-free, multiple producer / single consumer ring of
+ * Routines which may replace the locked Queue+Semaphore pair as the
+ * work queue of a Task.
+ *
+ * Producers claim a slot with a compare-and-swap on the tail index and
+ * publish it by advancing the slot's sequence number; the consumer
+ * (the task's own thread) only reads.  When the ring is empty the
+ * consumer polls for "spin" iterations before sleeping on a semaphore,
+ * which producers give only when they find the consumer asleep.
+ *
+ * insert() fails when the ring is full.  Routines which the consumer
+ * posts to itself in that state go to an overflow queue instead, since
+ * the consumer can't wait for itself to make room.
+ */
+
+namespace Pds {
+class TaskRing {
+ public:
+  TaskRing(unsigned depth, unsigned spin=0);
+  ~TaskRing();
+
+  bool     insert  (Routine*);  // any thread; false if full
+  void     overflow(Routine*);  // consumer thread only
+  Routine* remove  ();          // consumer thread; 0 if empty
+  Routine* wait    ();          // consumer thread; blocks until not empty
+
+  unsigned depth() const { return _mask+1; }
+  unsigned sleeps() const { return _sleeps; }
+
+ private:
+  struct Slot {
+    volatile unsigned seq;
+    Routine*          routine;
+  };
+  enum { CacheLine = 64 };
+
+  Slot*             _slots;
+  unsigned          _mask;
+  unsigned          _spin;
+  char              _pad0[CacheLine];
+  volatile unsigned _tail;      // shared by producers
+  char              _pad1[CacheLine];
+  unsigned          _head;      // consumer's
+  volatile unsigned _sleeping;
+  unsigned          _sleeps;
+  Semaphore         _wakeup;
+  Queue<Routine>    _overflow;
+};
+}
+
+#endif
@@ -7,9 +7,19 @@
 #include "Task.hh"
 #include <signal.h>
 #include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include <list>
 
 using namespace Pds;
 
+static std::list<TaskObject*> _running;
+static pthread_mutex_t        _running_lock = PTHREAD_MUTEX_INITIALIZER;
+
 /*
  * actually make the call to start the thread
  *
@@ -22,9 +32,18 @@ int Task::createTask(TaskObject& tobj, TaskFunction aRoutine)
   param.sched_priority=tobj.priority();
   pthread_attr_setstacksize(&tobj._flags,tobj.stackSize()); 
   pthread_attr_setschedparam(&tobj._flags,&param);
+  tobj.policy().apply(tobj._flags,tobj.priority());
  
   int status = pthread_create(&tobj._threadID,&tobj._flags,aRoutine,this);
 
+  //  realtime scheduling needs privilege; run without it rather than not at all
+  if (status == EPERM && tobj.policy().scheduler() != TaskPolicy::Inherit) {
+    printf("Task::createTask %s not permitted %s scheduling.  Inheriting.\n",
+           tobj.name(), TaskPolicy::name(tobj.policy().scheduler()));
+    pthread_attr_setinheritsched(&tobj._flags, PTHREAD_INHERIT_SCHED);
+    status = pthread_create(&tobj._threadID,&tobj._flags,aRoutine,this);
+  }
+
   //  printf("Task::createTask id %d name %s\n", tobj._threadID, tobj._name);
 
   return status;
@@ -44,8 +63,10 @@ void Task::deleteTask()
     // error as this should be the last message 
     // from the last task object for this task
   }
+  detach();
   delete _pending;
   delete _jobs;
+  delete _ring;
   delete _refCount;
   delete _taskObj;
   delete _destroyRoutine;
@@ -65,3 +86,74 @@ bool Task::is_self() const
 {
   return pthread_self() == (pthread_t)_taskObj->taskID();
 }
+
+/*
+ * Called from the task's own thread when it starts.
+ */
+void Task::attach()
+{
+  _taskObj->_tid = syscall(SYS_gettid);
+  pthread_mutex_lock(&_running_lock);
+  _running.push_back(_taskObj);
+  pthread_mutex_unlock(&_running_lock);
+}
+
+void Task::detach()
+{
+  pthread_mutex_lock(&_running_lock);
+  _running.remove(_taskObj);
+  pthread_mutex_unlock(&_running_lock);
+}
+
+/*
+ * The cpu a thread last ran on is field 39 of its stat file.
+ */
+static int last_cpu(pid_t tid)
+{
+  char path[64];
+  sprintf(path,"/proc/self/task/%d/stat",tid);
+  FILE* f = fopen(path,"r");
+  if (!f) return -1;
+  char buff[1024];
+  size_t len = fread(buff,1,sizeof(buff)-1,f);
+  fclose(f);
+  buff[len] = 0;
+
+  //  skip the command name, which may contain spaces
+  char* p = strrchr(buff,')');
+  if (!p) return -1;
+  for(unsigned field=2; field<39 && p; field++)
+    p = strchr(p+1,' ');
+  return p ? atoi(p+1) : -1;
+}
+
+void Task::dump()
+{
+  printf("%-16s %7s %-7s %4s %4s %s\n",
+         "task","tid","sched","prio","cpu","allowed");
+
+  pthread_mutex_lock(&_running_lock);
+  for(std::list<TaskObject*>::const_iterator it=_running.begin();
+      it!=_running.end(); it++) {
+    const TaskObject& t = **it;
+
+    int policy;
+    struct sched_param param;
+    if (pthread_getschedparam(t.taskID(), &policy, &param))
+      continue;
+    const char* sched = policy==SCHED_FIFO ? "fifo" : policy==SCHED_RR ? "rr" : "other";
+
+    cpu_set_t cpus;
+    char allowed[128];
+    if (pthread_getaffinity_np(t.taskID(), sizeof(cpus), &cpus))
+      CPU_ZERO(&cpus);
+    TaskPolicy::format(cpus, allowed, sizeof(allowed));
+
+    int cpu = last_cpu(t.threadID());
+    printf("%-16s %7d %-7s %4d %4d %s%s\n",
+           t.name() ? t.name() : "main", t.threadID(), sched,
+           param.sched_priority, cpu, allowed,
+           cpu>=0 && TaskPolicy::isolated(cpu) ? " (isolated)" : "");
+  }
+  pthread_mutex_unlock(&_running_lock);
+}
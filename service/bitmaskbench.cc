@@ -0,0 +1,105 @@
+//
+//  Cost of visiting the clients left in an event builder mask (as
+//  EbBase::_post does for fixups and sinks) versus the number of
+//  contributors: shifting a probe bit through every position versus
+//  jumping between set bits with "first"/"next".
+//
+#include "pds/service/BitMaskArray.hh"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+//  As EbBase::_post before
+template <unsigned N>
+static unsigned visit_shift(BitMaskArray<N> remaining)
+{
+  unsigned sum = 0;
+  BitMaskArray<N> id(BitMaskArray<N>::ONE);
+  for(unsigned i=0; !remaining.isZero(); i++, id <<= 1) {
+    if ( !(remaining & id).isZero() ) {
+      sum += i;
+      remaining &= ~id;
+    }
+  }
+  return sum;
+}
+
+//  As EbBase::_post now
+template <unsigned N>
+static unsigned visit_bits(const BitMaskArray<N>& remaining)
+{
+  unsigned sum = 0;
+  for(unsigned i=remaining.first(); i<remaining.BitMaskBits; i=remaining.next(i))
+    sum += i;
+  return sum;
+}
+
+template <unsigned N>
+static void bench(unsigned nposts, unsigned nmasks, unsigned missing)
+{
+  //  Each mask has "missing" clients left at random positions
+  BitMaskArray<N>* masks = new BitMaskArray<N>[nmasks];
+  for(unsigned m=0; m<nmasks; m++)
+    for(unsigned k=0; k<missing; k++)
+      masks[m].setBit(rand()%BitMaskArray<N>::BitMaskBits);
+
+  unsigned s0 = 0, s1 = 0;
+  double t0 = now();
+  for(unsigned i=0; i<nposts; i++)
+    s0 += visit_shift(masks[i%nmasks]);
+  double t1 = now();
+  for(unsigned i=0; i<nposts; i++)
+    s1 += visit_bits(masks[i%nmasks]);
+  double t2 = now();
+
+  if (s0 != s1)
+    printf("visit mismatch: %u != %u\n", s0, s1);
+
+  double ts = 1.e9*(t1-t0)/double(nposts);
+  double tb = 1.e9*(t2-t1)/double(nposts);
+  printf("%8u %8u %12.1f %12.1f %8.1f\n",
+         unsigned(BitMaskArray<N>::BitMaskBits), missing, ts, tb, ts/tb);
+
+  delete[] masks;
+}
+
+void usage(const char* p)
+{
+  printf("Usage: %s [-n <posts>] [-m <clients left per post>]\n",p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned nposts  = 1000000;
+  unsigned missing = 1;
+
+  int c;
+  while ((c = getopt(argc, argv, "n:m:h")) != -1) {
+    switch(c) {
+    case 'n': nposts  = strtoul(optarg,NULL,0); break;
+    case 'm': missing = strtoul(optarg,NULL,0); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  const unsigned nmasks = 1024;
+  srand(1);
+
+  printf("%8s %8s %12s %12s %8s\n","clients","left","shift [ns]","bits [ns]","ratio");
+  bench<2> (nposts, nmasks, missing);
+  bench<4> (nposts, nmasks, missing);
+  bench<8> (nposts, nmasks, missing);
+  bench<16>(nposts, nmasks, missing);
+  return 0;
+}
@@ -1,6 +1,22 @@
 libnames := service
 
-ignore_src := BitMaskArray.cc RingPool.cc RingPoolW.cc KStream.cc TStream.cc
+ignore_src := BitMaskArray.cc RingPool.cc RingPoolW.cc KStream.cc TStream.cc taskbench.cc bitmaskbench.cc serverbench.cc
 
 libsrcs_service := $(filter-out $(ignore_src),$(wildcard *.cc))
-libincs_service := pdsdata/include ndarray/include
\ No newline at end of file
+libincs_service := pdsdata/include ndarray/include
+
+tgtnames := taskbench bitmaskbench serverbench
+
+tgtsrcs_taskbench := taskbench.cc
+tgtlibs_taskbench := pds/service
+tgtslib_taskbench := $(USRLIBDIR)/rt $(USRLIBDIR)/pthread
+tgtincs_taskbench := pdsdata/include
+
+tgtsrcs_bitmaskbench := bitmaskbench.cc
+tgtlibs_bitmaskbench := pds/service
+tgtincs_bitmaskbench := pdsdata/include
+
+tgtsrcs_serverbench := serverbench.cc
+tgtlibs_serverbench := pds/service
+tgtslib_serverbench := $(USRLIBDIR)/rt $(USRLIBDIR)/pthread
+tgtincs_serverbench := pdsdata/include
@@ -0,0 +1,192 @@
+//
+//  Latency of a datagram through ServerManager::poll to processIo, with
+//  "select" and with "epoll", for N idle and M active managed sockets.
+//  A thread sends one datagram at a time to an active socket and waits
+//  for it to be processed.  The descriptors of the sockets can be raised
+//  (-f), as in a process with many open files, since "select" scans up
+//  to the highest.
+//
+#include "pds/service/ServerManager.hh"
+#include "pds/service/Semaphore.hh"
+
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+namespace Pds {
+  class BenchServer : public Server {
+  public:
+    BenchServer(unsigned id, int fdmin) {
+      int s = ::socket(AF_INET, SOCK_DGRAM, 0);
+      sockaddr_in sa;
+      memset(&sa, 0, sizeof(sa));
+      sa.sin_family      = AF_INET;
+      sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      sa.sin_port        = 0;
+      ::bind(s, (sockaddr*)&sa, sizeof(sa));
+      socklen_t len = sizeof(_addr);
+      getsockname(s, (sockaddr*)&_addr, &len);
+      if (fdmin > s) {
+        int d = ::fcntl(s, F_DUPFD, fdmin);
+        ::close(s);
+        s = d;
+      }
+      this->id(id);
+      this->fd(s);
+    }
+    ~BenchServer() { ::close(fd()); }
+  public:
+    int pend(int flag) {
+      return ::recv(fd(), &_sent, sizeof(_sent), flag);
+    }
+    const sockaddr_in& addr() const { return _addr; }
+    double sent() const { return _sent; }
+  private:
+    sockaddr_in _addr;
+    double      _sent;
+  };
+
+  class BenchManager : public ServerManager {
+  public:
+    BenchManager() :
+      ServerManager(sizeof(int), sizeof(int), 1000),
+      _done(Semaphore::EMPTY) { reset(); }
+  public:
+    void reset() { _received=0; _latency=0; }
+    int processIo(Server* s) {
+      s->pend(0);
+      _latency += now() - static_cast<BenchServer*>(s)->sent();
+      _received++;
+      _done.give();
+      return 1;
+    }
+    int processTmo() { return 1; }
+  public:
+    void     wait    () { _done.take(); }
+    unsigned received() const { return _received; }
+    double   latency () const { return _latency/double(_received); }
+  private:
+    unsigned  _received;
+    double    _latency;
+    Semaphore _done;
+  };
+};
+
+static BenchManager* _manager;
+static BenchServer** _active;
+static unsigned      _nactive;
+static unsigned      _count;
+
+static void* send_datagrams(void*)
+{
+  int s = ::socket(AF_INET, SOCK_DGRAM, 0);
+  for(unsigned i=0; i<_count; i++) {
+    const BenchServer& dst = *_active[i%_nactive];
+    double t = now();
+    ::sendto(s, &t, sizeof(t), 0, (const sockaddr*)&dst.addr(), sizeof(dst.addr()));
+    _manager->wait();
+  }
+  ::close(s);
+  return 0;
+}
+
+static void usage(const char* p)
+{
+  printf("Usage: %s [-i <idle>] [-a <active>] [-n <datagrams>] [-f <lowest fd>] [-r (rearm all each poll)] [-b (busy-poll)]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned nidle   = 56;
+  unsigned nactive = 4;
+  unsigned fdmin   = 0;
+  bool     rearm   = false;
+  bool     busy    = false;
+  _count = 100000;
+
+  int c;
+  while ((c = getopt(argc, argv, "i:a:n:f:rbh")) != -1) {
+    switch(c) {
+    case 'i': nidle   = strtoul(optarg,NULL,0); break;
+    case 'a': nactive = strtoul(optarg,NULL,0); break;
+    case 'n': _count  = strtoul(optarg,NULL,0); break;
+    case 'f': fdmin   = strtoul(optarg,NULL,0); break;
+    case 'r': rearm   = true; break;
+    case 'b': busy    = true; break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  if (nidle+nactive > EbBitMask::BitMaskBits || !nactive) {
+    printf("At most %u servers, at least one active\n", EbBitMask::BitMaskBits);
+    return 1;
+  }
+
+  _manager = new BenchManager;
+  BenchServer** servers = new BenchServer*[nidle+nactive];
+  _active  = servers + nidle;
+  _nactive = nactive;
+  for(unsigned i=0; i<nidle+nactive; i++) {
+    servers[i] = new BenchServer(i, fdmin ? fdmin+i : 0);
+    _manager->manage(servers[i]);
+  }
+  printf("%u idle and %u active servers, fds %d-%d\n",
+         nidle, nactive, servers[0]->fd(), servers[nidle+nactive-1]->fd());
+
+  ServerManager::Multiplexer modes[] = { ServerManager::UseSelect,
+                                         ServerManager::UseEpoll,
+                                         ServerManager::UseEpollBusyPoll };
+  const char* names[] = { "select", "epoll", "epoll busy-poll" };
+  for(unsigned m=0; m<(busy ? 3:2); m++) {
+    if (modes[m]==ServerManager::UseSelect &&
+        servers[nidle+nactive-1]->fd() >= FD_SETSIZE) {
+      printf("%s limited to fds below %d\n", names[m], FD_SETSIZE);
+      continue;
+    }
+    if (_manager->multiplexer(modes[m])) {
+      printf("%s not available\n", names[m]);
+      continue;
+    }
+    _manager->arm(_manager->managed());
+    _manager->reset();
+
+    pthread_t sender;
+    double t0 = now();
+    pthread_create(&sender, 0, send_datagrams, 0);
+    while(_manager->received() < _count) {
+      _manager->poll();
+      if (rearm)
+        _manager->arm(_manager->managed());
+    }
+    pthread_join(sender, 0);
+    double dt = now()-t0;
+
+    printf("%-16s %8.2f us latency  %9.0f datagrams/s\n",
+           names[m], 1.e6*_manager->latency(), double(_count)/dt);
+  }
+
+  for(unsigned i=0; i<nidle+nactive; i++) {
+    _manager->unmanage(servers[i]);
+    delete servers[i];
+  }
+  delete[] servers;
+  delete _manager;
+  return 0;
+}
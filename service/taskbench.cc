@@ -0,0 +1,160 @@
+//
+//  Throughput and latency of the Task work queue: the locked
+//  Queue+Semaphore versus the lock-free TaskRing, with 1 to 16 threads
+//  posting routines to a single task.
+//
+#include "pds/service/Task.hh"
+#include "pds/service/Semaphore.hh"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+namespace Pds {
+  //  Consumer side bookkeeping; only touched by the task's thread
+  class BenchSink {
+  public:
+    BenchSink(unsigned expected) :
+      _expected(expected), _done(Semaphore::EMPTY) { reset(); }
+  public:
+    void reset() { _received=0; _latency=0; _maxLatency=0; }
+    void receive(double posted) {
+      double dt = now()-posted;
+      _latency += dt;
+      if (dt > _maxLatency) _maxLatency = dt;
+      if (++_received == _expected)
+        _done.give();
+    }
+    void   wait() { _done.take(); }
+    double latency   () const { return _latency/double(_received); }
+    double maxLatency() const { return _maxLatency; }
+  private:
+    unsigned  _expected;
+    unsigned  _received;
+    double    _latency;
+    double    _maxLatency;
+    Semaphore _done;
+  };
+
+  class BenchRoutine : public Routine {
+  public:
+    void post(Task& task, BenchSink& sink) {
+      _sink   = &sink;
+      _posted = now();
+      task.call(this);
+    }
+    void routine() { _sink->receive(_posted); }
+  private:
+    BenchSink* _sink;
+    double     _posted;
+  };
+
+  class BenchProducer {
+  public:
+    Task*            task;
+    BenchSink*       sink;
+    BenchRoutine*    routines;
+    unsigned         nroutines;
+    volatile bool*   start;
+    pthread_t        thread;
+  };
+}
+
+static void* produce(void* arg)
+{
+  BenchProducer* p = (BenchProducer*)arg;
+  while(!*p->start) ;
+  for(unsigned i=0; i<p->nroutines; i++)
+    p->routines[i].post(*p->task, *p->sink);
+  return 0;
+}
+
+//  Returns the elapsed time to post and run all routines
+static double run(Task& task, BenchSink& sink, BenchProducer* producers, unsigned nproducers)
+{
+  volatile bool start = false;
+  sink.reset();
+  for(unsigned i=0; i<nproducers; i++) {
+    producers[i].task  = &task;
+    producers[i].sink  = &sink;
+    producers[i].start = &start;
+    pthread_create(&producers[i].thread, NULL, produce, &producers[i]);
+  }
+  double t0 = now();
+  start = true;
+  sink.wait();
+  double t1 = now();
+  for(unsigned i=0; i<nproducers; i++)
+    pthread_join(producers[i].thread, NULL);
+  return t1-t0;
+}
+
+void usage(const char* p)
+{
+  printf("Usage: %s [-n <routines per producer>] [-p <max producers>] [-d <ring depth>] [-s <spin>]\n",p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned nroutines    = 100000;
+  unsigned maxProducers = 16;
+  unsigned depth        = 1024;
+  unsigned spin         = 0;
+
+  int c;
+  while ((c = getopt(argc, argv, "n:p:d:s:h")) != -1) {
+    switch(c) {
+    case 'n': nroutines    = strtoul(optarg,NULL,0); break;
+    case 'p': maxProducers = strtoul(optarg,NULL,0); break;
+    case 'd': depth        = strtoul(optarg,NULL,0); break;
+    case 's': spin         = strtoul(optarg,NULL,0); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  printf("%9s %12s %12s %12s %12s %12s %12s\n","producers",
+         "queue [M/s]","ring [M/s]",
+         "queue [us]","ring [us]",
+         "queue max","ring max");
+
+  for(unsigned nproducers=1; nproducers<=maxProducers; nproducers<<=1) {
+    BenchProducer* producers = new BenchProducer[nproducers];
+    for(unsigned i=0; i<nproducers; i++) {
+      producers[i].routines  = new BenchRoutine[nroutines];
+      producers[i].nroutines = nroutines;
+    }
+
+    unsigned  total = nproducers*nroutines;
+    BenchSink qsink(total), rsink(total);
+
+    Task* queue = new Task(TaskObject("benchq"));
+    double tq = run(*queue, qsink, producers, nproducers);
+    queue->destroy();
+
+    Task* ring = new Task(TaskObject("benchr"), depth, spin);
+    double tr = run(*ring, rsink, producers, nproducers);
+    ring->destroy();
+
+    printf("%9u %12.2f %12.2f %12.2f %12.2f %12.1f %12.1f\n", nproducers,
+           1.e-6*double(total)/tq, 1.e-6*double(total)/tr,
+           1.e6*qsink.latency(), 1.e6*rsink.latency(),
+           1.e6*qsink.maxLatency(), 1.e6*rsink.maxLatency());
+
+    for(unsigned i=0; i<nproducers; i++)
+      delete[] producers[i].routines;
+    delete[] producers;
+  }
+
+  return 0;
+}
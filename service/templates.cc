@@ -1,9 +1,13 @@
 #include "pds/service/BitMaskArray.cc"
+#include "pds/service/EbBitMaskSize.hh"
 
 namespace Pds {
 
   template class BitMaskArray<2>;
   template class BitMaskArray<4>;
+#if PDS_EB_MASKSIZE != 2 && PDS_EB_MASKSIZE != 4
+  template class BitMaskArray<PDS_EB_MASKSIZE>;
+#endif
 
   template<>
   int Pds::BitMaskArray<2>::read(const char* arg, char** end)
@@ -51,6 +51,31 @@ void fccd960Initialize(uint16_t* chanMap, uint16_t* topBot) {
   //  printf("done with init\n");
 }
 
+void fccd960InitializeDest(const uint16_t* chanMap, const uint16_t* topBot, uint32_t* chanDest) {
+  const unsigned CCDcols = 96;
+  const unsigned CCDreg = 10;
+  const unsigned CCDsizeX = CCDcols*CCDreg;
+  const unsigned CCDsizeY = 480;
+  const unsigned YTOT = 2*CCDsizeY;
+
+  // the 10 pixels of a channel in a row start at xdex for x = CCDreg-1
+  for (unsigned i=0; i<192; i++) {
+    if (topBot[i] == 0)
+      chanDest[i] = chanMap[i];
+    else
+      chanDest[i] = CCDsizeX * (YTOT-1) + (CCDsizeX-chanMap[i]-CCDreg);
+  }
+}
+
+bool fccd960Ssse3Supported() {
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3");
+#else
+  return false;
+#endif
+}
+
 void fccd960Reorder(const uint16_t* chanMap, const uint16_t* topBot, unsigned char* buffer, uint16_t* data) {
 
   const unsigned OverScan = 0;
@@ -6,4 +6,16 @@
 void fccd960Initialize(uint16_t* chanMap, uint16_t* topBot);
 void fccd960Reorder(const uint16_t* chanMap, const uint16_t* topBot, unsigned char* in, uint16_t* out);
 
+//
+// The vectorized reorder.  The channel map is resolved once into the frame
+// offset of each channel's pixels in the first row it fills (the top row,
+// or the bottom row for the bottom half), so the pixels themselves need no
+// lookups.  Each block of 8 channels and 10 conversions is transposed with
+// SSSE3 shuffles and stored directly in the frame.  The frame is the same
+// as fccd960Reorder's.
+//
+void fccd960InitializeDest(const uint16_t* chanMap, const uint16_t* topBot, uint32_t* chanDest);
+void fccd960ReorderSsse3(const uint32_t* chanDest, const uint16_t* topBot, const unsigned char* in, uint16_t* out);
+bool fccd960Ssse3Supported();
+
 #endif
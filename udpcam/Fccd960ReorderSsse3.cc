@@ -0,0 +1,85 @@
+// $Id$
+
+//
+// The SSSE3 reorder of Fccd960Reorder.hh.  It alone is built for SSSE3,
+// and UdpCamServer only calls it when the cpu supports it.
+//
+#if defined(__x86_64__)
+#include <stdint.h>
+
+#include "Fccd960Reorder.hh"
+
+#pragma GCC target("ssse3")
+
+#include <tmmintrin.h>
+
+// 8 rows of 8 words into 8 columns
+static inline void transpose8(const __m128i* r, __m128i* c) {
+  __m128i t0 = _mm_unpacklo_epi16(r[0], r[1]);
+  __m128i t1 = _mm_unpackhi_epi16(r[0], r[1]);
+  __m128i t2 = _mm_unpacklo_epi16(r[2], r[3]);
+  __m128i t3 = _mm_unpackhi_epi16(r[2], r[3]);
+  __m128i t4 = _mm_unpacklo_epi16(r[4], r[5]);
+  __m128i t5 = _mm_unpackhi_epi16(r[4], r[5]);
+  __m128i t6 = _mm_unpacklo_epi16(r[6], r[7]);
+  __m128i t7 = _mm_unpackhi_epi16(r[6], r[7]);
+  __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+  __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+  __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+  __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+  __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+  __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+  __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+  __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+  c[0] = _mm_unpacklo_epi64(u0, u4);
+  c[1] = _mm_unpackhi_epi64(u0, u4);
+  c[2] = _mm_unpacklo_epi64(u1, u5);
+  c[3] = _mm_unpackhi_epi64(u1, u5);
+  c[4] = _mm_unpacklo_epi64(u2, u6);
+  c[5] = _mm_unpackhi_epi64(u2, u6);
+  c[6] = _mm_unpacklo_epi64(u3, u7);
+  c[7] = _mm_unpackhi_epi64(u3, u7);
+}
+
+void fccd960ReorderSsse3(const uint32_t* chanDest, const uint16_t* topBot, const unsigned char* buffer, uint16_t* data) {
+
+  const unsigned CCDcols = 96;
+  const unsigned CCDreg = 10;
+  const unsigned CCDsizeX = CCDcols*CCDreg;
+  const unsigned CCDsizeY = 480;
+  const unsigned Channels = 192;
+
+  // big-endian words, reversed for the top half and in order for the bottom
+  const __m128i swapTop = _mm_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
+  const __m128i swapBot = _mm_setr_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14);
+
+  // the first 7 converts are from the stale pipeline data. Simply skip over them.
+  const uint16_t* in = reinterpret_cast<const uint16_t*>(buffer) + 7*Channels;
+
+  for (unsigned y=0; y<CCDsizeY; y++, in += CCDreg*Channels) {
+    unsigned row = CCDsizeX*y;
+    for (unsigned i=0; i<Channels; i+=8) {
+      // conversions 0-7 and 2-9 of 8 channels
+      __m128i r[CCDreg], lo[8], hi[8];
+      for (unsigned x=0; x<CCDreg; x++)
+        r[x] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x*Channels + i));
+      transpose8(&r[0], lo);
+      transpose8(&r[2], hi);
+      for (unsigned j=0; j<8; j++) {
+        unsigned k = i+j;
+        if (topBot[k] == 0) {
+          uint16_t* p = data + (chanDest[k] + row);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(p  ), _mm_shuffle_epi8(hi[j], swapTop));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(p+2), _mm_shuffle_epi8(lo[j], swapTop));
+        }
+        else {
+          uint16_t* p = data + (chanDest[k] - row);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(p  ), _mm_shuffle_epi8(lo[j], swapBot));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(p+2), _mm_shuffle_epi8(hi[j], swapBot));
+        }
+      }
+    }
+  }
+}
+
+#endif
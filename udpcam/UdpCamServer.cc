@@ -54,7 +54,8 @@ Pds::UdpCamServer::UdpCamServer( const Src& client, unsigned verbosity, int data
      _outOfOrder(0),
      _frameStarted(false),
      _shutdownFlag(0),
-     _cpu0(cpu0)
+     _cpu0(cpu0),
+     _ssse3(fccd960Ssse3Supported() && !(debug & UDPCAM_DEBUG_TABLE_REORDER))
 {
   if (_verbosity) {
     printf("%s: data port = %u\n", __FUNCTION__, _dataPort);
@@ -390,6 +391,7 @@ unsigned Pds::UdpCamServer::configure()
   }
 
   fccd960Initialize(_chanMap, _topBot);
+  fccd960InitializeDest(_chanMap, _topBot, _chanDest);
 
   return (numErrs);
 }
@@ -569,11 +571,17 @@ int Pds::UdpCamServer::fetch( char* payload, int flags )
     memcpy(payload+offset, receiveCommand.buf_iter->_rawData, 960*964*2);
   } else {
     if (verbosity() > 1) {
-      printf("%s calling fccd960Reorder()\n", __FUNCTION__);
+      printf("%s calling %s()\n", __FUNCTION__, _ssse3 ? "fccd960ReorderSsse3" : "fccd960Reorder");
     }
 
-    fccd960Reorder(_chanMap, _topBot, receiveCommand.buf_iter->_rawData, (uint16_t *)(payload+offset));
-
+#if defined(__x86_64__)
+    if (_ssse3) {
+      fccd960ReorderSsse3(_chanDest, _topBot, receiveCommand.buf_iter->_rawData, (uint16_t *)(payload+offset));
+    } else
+#endif
+    {
+      fccd960Reorder(_chanMap, _topBot, receiveCommand.buf_iter->_rawData, (uint16_t *)(payload+offset));
+    }
   }
 
   // copy frame counter to first pixel
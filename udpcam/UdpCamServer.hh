@@ -23,6 +23,7 @@
 #define UDPCAM_DEBUG_IGNORE_PACKET_CNT  0x00000020
 #define UDPCAM_DEBUG_NO_REORDER         0x00000040
 #define UDPCAM_DEBUG_IGNORE_SIG         0x00000080
+#define UDPCAM_DEBUG_TABLE_REORDER      0x00000100
 #define UDPCAM_DEBUG_RECV_BROADCAST     0x00008000
 
 #define UDP_RCVBUF_SIZE     (64*1024*1024)
@@ -109,7 +110,6 @@ class Pds::UdpCamServer
       bool                  _markdead;
       cmd_t                 _header;
       unsigned char         _rawData[1024 * 1024 * 2];
-      int16_t               _pixelData[960 * 960];
     };
 
     int payloadComplete(vector<BufferElement>::iterator buf_iter, bool missedTrigger);
@@ -172,6 +172,8 @@ class Pds::UdpCamServer
     enum { mapLength = 192};
     uint16_t _chanMap[mapLength];// new?
     uint16_t _topBot[mapLength];
+    uint32_t _chanDest[mapLength];
+    bool     _ssse3;
 
 };
 
@@ -1,5 +1,9 @@
 libnames := udpcam
 
-libsrcs_udpcam := UdpCamManager.cc  UdpCamServer.cc UdpCamOccurrence.cc Fccd960Reorder.cc
+libsrcs_udpcam := UdpCamManager.cc  UdpCamServer.cc UdpCamOccurrence.cc Fccd960Reorder.cc Fccd960ReorderSsse3.cc
 
 libincs_udpcam := pdsdata/include ndarray/include boost/include 
+
+tgtnames := fccdreorderbench
+tgtsrcs_fccdreorderbench := fccdreorderbench.cc Fccd960Reorder.cc Fccd960ReorderSsse3.cc
+tgtslib_fccdreorderbench := $(USRLIBDIR)/rt
@@ -0,0 +1,87 @@
+//
+//  Throughput of the FCCD960 reorders of UdpCamServer on a synthetic raw
+//  frame: the table-driven fccd960Reorder and the SSSE3 fccd960ReorderSsse3.
+//  The frame of the latter is compared with that of the former.
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "Fccd960Reorder.hh"
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+static void usage(const char* p)
+{
+  printf("Usage: %s [-n <frames>]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned nframes = 200;
+
+  int c;
+  while ((c = getopt(argc, argv, "n:h")) != -1) {
+    switch(c) {
+    case 'n': nframes = strtoul(optarg,NULL,0); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  enum { mapLength = 192 };
+  uint16_t chanMap [mapLength];
+  uint16_t topBot  [mapLength];
+  uint32_t chanDest[mapLength];
+  fccd960Initialize(chanMap, topBot);
+  fccd960InitializeDest(chanMap, topBot, chanDest);
+
+  //  as received by UdpCamServer, and the frame as posted
+  const unsigned rawSize   = 1024*1024*2;
+  const unsigned frameSize = 960*960;
+  unsigned char* raw = new unsigned char[rawSize];
+  for(unsigned i=0; i<rawSize; i++)
+    raw[i] = random();
+  uint16_t* ref = new uint16_t[frameSize];
+  uint16_t* out = new uint16_t[frameSize];
+
+  memset(ref, 0, frameSize*sizeof(uint16_t));
+  double t0 = now();
+  for(unsigned i=0; i<nframes; i++)
+    fccd960Reorder(chanMap, topBot, raw, ref);
+  double dt = now()-t0;
+  printf("%-6s: %8.1f frames/s %6.2f GB/s\n", "table",
+         double(nframes)/dt, 2.e-9*double(nframes)*double(frameSize)/dt);
+
+#if defined(__x86_64__)
+  if (!fccd960Ssse3Supported()) {
+    printf("ssse3 unsupported\n");
+    return 0;
+  }
+
+  memset(out, 0, frameSize*sizeof(uint16_t));
+  t0 = now();
+  for(unsigned i=0; i<nframes; i++)
+    fccd960ReorderSsse3(chanDest, topBot, raw, out);
+  dt = now()-t0;
+  bool lsame = memcmp(out, ref, frameSize*sizeof(uint16_t))==0;
+  printf("%-6s: %8.1f frames/s %6.2f GB/s  %s\n", "ssse3",
+         double(nframes)/dt, 2.e-9*double(nframes)*double(frameSize)/dt,
+         lsame ? "identical" : "DIFFERS");
+#else
+  bool lsame = true;
+#endif
+
+  delete[] raw;
+  delete[] ref;
+  delete[] out;
+
+  return lsame ? 0 : 1;
+}
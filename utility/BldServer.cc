@@ -75,6 +75,9 @@ void BldServer::dump(int detail) const
          _server.sizeofDatagram() + _server.maxPayload(),
          _server.sizeofDatagram(), _server.maxPayload());
   printf(" Dropped %d contributions\n", drops());
+  if (_server.batches())
+    printf(" Batched %d contributions in %d receives\n",
+           _server.batched(), _server.batches());
   return;
 }
 
@@ -122,6 +125,11 @@ unsigned BldServer::offset() const
   return ((OutletWireHeader*)_server.datagram())->offset;
 }
 
+unsigned BldServer::buffered() const
+{
+  return _server.buffered();
+}
+
 int BldServer::pend(int flag)
 {
   return _server.pend(flag);
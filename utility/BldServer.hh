@@ -25,6 +25,7 @@ namespace Pds {
     bool           more  () const;
     unsigned       length() const;
     unsigned       offset() const;
+    unsigned       buffered() const;
   public:
     //  Eb-key interface
     EbServerDeclare;
@@ -2,6 +2,7 @@
 
 #include "pds/utility/Eb.hh"
 #include "pds/utility/EbServer.hh"
+#include "pds/utility/EbEventIndex.hh"
 #include "pds/xtc/CDatagram.hh"
 #include "pds/service/SysClk.hh"
 #include "pds/service/Client.hh"
@@ -13,6 +14,24 @@ using namespace Pds;
 
 extern unsigned nEbPrints;
 
+static bool              _policy   = false;
+static PoolPolicy::Pages _pages    = PoolPolicy::Normal;
+static bool              _prefault = false;
+
+static PoolPolicy datagram_policy(int ipaddress)
+{
+  if (!_policy)
+    return PoolPolicy();
+  return PoolPolicy(_pages, PoolPolicy::nodeOfInterface(ipaddress), _prefault);
+}
+
+void Eb::datagram_policy(PoolPolicy::Pages pages, bool prefault)
+{
+  _policy   = true;
+  _pages    = pages;
+  _prefault = prefault;
+}
+
 /*
 ** ++
 **
@@ -46,8 +65,11 @@ Eb::Eb(const Src& id,
        ) :
   EbBase(id, ctns, level, inlet, outlet, stream, ipaddress,
    slowEb, vmoneb, dstack ),
-  _datagrams(eventsize, eventpooldepth),
-  _events(sizeof(EbEvent), eventpooldepth)
+  _datagrams(eventsize, eventpooldepth, ::datagram_policy(ipaddress)),
+  _events(sizeof(EbEvent), eventpooldepth),
+  _peek   (false),
+  _placed (0),
+  _avoided(0)
 {
 }
 
@@ -77,13 +99,54 @@ void Eb::_insert( EbEventBase* event )
   _pending.insert(event);
 }
 
+/*
+** ++
+**
+**    Returns the event the server's contribution belongs to, as given by
+**    the contribution's header, which the server has presented ahead of
+**    the payload (see "EbServer::peek").  A new event is created if no
+**    pending event matches.  The payload can then be received in place,
+**    whereas the guess made by "_event" must be recopied when it proves
+**    wrong.
+**
+** --
+*/
+
+EbEventBase* Eb::_place(EbServer* server)
+{
+  EbBitMask serverId;
+  serverId.setBit(server->id());
+
+  //  The event "_event" would have guessed
+  EbEventBase* guess = _pending.forward();
+  while( guess != _pending.empty() ) {
+    if(!(guess->segments() & serverId).isZero() ||
+       guess->allocated().present(serverId).isZero())
+      break;
+    guess = guess->forward();
+  }
+
+  EbEventBase* event = _seek(server);
+  if (!event)
+    event = _new_event(serverId);
+
+  _placed++;
+  if (guess != _pending.empty() && guess != event)
+    _avoided++;
+
+  return event;
+}
+
 int Eb::processIo(Server* serverGeneric)
 {
   EbServer* server = (EbServer*)serverGeneric;
 
-  //  Find the next event waiting for a contribution from this server.
+  //  Find the event waiting for this contribution: from its header if the
+  //  server can present it, otherwise the next event waiting for a
+  //  contribution from this server.
   //  If the event is better handled later (to avoid a copy) return 0.
-  EbEvent*  event  = (EbEvent*)_event(server);
+  EbEvent*  event  = (EbEvent*)(_peek && server->peek() >= 0 ?
+                                _place(server) : _event(server));
   if (!event) // Can't accept this contribution yet, may take it later
     return 0;
 
@@ -121,7 +184,7 @@ int Eb::processIo(Server* serverGeneric)
 
   if(event == event->forward()) {   // case (1)
     _pending.insert(event);
-    server->assign(event->key());
+    _assign(server, event);
   }
   else if(!server->coincides(event->key())) {
     // case (2):  Remove the contribution from this event.  Now that we have the contribution's
@@ -148,16 +211,16 @@ int Eb::processIo(Server* serverGeneric)
         }
         return 1;
       }
-      server->assign(event->key());
+      _assign(server, event);
       _insert(event);
     }
     else {
       event->recopy(payload, sizeofPayload, serverId);
-      server->assign(event->key());
+      _assign(server, event);
     }
   }
   else
-    server->assign(event->key());
+    _assign(server, event);
 
   //  Allow the event-under-construction to account for the added contribution
   if(sizeofPayload && event->consume(server, sizeofPayload, serverId)) {  // expect more fragments?
@@ -204,6 +267,21 @@ int Eb::processIo(Server* serverGeneric)
 
 Eb::~Eb()
 {
+  key_index(false);
+}
+
+void Eb::key_index(bool enable)
+{
+  if (_index) {
+    _index->clear();
+    delete _index;
+  }
+  _index = enable ? new EbEventIndex(_events.numberofObjects()) : 0;
+}
+
+void Eb::peek(bool enable)
+{
+  _peek = enable;
 }
 
 void Eb::_dump(int detail)
@@ -214,4 +292,7 @@ void Eb::_dump(int detail)
          _events.numberofAllocs(), _events.numberofFrees());
   printf(" Datagrams allocated/deallocated %u/%u\n",
          _datagrams.numberofAllocs(), _datagrams.numberofFrees());
+  if (_peek)
+    printf(" %u Contributions placed by header, %u recopies avoided\n",
+           _placed, _avoided);
 }
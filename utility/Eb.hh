@@ -32,13 +32,29 @@ class Eb : public EbBase
     virtual ~Eb();
   public:
     int  processIo(Server*);
+  public:
+    void key_index(bool);   // index pending events by key for _seek
+    //  Place contributions by their header before receiving.  The payload
+    //  is received in place from servers that read the socket (unbatched
+    //  NetDgServer); from a batched server it is copied once out of the
+    //  receive ring.  Servers that cannot present the header first keep
+    //  the guessed placement.
+    void peek     (bool);
+  public:
+    //  Page size and prefaulting of the datagram pool of builders created
+    //  hereafter.  The pool is placed on the NUMA node of the NIC.
+    static void datagram_policy(PoolPolicy::Pages, bool prefault);
   private:
+    EbEventBase* _place      ( EbServer* );
     unsigned     _fixup      ( EbEventBase*, const Src&, const EbBitMask& );
     void         _insert     ( EbEventBase* );
     void         _dump       ( int detail );
   protected:
     GenericPoolW _datagrams;    // Datagram freelist
     GenericPool  _events;
+    bool         _peek;
+    unsigned     _placed;       // # of contributions placed by their header
+    unsigned     _avoided;      // # of those which would have been recopied
   };
 }
 #endif
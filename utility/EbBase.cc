@@ -20,6 +20,7 @@
 
 #include "pds/utility/EbBase.hh"
 #include "pds/utility/EbServer.hh"
+#include "pds/utility/EbEventIndex.hh"
 #include "pds/utility/EbTimeouts.hh"
 #include "pds/utility/Inlet.hh"
 #include "pds/vmon/VmonEb.hh"
@@ -85,6 +86,7 @@ EbBase::EbBase(const Src& id,
   InletWireServer(inlet, outlet, ipaddress, stream,
       TaskPriority-stream, TaskName(level, stream, inlet),
       EbTimeouts::duration(stream)),
+  _index(0),
   _ebtimeouts(stream,level, slowEb),
   _output(inlet),
   _id(id),
@@ -126,12 +128,7 @@ EbBase::EbBase(const Src& id,
 
 Server* EbBase::accept(Server* srv)
 {
-  EbBitMask clients = managed();
-  unsigned id = 0;
-  while( clients.LSBnotZero() ) {
-    clients >>= 1;
-    id++;
-  }
+  unsigned id = (~managed()).first();  // lowest free id
   srv->id(id);
 
   if (_vmoneb)
@@ -257,17 +254,13 @@ void EbBase::_post(EbEventBase* event)
       sprintf(buff,"EbBase::_post sink seq %08x remaining ",
               datagram->seq.stamp().fiducials());
       r.write(&buff[strlen(buff)]);
-      EbBitMask id(EbBitMask::ONE);
-      for(unsigned i=0; !r.isZero(); i++, id <<= 1) {
-        if ( !(r & id).isZero() ) {
-          EbServer* srv = (EbServer*)server(i);
-          if (srv)
-            snprintf(buff+strlen(buff),buffsize-strlen(buff)," [%x/%x]",
-                     srv->client().log(),srv->client().phy());
-          else
-            snprintf(buff+strlen(buff),buffsize-strlen(buff)," [?/?]");
-          r &= ~id;
-        }
+      for(unsigned i=r.first(); i<r.BitMaskBits; i=r.next(i)) {
+        EbServer* srv = (EbServer*)server(i);
+        if (srv)
+          snprintf(buff+strlen(buff),buffsize-strlen(buff)," [%x/%x]",
+                   srv->client().log(),srv->client().phy());
+        else
+          snprintf(buff+strlen(buff),buffsize-strlen(buff)," [?/?]");
       }
       printf("%s\n",buff);
       --nEbPrints;
@@ -275,13 +268,8 @@ void EbBase::_post(EbEventBase* event)
 
     // statistics
     if (_vmoneb) {
-      EbBitMask id(EbBitMask::ONE);
-      for(unsigned i=0; !remaining.isZero(); i++, id <<= 1) {
-        if ( !(remaining & id).isZero() ) {
-          _vmoneb->fixup(_clients.BitMaskBits);
-          remaining &= ~id;
-        }
-      }
+      for(unsigned n=remaining.count(); n; n--)
+        _vmoneb->fixup(_clients.BitMaskBits);
       _vmoneb->fixup(-1);
     }
 
@@ -305,39 +293,33 @@ void EbBase::_post(EbEventBase* event)
               event->key().value(),
               datagram->seq.stamp().fiducials());
       r.write(&buff[strlen(buff)]);
-      EbBitMask id(EbBitMask::ONE);
-      for(unsigned i=0; !r.isZero(); i++, id <<= 1) {
-        if ( !(r & id).isZero() ) {
-          EbServer* srv = (EbServer*)server(i);
-          if (srv)
-            snprintf(buff+strlen(buff),buffsize-strlen(buff)," [%x/%x]",
-                srv->client().log(),srv->client().phy());
-          else
-            snprintf(buff+strlen(buff),buffsize-strlen(buff)," [?/?]");
-          r &= ~id;
-        }
+      for(unsigned i=r.first(); i<r.BitMaskBits; i=r.next(i)) {
+        EbServer* srv = (EbServer*)server(i);
+        if (srv)
+          snprintf(buff+strlen(buff),buffsize-strlen(buff)," [%x/%x]",
+                   srv->client().log(),srv->client().phy());
+        else
+          snprintf(buff+strlen(buff),buffsize-strlen(buff)," [?/?]");
       }
       printf("%s\n",buff);
       --nEbPrints;
     }
 
     // statistics
-    EbBitMask id(EbBitMask::ONE);
     unsigned dmg=0;
-    for(unsigned i=0; !remaining.isZero(); i++, id <<= 1) {
-      if ( !(remaining & id).isZero() ) {
-        if (_vmoneb) _vmoneb->fixup(i);
-        EbServer* srv = (EbServer*)server(i);
-        if (srv) {
-          srv->fixup();
-          dmg |= _fixup(event, srv->client(), id);
-        }
-        else {
-          printf("EbBase::_post fixup NULL server : clients %x  remaining %x\n",
-                 _clients.value(), remaining.value());
-          dmg |= _fixup(event, _id, id);
-        }
-        remaining &= ~id;
+    for(unsigned i=remaining.first(); i<remaining.BitMaskBits; i=remaining.next(i)) {
+      EbBitMask id;
+      id.setBit(i);
+      if (_vmoneb) _vmoneb->fixup(i);
+      EbServer* srv = (EbServer*)server(i);
+      if (srv) {
+        srv->fixup();
+        dmg |= _fixup(event, srv->client(), id);
+      }
+      else {
+        printf("EbBase::_post fixup NULL server : clients %x  remaining %x\n",
+               _clients.value(), remaining.value());
+        dmg |= _fixup(event, _id, id);
       }
     }
 
@@ -487,9 +469,43 @@ int EbBase::poll()
 
   ServerManager::arm(_armMask());
 
+  while(_drain())
+    ServerManager::arm(_armMask());
+
   return 1;
   }
 
+/*
+** ++
+**
+**  Servers which receive in batches may hold contributions that have
+**  already been read from the socket, so "select" will not report them.
+**  Feed those contributions to the builder for every armed server.
+**  Returns whether any contribution was consumed.
+**
+** --
+*/
+
+bool EbBase::_drain()
+{
+  bool consumed = false;
+  EbBitMask remaining = active();
+  for(unsigned id=remaining.first(); id<remaining.BitMaskBits; id=remaining.next(id)) {
+    EbServer* srv = (EbServer*)server(id);
+    if (!srv) continue;
+    unsigned buffered = srv->buffered();
+    while(buffered) {
+      int rearm = processIo(srv);
+      unsigned left = srv->buffered();
+      if (left == buffered) break;  // contribution not accepted yet
+      consumed = true;
+      if (!rearm) break;
+      buffered = left;
+    }
+  }
+  return consumed;
+}
+
 /*
 ** ++
 **
@@ -530,7 +546,10 @@ EbEventBase* EbBase::_event(EbServer* server)
 /*
 ** ++
 **
-**  Returns the event that matches the servers contribution
+**  Returns the event that matches the servers contribution.  If the
+**  pending events are indexed and the server can produce the key value
+**  of its contribution, only the events entered under that value are
+**  examined; otherwise the whole pending queue is traversed.
 **
 ** --
 */
@@ -540,6 +559,19 @@ EbEventBase* EbBase::_seek(EbServer* srv)
   EbBitMask serverId;
   serverId.setBit(srv->id());
   EbEventBase* event = _pending.forward();
+
+  unsigned hash;
+  if (_index && event != _pending.empty() &&
+      srv->hash(event->key(), hash)) {
+    for(event = _index->lookup(hash); event; event = _index->next(event)) {
+      if( srv->coincides(event->key()) &&
+          (!(event->segments() & serverId).isZero() ||
+           event->allocated().insert(serverId).isZero()) )
+        return event;
+    }
+    return 0;
+  }
+
   while( event != _pending.empty() ) {
     if( srv->coincides(event->key()) &&
         (!(event->segments() & serverId).isZero() ||
@@ -551,6 +583,22 @@ EbEventBase* EbBase::_seek(EbServer* srv)
   return 0;
 }
 
+/*
+** ++
+**
+**  Assign the key of the server's contribution to the event and keep
+**  the key index (if any) current.
+**
+** --
+*/
+
+void EbBase::_assign(EbServer* srv, EbEventBase* event)
+{
+  srv->assign(event->key());
+  if (_index)
+    _index->update(event);
+}
+
 /*
 ** ++
 **
@@ -711,8 +759,9 @@ class serverFlush : public ServerScan<Server>
       int tmo = 1;
       int nbytes = 0;
       char* payload = _flush_buff;
-      while( ::poll(pfd, nfds, tmo) > 0) {
-        nbytes += static_cast<EbServer*>(server)->fetch(payload, MSG_DONTWAIT);
+      EbServer* srv = static_cast<EbServer*>(server);
+      while( ::poll(pfd, nfds, tmo) > 0 || srv->buffered()) {
+        nbytes += srv->fetch(payload, MSG_DONTWAIT);
         pfd[0].events  = POLLIN;
         pfd[0].revents = 0;
       }
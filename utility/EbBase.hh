@@ -15,6 +15,7 @@ namespace Pds {
   class Client;
   class Appliance;
   class VmonEb;
+  class EbEventIndex;
 
   class EbBase : public InletWireServer
   {
@@ -39,6 +40,7 @@ namespace Pds {
   public:
     int  poll      ();
     int  processTmo();
+    virtual int processIo(Server*) = 0;
     void dump      (int);
   public:
     void contains(const TypeId&);
@@ -55,7 +57,9 @@ namespace Pds {
     void         _post     (EbEventBase*);  // complete this event
     virtual EbEventBase* _seek     (EbServer*);
     virtual EbEventBase* _event    (EbServer*);
+    void         _assign   (EbServer*, EbEventBase*);
     EbBitMask    _armMask  ();
+    bool         _drain    ();
     void         _iterate_dump();
   private:
     void         _remove   (EbServer*);
@@ -71,6 +75,7 @@ namespace Pds {
     virtual void         _dump       ( int detail ) = 0;
   protected:
     LinkedList<EbEventBase> _pending;      // Under construction/completion queue
+    EbEventIndex*           _index;        // Optional key index of _pending
   protected:
     EbBitMask   _clients;      // Database of clients
     EbBitMask   _valued_clients;   // Database of clients valued
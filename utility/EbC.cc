@@ -100,6 +100,8 @@ int EbC::poll()
 {
   if(!ServerManager::poll()) return 0;
   if(active().isZero()) ServerManager::arm(managed());
+  while(_drain())
+    if(active().isZero()) ServerManager::arm(managed());
   return 1;
 }
 
@@ -19,14 +19,19 @@ namespace Pds {
     virtual bool precedes (const EbSequenceSrv& s) { return !(key.seq.clock() > s.sequence().clock()); } 
     virtual bool coincides(const EbSequenceSrv& s) { return key.seq.clock() == s.sequence().clock(); } 
     virtual void assign   (const EbSequenceSrv& s) { key.seq = s.sequence(); key.env = s.env(); }
+    virtual bool hash     (const EbSequenceSrv& s, unsigned& h) { h = _hash(s.sequence().clock()); return true; }
 
     virtual bool precedes (const EvrServer& s) { return !(key.seq.clock() > s.sequence().clock()); } 
     virtual bool coincides(const EvrServer& s) { return key.seq.clock() == s.sequence().clock(); } 
     virtual void assign   (const EvrServer& s) { key.seq = s.sequence(); }
+    virtual bool hash     (const EvrServer& s, unsigned& h) { h = _hash(s.sequence().clock()); return true; }
   public:
     const Sequence& sequence() const { return key.seq; }
     const Env&      env     () const { return key.env; }
     unsigned        value   () const { return key.seq.stamp().fiducials(); }
+    unsigned        hash    () const { return _hash(key.seq.clock()); }
+  private:
+    static unsigned _hash(const ClockTime& c) { return c.seconds()^c.nanoseconds(); }
   private:
     Datagram& key;
   };
@@ -32,10 +32,12 @@ namespace Pds {
     virtual bool precedes (const EbCountSrv& s) { return key <= s.count(); }
     virtual bool coincides(const EbCountSrv& s) { return key == s.count(); }
     virtual void assign   (const EbCountSrv& s) { key = s.count(); }
+    virtual bool hash     (const EbCountSrv& s, unsigned& h) { h = s.count(); return true; }
     //  Special service from the EVR
     virtual bool precedes (const EvrServer& s) { return key <= s.count(); }
     virtual bool coincides(const EvrServer& s) { return key == s.count(); }
     virtual void assign   (const EvrServer& s) { key = s.count(); dgram.seq = s.sequence(); dgram.env = s.env();}
+    virtual bool hash     (const EvrServer& s, unsigned& h) { h = s.count(); return true; }
     //  Special case for only one server providing timestamp
     virtual bool precedes (const EbSequenceSrv& s) { return false; }
     virtual bool coincides(const EbSequenceSrv& s) { return false; }
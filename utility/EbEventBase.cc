@@ -43,7 +43,10 @@ EbEventBase::EbEventBase(EbBitMask creator,
   _datagram         (datagram),
   _begin            (SysClk::sample()),
   _bClientGroupSet  (false),
-  _post             (false)
+  _post             (false),
+  _hindex           (0),
+  _hnext            (0),
+  _hkey             (0)
   {
   }
 
@@ -72,7 +75,10 @@ EbEventBase::EbEventBase() :
   _datagram         (0),
   _begin            (0),
   _bClientGroupSet  (false),
-  _post             (false)
+  _post             (false),
+  _hindex           (0),
+  _hnext            (0),
+  _hkey             (0)
   {
   }
 
@@ -6,6 +6,7 @@
 #include "EbEventKey.hh"
 #include "EbClients.hh"
 #include "EbSegment.hh"
+#include "EbEventIndex.hh"
 #include "pds/service/LinkedList.hh"
 
 namespace Pds {
@@ -52,6 +53,11 @@ class EbEventBase : public LinkedList<EbEventBase>
   private:
     bool          _bClientGroupSet; // if client group has been updated. Used by EbSGroup to update the contribution list
     bool          _post;
+  private:
+    friend class EbEventIndex;
+    EbEventIndex* _hindex;          // Key index this event is entered in (if any)
+    EbEventBase*  _hnext;           // Next event in the same index chain
+    unsigned      _hkey;            // Key value under which it is indexed
   };
 }
 
@@ -69,6 +75,7 @@ class EbEventBase : public LinkedList<EbEventBase>
 inline Pds::EbEventBase::~EbEventBase()
   {
   disconnect();
+  if (_hindex) _hindex->remove(this);
   delete _key;
   }
 
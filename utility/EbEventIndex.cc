@@ -0,0 +1,127 @@
+#include "EbEventIndex.hh"
+#include "EbEventBase.hh"
+
+using namespace Pds;
+
+/*
+** ++
+**
+**   The number of buckets is the smallest power of two at least twice
+**   the depth of the event pool; i.e. the index is at most half full.
+**
+** --
+*/
+
+EbEventIndex::EbEventIndex(unsigned depth) :
+  _entries(0)
+{
+  unsigned nbuckets = 1;
+  while(nbuckets < (depth<<1))
+    nbuckets <<= 1;
+  _mask    = nbuckets-1;
+  _buckets = new EbEventBase*[nbuckets];
+  for(unsigned i=0; i<nbuckets; i++)
+    _buckets[i] = 0;
+}
+
+EbEventIndex::~EbEventIndex()
+{
+  delete[] _buckets;
+}
+
+/*
+** ++
+**
+**   Release every indexed event from the index (the events themselves
+**   are left untouched on the pending queue).
+**
+** --
+*/
+
+void EbEventIndex::clear()
+{
+  for(unsigned i=0; i<=_mask; i++) {
+    EbEventBase* event = _buckets[i];
+    while(event) {
+      EbEventBase* next = event->_hnext;
+      event->_hindex = 0;
+      event->_hnext  = 0;
+      event = next;
+    }
+    _buckets[i] = 0;
+  }
+  _entries = 0;
+}
+
+/*
+** ++
+**
+**   Enter the event under the current value of its key.  An event is
+**   only moved when its key value has changed since it was last indexed,
+**   so repeated calls (one per contribution) preserve the chain order,
+**   which is the order in which the events acquired their keys.
+**
+** --
+*/
+
+void EbEventIndex::update(EbEventBase* event)
+{
+  unsigned hash = event->key().hash();
+  if (event->_hindex == this) {
+    if (event->_hkey == hash) return;
+    remove(event);
+  }
+
+  event->_hindex = this;
+  event->_hkey   = hash;
+  event->_hnext  = 0;
+
+  EbEventBase** link = &_bucket(hash);
+  while(*link)
+    link = &(*link)->_hnext;
+  *link = event;
+  _entries++;
+}
+
+void EbEventIndex::remove(EbEventBase* event)
+{
+  EbEventBase** link = &_bucket(event->_hkey);
+  while(*link) {
+    if (*link == event) {
+      *link = event->_hnext;
+      _entries--;
+      break;
+    }
+    link = &(*link)->_hnext;
+  }
+  event->_hindex = 0;
+  event->_hnext  = 0;
+}
+
+/*
+** ++
+**
+**   Return the first (oldest) event whose key has the given value, or
+**   zero if there is none.  Subsequent candidates are returned by "next".
+**   Distinct key values may share a chain, so candidates must still be
+**   checked against the contribution (see "EbBase::_seek").
+**
+** --
+*/
+
+EbEventBase* EbEventIndex::lookup(unsigned hash) const
+{
+  EbEventBase* event = _bucket(hash);
+  while(event && event->_hkey != hash)
+    event = event->_hnext;
+  return event;
+}
+
+EbEventBase* EbEventIndex::next(EbEventBase* event) const
+{
+  unsigned hash = event->_hkey;
+  event = event->_hnext;
+  while(event && event->_hkey != hash)
+    event = event->_hnext;
+  return event;
+}
@@ -0,0 +1,57 @@
+/*
+** ++
+**  Package:
+**	odfUtility
+**
+**  Abstract:
+**      Hash index of the events under construction, keyed by the value
+**      of each event's key (see "EbEventKey::hash").  The index is kept
+**      alongside the event builder's pending queue so that a contribution
+**      whose header is already known can locate its event without a
+**      traversal of the whole queue.  The pending queue remains the
+**      authority for posting order; the index only narrows the search.
+**      Entries are chained through the events themselves, so the index
+**      never allocates after construction.
+**
+** --
+*/
+
+#ifndef PDS_EBEVENTINDEX_HH
+#define PDS_EBEVENTINDEX_HH
+
+namespace Pds {
+
+class EbEventBase;
+
+class EbEventIndex
+  {
+  public:
+    EbEventIndex(unsigned depth);
+    ~EbEventIndex();
+  public:
+    void         update(EbEventBase*);  // (re)index event by its current key
+    void         remove(EbEventBase*);
+    void         clear ();
+    EbEventBase* lookup(unsigned hash) const;
+    EbEventBase* next  (EbEventBase*)  const;
+    unsigned     entries() const;
+  private:
+    EbEventBase*& _bucket(unsigned hash) const;
+  private:
+    unsigned      _mask;
+    EbEventBase** _buckets;
+    unsigned      _entries;
+  };
+}
+
+inline unsigned Pds::EbEventIndex::entries() const
+{
+  return _entries;
+}
+
+inline Pds::EbEventBase*& Pds::EbEventIndex::_bucket(unsigned hash) const
+{
+  return _buckets[(hash ^ (hash>>16)) & _mask];
+}
+
+#endif
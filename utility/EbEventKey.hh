@@ -14,12 +14,14 @@ namespace Pds {
     virtual bool succeeds (EbEventKey& key) const { return key.precedes (*this); } \
     virtual bool coincides(EbEventKey& key) const { return key.coincides(*this); } \
     virtual void assign   (EbEventKey& key) const { key.assign   (*this); } \
+    virtual bool hash     (EbEventKey& key, unsigned& h) const { return key.hash(*this,h); } \
 
 
 #define EbEventKeyDeclare(server) \
     virtual bool precedes (const server &) { return false; } \
     virtual bool coincides(const server &) { return false; } \
     virtual void assign   (const server &) {} \
+    virtual bool hash     (const server &, unsigned&) { return false; } \
 
   class EbEventKey {
   public:
@@ -33,6 +35,9 @@ namespace Pds {
   public:
     virtual const Sequence& sequence() const = 0;
     virtual unsigned        value() const = 0;
+    //  Index value of this key.  A server's hash (above) must equal this
+    //  value whenever the server coincides with the key.
+    virtual unsigned        hash () const { return value(); }
   };
 
 }
@@ -0,0 +1,244 @@
+#include "EbMerge.hh"
+
+#include "pds/service/Task.hh"
+#include "pds/service/Routine.hh"
+#include "pdsdata/xtc/Sequence.hh"
+
+#include <stdio.h>
+
+extern int nEbPrints;
+
+static const unsigned MergeQueueDepth = 1024;
+
+namespace Pds {
+  class MergeDg : public Routine {
+  public:
+    MergeDg(EbMerge& m, InDatagram* dg) : _m(m), _dg(dg) {}
+    void routine() { _m._merge(_dg); delete this; }
+  private:
+    EbMerge&    _m;
+    InDatagram* _dg;
+  };
+  class MergeTr : public Routine {
+  public:
+    MergeTr(EbMerge& m, Transition* tr) : _m(m), _tr(tr) {}
+    void routine() { _m._forward(_tr); delete this; }
+  private:
+    EbMerge&    _m;
+    Transition* _tr;
+  };
+  class MergeOcc : public Routine {
+  public:
+    MergeOcc(EbMerge& m, Occurrence* occ) : _m(m), _occ(occ) {}
+    void routine() { _m._forward(_occ); delete this; }
+  private:
+    EbMerge&    _m;
+    Occurrence* _occ;
+  };
+  class MergeExpire : public Routine {
+  public:
+    MergeExpire(EbMerge& m) : _m(m) {}
+    void routine() { _m._release(); delete this; }
+  private:
+    EbMerge& _m;
+  };
+  class MergeFlush : public Routine {
+  public:
+    MergeFlush(EbMerge& m, bool post) : _m(m), _post(post) {}
+    void routine() { _m._flush(_post); _m._flushed(); delete this; }
+  private:
+    EbMerge& _m;
+    bool     _post;
+  };
+}
+
+using namespace Pds;
+
+//
+//  The control bits are excluded: chunked contributions carry an
+//  extended bit the whole contributions don't.
+//
+EbMerge::Key::Key(const Sequence& seq) :
+  _fiducials(seq.stamp().fiducials()),
+  _ticks    (seq.stamp().ticks()),
+  _vector   (seq.stamp().vector())
+{
+}
+
+bool EbMerge::Key::operator<(const Key& k) const
+{
+  if (_fiducials != k._fiducials) return _fiducials < k._fiducials;
+  if (_vector    != k._vector   ) return _vector    < k._vector;
+  return _ticks < k._ticks;
+}
+
+EbMerge::EbMerge(Inlet& output, unsigned hold) :
+  _output (output),
+  _hold   (hold),
+  _task   (new Task(TaskObject("oEbMrg"), MergeQueueDepth)),
+  _sem    (Semaphore::EMPTY),
+  _issued (0),
+  _next   (0),
+  _skipped(0)
+{
+  pthread_mutex_init(&_lock, NULL);
+}
+
+EbMerge::~EbMerge()
+{
+  _task->destroy();
+  pthread_mutex_destroy(&_lock);
+}
+
+void EbMerge::ticket(const Sequence& seq)
+{
+  Key key(seq);
+  pthread_mutex_lock(&_lock);
+  if (_tickets.find(key) == _tickets.end())
+    _tickets[key] = _issued++;
+  pthread_mutex_unlock(&_lock);
+}
+
+void EbMerge::expire()
+{
+  _task->call(new MergeExpire(*this));
+}
+
+void EbMerge::flush(bool post)
+{
+  _task->call(new MergeFlush(*this, post));
+  _sem.take();
+}
+
+Transition* EbMerge::transitions(Transition* tr)
+{
+  _task->call(new MergeTr(*this, tr));
+  return (Transition*)DontDelete;
+}
+
+Occurrence* EbMerge::occurrences(Occurrence* occ)
+{
+  _task->call(new MergeOcc(*this, occ));
+  return (Occurrence*)DontDelete;
+}
+
+InDatagram* EbMerge::events     (InDatagram* dg)
+{
+  _task->call(new MergeDg(*this, dg));
+  return (InDatagram*)DontDelete;
+}
+
+InDatagram* EbMerge::markers    (InDatagram* dg)
+{
+  _task->call(new MergeDg(*this, dg));
+  return (InDatagram*)DontDelete;
+}
+
+InDatagram* EbMerge::occurrences(InDatagram* dg)
+{
+  _task->call(new MergeDg(*this, dg));
+  return (InDatagram*)DontDelete;
+}
+
+void EbMerge::_forward(Transition* tr)
+{
+  _output.post(tr);
+}
+
+void EbMerge::_forward(Occurrence* occ)
+{
+  _output.post(occ);
+}
+
+bool EbMerge::_redeem(const Sequence& seq, uint64_t& ticket)
+{
+  Key key(seq);
+  pthread_mutex_lock(&_lock);
+  std::map<Key,uint64_t>::iterator it = _tickets.find(key);
+  bool found = (it != _tickets.end());
+  if (found) {
+    ticket = it->second;
+    _tickets.erase(it);
+  }
+  pthread_mutex_unlock(&_lock);
+  return found;
+}
+
+void EbMerge::_merge(InDatagram* dg)
+{
+  uint64_t ticket;
+  //  Datagrams the dispatcher never saw (e.g. generated by a shard)
+  //  and stragglers whose ticket was skipped go out immediately.
+  if (!_redeem(dg->datagram().seq, ticket) || ticket < _next) {
+    _output.post(dg);
+    return;
+  }
+
+  Held& h = _held[ticket];
+  h.dg = dg;
+  clock_gettime(CLOCK_REALTIME, &h.arrived);
+  _release();
+}
+
+bool EbMerge::_expired(const timespec& t) const
+{
+  timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  long ms = (now.tv_sec - t.tv_sec)*1000 + (now.tv_nsec - t.tv_nsec)/1000000;
+  return ms >= long(_hold);
+}
+
+void EbMerge::_release()
+{
+  while(!_held.empty()) {
+    std::map<uint64_t,Held>::iterator it = _held.begin();
+    if (it->first != _next) {
+      if (!_expired(it->second.arrived))
+        break;
+      if (nEbPrints) {
+        printf("EbMerge::_release skipping %llu tickets for seq %08x\n",
+               (unsigned long long)(it->first - _next),
+               it->second.dg->datagram().seq.stamp().fiducials());
+        nEbPrints--;
+      }
+      _skipped += it->first - _next;
+      _next = it->first;
+      _purge();
+    }
+    _output.post(it->second.dg);
+    _held.erase(it);
+    _next++;
+  }
+}
+
+//
+//  Forget the tickets that have been skipped
+//
+void EbMerge::_purge()
+{
+  pthread_mutex_lock(&_lock);
+  std::map<Key,uint64_t>::iterator it = _tickets.begin();
+  while(it != _tickets.end()) {
+    if (it->second < _next)
+      _tickets.erase(it++);
+    else
+      ++it;
+  }
+  pthread_mutex_unlock(&_lock);
+}
+
+void EbMerge::_flush(bool post)
+{
+  for(std::map<uint64_t,Held>::iterator it = _held.begin(); it != _held.end(); ++it) {
+    if (post)
+      _output.post(it->second.dg);
+    else
+      delete it->second.dg;
+  }
+  _held.clear();
+
+  pthread_mutex_lock(&_lock);
+  _tickets.clear();
+  _next = _issued;
+  pthread_mutex_unlock(&_lock);
+}
@@ -0,0 +1,83 @@
+#ifndef PDS_EBMERGE_HH
+#define PDS_EBMERGE_HH
+
+#include "Inlet.hh"
+#include "pds/service/Semaphore.hh"
+
+#include <map>
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+
+namespace Pds {
+
+  class Task;
+  class Sequence;
+
+  //
+  //  Restores the order of events completed by the shards of a sharded
+  //  event builder before posting them to the stream.  The dispatcher
+  //  issues a ticket for each event key in the order the key is first
+  //  seen; completed events are posted in ticket order from a task of
+  //  their own.  An event whose ticket is never redeemed (discarded by
+  //  its shard) holds back later events for at most "hold" milliseconds.
+  //
+  class EbMerge : public Inlet {
+  public:
+    EbMerge(Inlet& output, unsigned hold);
+    ~EbMerge();
+  public:
+    void ticket(const Sequence&);  // dispatcher thread
+    void expire();                 // release events held too long
+    void flush (bool post);        // post (or discard) all held events; waits
+  public:
+    //  Appliance interface (shard threads)
+    Transition* transitions(Transition*);
+    Occurrence* occurrences(Occurrence*);
+    InDatagram* events     (InDatagram*);
+    InDatagram* markers    (InDatagram*);
+    InDatagram* occurrences(InDatagram*);
+  public:
+    //  Merge task
+    void _merge  (InDatagram*);
+    void _forward(Transition*);
+    void _forward(Occurrence*);
+    void _release();
+    void _flush  (bool post);
+    void _flushed() { _sem.give(); }
+  public:
+    unsigned held   () const { return _held.size(); }
+    unsigned skipped() const { return _skipped; }
+  private:
+    bool _redeem(const Sequence&, uint64_t&);
+    bool _expired(const timespec&) const;
+    void _purge();
+  private:
+    class Key {
+    public:
+      Key(const Sequence&);
+      bool operator<(const Key&) const;
+    private:
+      unsigned _fiducials;
+      unsigned _ticks;
+      unsigned _vector;
+    };
+    class Held {
+    public:
+      InDatagram* dg;
+      timespec    arrived;
+    };
+    Inlet&                   _output;
+    unsigned                 _hold;
+    Task*                    _task;
+    Semaphore                _sem;
+    pthread_mutex_t          _lock;       // guards _tickets and _issued
+    std::map<Key,uint64_t>   _tickets;
+    uint64_t                 _issued;
+    std::map<uint64_t,Held>  _held;       // merge task only
+    uint64_t                 _next;
+    unsigned                 _skipped;
+  };
+}
+
+#endif
@@ -123,6 +123,8 @@ int EbS::poll()
   if (_level == Level::Segment) {
     if(!ServerManager::poll()) return 0;
     if(active().isZero()) ServerManager::arm(managed());
+    while(_drain())
+      if(active().isZero()) ServerManager::arm(managed());
     return 1;
   }
   else
@@ -20,6 +20,7 @@ namespace Pds {
     virtual bool precedes (const EbSequenceSrv& s) { return key.seq.stamp() <= s.sequence().stamp(); } 
     virtual bool coincides(const EbSequenceSrv& s) { return key.seq.stamp() == s.sequence().stamp(); } 
     virtual void assign   (const EbSequenceSrv& s) { key.seq = s.sequence(); key.env = s.env(); }
+    virtual bool hash     (const EbSequenceSrv& s, unsigned& h) { h = s.sequence().stamp().fiducials(); return true; }
 
     virtual bool precedes (const BldSequenceSrv& s) { return key.seq.stamp().fiducials() <= s.fiducials(); } 
     virtual bool coincides(const BldSequenceSrv& s) { return key.seq.stamp().fiducials() == s.fiducials(); } 
@@ -32,6 +33,7 @@ namespace Pds {
 				   ts.vector(),
 				   ts.control()));
     }
+    virtual bool hash     (const BldSequenceSrv& s, unsigned& h) { h = s.fiducials(); return true; }
 
     virtual bool precedes (const AnySequenceSrv& s) { return true; }
     virtual bool coincides(const AnySequenceSrv& s) { return true; }
@@ -40,6 +42,7 @@ namespace Pds {
     virtual bool precedes (const EvrServer& s) { return key.seq.stamp() <= s.sequence().stamp(); } 
     virtual bool coincides(const EvrServer& s) { return key.seq.stamp() == s.sequence().stamp(); } 
     virtual void assign   (const EvrServer& s) { key.seq = s.sequence(); }
+    virtual bool hash     (const EvrServer& s, unsigned& h) { h = s.sequence().stamp().fiducials(); return true; }
   public:
     const Sequence& sequence() const { return key.seq; }
     const Env&      env     () const { return key.env; }
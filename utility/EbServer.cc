@@ -133,4 +133,8 @@ unsigned EbServer::length() const { return 0; }
 
 unsigned EbServer::offset() const { return 0; }
 
+unsigned EbServer::buffered() const { return 0; }
+
+int EbServer::peek() { return -1; }
+
 bool EbServer::isRequired() const { return false; }
@@ -45,10 +45,16 @@ class EbServer : public Server
     virtual bool           more  () const;
     virtual unsigned       length() const;
     virtual unsigned       offset() const;
+    //  # of contributions already received (batched) but not yet fetched
+    virtual unsigned       buffered() const;
+    //  Present the next contribution's header (key) before it is fetched.
+    //  Returns <0 if the server can't.
+    virtual int            peek    ();
     //  Eb-key interface
     virtual bool        succeeds (EbEventKey&) const = 0;
     virtual bool        coincides(EbEventKey&) const = 0;
     virtual void        assign   (EbEventKey&) const = 0;
+    virtual bool        hash     (EbEventKey&, unsigned&) const = 0;
   private:
     int _keepAlive;       // # of contineous drops
     int _drop;            // # of of contributions dropped
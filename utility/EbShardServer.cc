@@ -0,0 +1,129 @@
+#include "EbShardServer.hh"
+#include "OutletWireHeader.hh"
+
+#include <sys/eventfd.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+
+using namespace Pds;
+
+EbShardServer::EbShardServer(const EbServer& server) :
+  _client  (server.client()),
+  _valued  (server.isValued()),
+  _required(server.isRequired()),
+  _queued  (0)
+{
+  memset(_header, 0, sizeof(_header));
+  fd(::eventfd(0, EFD_SEMAPHORE | EFD_NONBLOCK));
+}
+
+EbShardServer::~EbShardServer()
+{
+  EbShardFragment* f;
+  while( (f=_fragments.remove()) != _fragments.empty() )
+    delete f;
+  ::close(fd());
+}
+
+void EbShardServer::queue(EbShardFragment* f)
+{
+  _fragments.insert(f);
+  _queued++;
+  uint64_t one = 1;
+  ::write(fd(), &one, sizeof(one));
+}
+
+void EbShardServer::dump(int detail) const
+{
+  printf("Shard server %04X (%x/%x)  fd %d\n",
+         id(), _client.log(), _client.phy(), fd());
+  printf(" Queued %d contributions\n", _queued);
+  printf(" Dropped %d contributions\n", drops());
+}
+
+bool EbShardServer::isValued() const
+{
+  return _valued;
+}
+
+bool EbShardServer::isRequired() const
+{
+  return _required;
+}
+
+const Src& EbShardServer::client() const
+{
+  return _client;
+}
+
+const Xtc&   EbShardServer::xtc   () const
+{
+  return reinterpret_cast<const Datagram*>(_header)->xtc;
+}
+
+bool     EbShardServer::more  () const
+{
+  return reinterpret_cast<const Datagram*>(_header)->seq.isExtended();
+}
+
+unsigned EbShardServer::length() const
+{
+  return reinterpret_cast<const OutletWireHeader*>(_header)->length;
+}
+
+unsigned EbShardServer::offset() const
+{
+  return reinterpret_cast<const OutletWireHeader*>(_header)->offset;
+}
+
+//
+//  The head of the queue is only removed by this (the shard's) thread
+//
+int EbShardServer::peek()
+{
+  EbShardFragment* f = static_cast<EbShardFragment*>(_fragments.atHead());
+  if (f == _fragments.empty()) {
+    errno = EAGAIN;
+    return -1;
+  }
+  memcpy(_header, f->header, sizeof(_header));
+  return sizeof(_header);
+}
+
+//
+//  Discards the next contribution
+//
+int EbShardServer::pend(int flag)
+{
+  EbShardFragment* f = _fragments.remove();
+  if (f == _fragments.empty())
+    return 0;
+
+  uint64_t count;
+  ::read(fd(), &count, sizeof(count));
+
+  int size = f->size;
+  delete f;
+  return size;
+}
+
+int EbShardServer::fetch(char* payload, int flags)
+{
+  EbShardFragment* f = _fragments.remove();
+  if (f == _fragments.empty()) {
+    errno = EAGAIN;
+    return -1;
+  }
+
+  uint64_t count;
+  ::read(fd(), &count, sizeof(count));
+
+  memcpy(_header, f->header, sizeof(_header));
+  int size = f->size;
+  memcpy(payload, f->payload, size);
+  delete f;
+  return size;
+}
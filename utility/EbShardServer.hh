@@ -0,0 +1,81 @@
+#ifndef PDS_EBSHARDSERVER
+#define PDS_EBSHARDSERVER
+
+#include "EbServer.hh"
+#include "EbSequenceSrv.hh"
+#include "EbEventKey.hh"
+#include "Mtu.hh"
+#include "pds/service/Queue.hh"
+#include "pds/service/Pool.hh"
+#include "pds/xtc/Datagram.hh"
+
+namespace Pds {
+  //
+  //  A contribution (or contribution chunk) received by the dispatcher
+  //  of a sharded event builder, on its way to the builder shard.
+  //
+  class EbShardFragment : public Entry {
+  public:
+    PoolDeclare;
+  public:
+    char header [sizeof(Datagram)];
+    int  size;
+    char payload[Mtu::Size];
+  };
+
+  //
+  //  Stands in for a network server within one shard of a sharded event
+  //  builder.  The dispatcher queues the contributions it received on the
+  //  real server and counts them on an eventfd, which the shard selects
+  //  upon as it would on the server's socket.
+  //
+  class EbShardServer : public EbServer, EbSequenceSrv
+  {
+  public:
+    EbShardServer(const EbServer& server);
+   ~EbShardServer();
+  public:
+    void        queue   (EbShardFragment*);  // dispatcher thread
+  public:
+    //  Eb interface
+    void        dump    (int detail)   const;
+    bool        isValued()             const;
+    bool        isRequired()           const;
+    const Src&  client  ()             const;
+    //  EbSegment interface
+    const Xtc&   xtc   () const;
+    bool           more  () const;
+    unsigned       length() const;
+    unsigned       offset() const;
+    int            peek  ();
+  public:
+    //  Eb-key interface
+    EbServerDeclare;
+  public:
+    //  Server interface
+    int      pend        (int flag = 0);
+    int      fetch       (char* payload, int flags);
+  public:
+    const Sequence& sequence() const;
+    const Env&      env     () const;
+  private:
+    Src                    _client;
+    bool                   _valued;
+    bool                   _required;
+    Queue<EbShardFragment> _fragments;
+    char                   _header[sizeof(Datagram)];
+    unsigned               _queued;
+  };
+}
+
+inline const Pds::Sequence& Pds::EbShardServer::sequence() const
+{
+  return reinterpret_cast<const Pds::Datagram*>(_header)->seq;
+}
+
+inline const Pds::Env&      Pds::EbShardServer::env     () const
+{
+  return reinterpret_cast<const Pds::Datagram*>(_header)->env;
+}
+
+#endif
@@ -0,0 +1,269 @@
+#include "EbShards.hh"
+#include "EbSGroup.hh"
+#include "EbShardServer.hh"
+#include "EbMerge.hh"
+#include "EbTimeouts.hh"
+#include "NetDgServer.hh"
+#include "pds/service/Task.hh"
+#include "pds/xtc/Datagram.hh"
+#include "pdsdata/xtc/Sequence.hh"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace Pds;
+
+static const unsigned MaxServers = EbBitMask::BitMaskBits;
+static const int TaskPriority = 60;
+static const char* TaskName(int stream)
+{
+  static char name[64];
+  sprintf(name, "oEbDsp%d", stream);
+  return name;
+}
+
+//
+//  The time an event may be held waiting for an earlier one is bounded by
+//  the time the earlier one may take to be built (and timed out).
+//
+static unsigned _hold(int stream, Level::Type level, int slowEb)
+{
+  EbTimeouts tmo(stream, level, slowEb);
+  return tmo.duration()*(tmo.timeouts(0)+1);
+}
+
+EbShards::EbShards(const Src& id,
+                   const TypeId& ctns,
+                   Level::Type level,
+                   Inlet& inlet,
+                   OutletWire& outlet,
+                   int stream,
+                   int ipaddress,
+                   unsigned eventsize,
+                   unsigned eventpooldepth,
+                   int slowEb,
+                   unsigned nshards,
+                   VmonEb* vmoneb) :
+  InletWireServer(inlet, outlet, ipaddress, stream,
+                  TaskPriority-stream, TaskName(stream),
+                  EbTimeouts::duration(stream)),
+  _nshards  (nshards < 1 ? 1 : (nshards > unsigned(MaxShards) ? unsigned(MaxShards) : nshards)),
+  _merge    (new EbMerge(inlet, _hold(stream, level, slowEb))),
+  _fragments(sizeof(EbShardFragment), _nshards*FragmentDepth),
+  _oversized(0)
+{
+  unsigned depth = (eventpooldepth + _nshards - 1)/_nshards;
+  if (depth < 4) depth = 4;
+
+  for(unsigned s=0; s<_nshards; s++) {
+    _shards [s] = new EbSGroup(id, ctns, level, *_merge, outlet,
+                               stream, ipaddress,
+                               eventsize, depth, slowEb,
+                               s==0 ? vmoneb : 0);
+    _proxies[s] = new EbShardServer*[MaxServers];
+    memset(_proxies[s], 0, MaxServers*sizeof(EbShardServer*));
+    _dispatched[s] = 0;
+  }
+  printf("EbShards %u shards of depth %u\n", _nshards, depth);
+}
+
+EbShards::~EbShards()
+{
+  for(unsigned s=0; s<_nshards; s++) {
+    delete _shards[s];
+    delete[] _proxies[s];
+  }
+  delete _merge;
+}
+
+void EbShards::connect()
+{
+  for(unsigned s=0; s<_nshards; s++)
+    _shards[s]->connect();
+  InletWireServer::connect();
+}
+
+void EbShards::disconnect()
+{
+  InletWireServer::disconnect();
+  for(unsigned s=0; s<_nshards; s++)
+    _shards[s]->disconnect();
+  _merge->flush(true);
+}
+
+//
+//  Out-of-band messages are passed through the merge stage, so they
+//  remain in order with the events it has released.
+//
+void EbShards::post(const Transition& tr)
+{
+  _merge->post(const_cast<Transition*>(&tr));
+}
+
+void EbShards::post(const Occurrence& occ)
+{
+  _merge->post(const_cast<Occurrence*>(&occ));
+}
+
+void EbShards::post(const InDatagram& dg)
+{
+  _merge->post(const_cast<InDatagram*>(&dg));
+}
+
+/*
+** ++
+**
+**    Registers the network server with the dispatcher and a proxy for it
+**    with each shard.  The proxies carry the server's id, so the shards
+**    see the same set of clients the dispatcher does.
+**
+** --
+*/
+
+Server* EbShards::accept(Server* srv)
+{
+  if (!dynamic_cast<NetDgServer*>(srv)) {
+    printf("EbShards::accept unsupported server type (fd %d)\n", srv->fd());
+    return 0;
+  }
+
+  unsigned id = (~managed()).first();  // lowest free id
+  srv->id(id);
+
+  const EbServer& server = *static_cast<EbServer*>(srv);
+  for(unsigned s=0; s<_nshards; s++) {
+    EbShardServer* proxy = new EbShardServer(server);
+    _proxies[s][id] = proxy;
+    _shards [s]->add_input(proxy);
+  }
+
+  manage(srv);
+  ServerManager::arm(srv);
+  return srv;
+}
+
+void EbShards::remove(unsigned id)
+{
+  for(unsigned s=0; s<_nshards; s++) {
+    EbShardServer* proxy = _proxies[s][id];
+    if (proxy) {
+      _shards[s]->remove_input(proxy);
+      _proxies[s][id] = 0;
+    }
+  }
+  delete unmanage(server(id));
+}
+
+void EbShards::flush()
+{
+}
+
+void EbShards::key_index(bool enable)
+{
+  for(unsigned s=0; s<_nshards; s++)
+    _shards[s]->key_index(enable);
+}
+
+void EbShards::peek(bool enable)
+{
+  for(unsigned s=0; s<_nshards; s++)
+    _shards[s]->peek(enable);
+}
+
+void EbShards::setClientMask(std::vector<EbBitMask>& lGroupClientMask)
+{
+  for(unsigned s=0; s<_nshards; s++)
+    _shards[s]->setClientMask(lGroupClientMask);
+}
+
+/*
+** ++
+**
+**    Moves every contribution the server has received (including those
+**    buffered by a batched receive) to the shard owning its event.
+**    Contributions to the same event carry the same fiducials and
+**    vector, whose multiplicative hash selects the shard.
+**
+** --
+*/
+
+int EbShards::processIo(Server* srv)
+{
+  do {
+    _dispatch(srv);
+  } while( static_cast<EbServer*>(srv)->buffered() );
+  return 1;
+}
+
+void EbShards::_dispatch(Server* srv)
+{
+  NetDgServer* server = static_cast<NetDgServer*>(srv);
+  EbShardFragment* f = new(&_fragments) EbShardFragment;
+  int size = server->server().fetch(f->payload, sizeof(f->payload), MSG_DONTWAIT);
+  if (size < 0) {
+    //  Contributions arrive in Mtu sized chunks; a larger one is dropped
+    if (errno == EMSGSIZE && _oversized++ < 16)
+      printf("EbShards dropped oversized contribution from server %u\n",
+             srv->id());
+    delete f;
+    return;
+  }
+  f->size = size;
+  memcpy(f->header, server->server().datagram(), sizeof(f->header));
+
+  const Sequence& seq = server->sequence();
+  _merge->ticket(seq);
+
+  unsigned h = (seq.stamp().fiducials() ^ (seq.stamp().vector()<<17))*2654435761U;
+  unsigned s = unsigned((uint64_t(h)*_nshards)>>32);
+  _dispatched[s]++;
+  _proxies[s][srv->id()]->queue(f);
+}
+
+int EbShards::processTmo()
+{
+  _merge->expire();
+  return 1;
+}
+
+void EbShards::_flush_inputs()
+{
+  char* payload = new char[Mtu::Size];
+  for(unsigned id=0; id<MaxServers; id++) {
+    if (!managed().hasBitSet(id)) continue;
+    NetDgServer* srv = static_cast<NetDgServer*>(server(id));
+    int nbytes = 0;
+    int size;
+    while( (size = srv->server().fetch(payload, Mtu::Size, MSG_DONTWAIT)) >= 0 ||
+           errno == EMSGSIZE )
+      if (size > 0) nbytes += size;
+    if (nbytes)
+      printf("\tflushed %d bytes from server %u\n", nbytes, id);
+  }
+  delete[] payload;
+
+  for(unsigned s=0; s<_nshards; s++)
+    _shards[s]->flush_inputs();
+}
+
+void EbShards::_flush_outputs()
+{
+  for(unsigned s=0; s<_nshards; s++)
+    _shards[s]->flush_outputs();
+  _merge->flush(false);
+}
+
+void EbShards::dump(int detail)
+{
+  printf("Dump of Sharded Event Builder (%u shards)\n", _nshards);
+  printf(" %u events held for merge, %u skipped, %u oversized contributions dropped\n",
+         _merge->held(), _merge->skipped(), _oversized);
+  for(unsigned s=0; s<_nshards; s++)
+    printf(" Shard %u dispatched %u contributions\n", s, _dispatched[s]);
+  for(unsigned s=0; s<_nshards; s++) {
+    printf("--- Shard %u ---\n", s);
+    _shards[s]->dump(detail);
+  }
+}
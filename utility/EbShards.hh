@@ -0,0 +1,80 @@
+#ifndef PDS_EBSHARDS_HH
+#define PDS_EBSHARDS_HH
+
+#include <vector>
+#include "InletWireServer.hh"
+#include "pds/service/EbBitMask.hh"
+#include "pds/service/GenericPoolW.hh"
+#include "pdsdata/xtc/Src.hh"
+#include "pdsdata/xtc/TypeId.hh"
+#include "pdsdata/xtc/Level.hh"
+
+namespace Pds {
+
+  class EbSGroup;
+  class EbShardServer;
+  class EbMerge;
+  class VmonEb;
+
+  //
+  //  An event builder split into "nshards" independent builders
+  //  (EbSGroup), each on its own thread.  The dispatcher (this object)
+  //  receives on the real network servers and hands each contribution
+  //  to the shard selected by a hash of its key, so that all
+  //  contributions to an event meet in the same shard.  The completed
+  //  events are restored to their arrival order by the merge stage
+  //  (EbMerge) before entering the stream.
+  //
+  class EbShards : public InletWireServer {
+  public:
+    enum { MaxShards = 16 };
+    enum { FragmentDepth = 1024 };   // queued contributions per shard
+  public:
+    EbShards(const Src& id,
+             const TypeId& ctns,
+             Level::Type level,
+             Inlet& inlet,
+             OutletWire& outlet,
+             int stream,
+             int ipaddress,
+             unsigned eventsize,
+             unsigned eventpooldepth,
+             int slowEb,
+             unsigned nshards,
+             VmonEb* vmoneb=0);
+    ~EbShards();
+  public:
+    //  InletWire interface
+    void connect   ();
+    void disconnect();
+    void post(const Transition&);
+    void post(const Occurrence&);
+    void post(const InDatagram&);
+    void dump(int detail);
+  public:
+    //  InletWireServer interface
+    Server* accept(Server*);
+    void    remove(unsigned id);
+    void    flush ();
+  public:
+    void key_index    (bool);
+    void peek         (bool);
+    void setClientMask(std::vector<EbBitMask>&);
+  private:
+    int  processIo (Server*);
+    int  processTmo();
+    void _dispatch (Server*);
+    void _flush_inputs ();
+    void _flush_outputs();
+  private:
+    unsigned        _nshards;
+    EbSGroup*       _shards  [MaxShards];
+    EbShardServer** _proxies [MaxShards];  // indexed by server id
+    unsigned        _dispatched[MaxShards];
+    EbMerge*        _merge;
+    GenericPoolW    _fragments;
+    unsigned        _oversized;  // contributions too large for a fragment
+  };
+}
+
+#endif
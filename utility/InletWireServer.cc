@@ -171,9 +171,8 @@ int InletWireServer::commit(char* datagram,
   if (!sizeofPayload) {
     int id;
     EbBitMask inputs(managed());
-    for (id=0; id<EbBitMaskArray::BitMaskBits; id++) {
-      if ( inputs.hasBitSet(id)) remove(id);
-    }
+    for (id=inputs.first(); id<EbBitMask::BitMaskBits; id=inputs.next(id))
+      remove(id);
     for (id=0; id<EbBitMaskArray::BitMaskBits; id++) {
       if (_outputs.hasBitSet(id)) remove_output(id);
     }
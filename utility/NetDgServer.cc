@@ -74,6 +74,9 @@ void NetDgServer::dump(int detail) const
          _server.sizeofDatagram() + _server.maxPayload(),
          _server.sizeofDatagram(), _server.maxPayload());
   printf(" Dropped %d contributions\n", drops());
+  if (_server.batches())
+    printf(" Batched %d contributions in %d receives\n",
+           _server.batched(), _server.batches());
   return;
 }
 
@@ -121,6 +124,16 @@ unsigned NetDgServer::offset() const
   return ((OutletWireHeader*)_server.datagram())->offset;
 }
 
+unsigned NetDgServer::buffered() const
+{
+  return _server.buffered();
+}
+
+int NetDgServer::peek()
+{
+  return _server.peek(MSG_DONTWAIT);
+}
+
 int NetDgServer::pend(int flag)
 {
   return _server.pend(flag);
@@ -25,6 +25,8 @@ namespace Pds {
     bool           more  () const;
     unsigned       length() const;
     unsigned       offset() const;
+    unsigned       buffered() const;
+    int            peek    ();
   public:
     //  Eb-key interface
     EbServerDeclare;
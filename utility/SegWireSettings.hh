@@ -2,6 +2,7 @@
 #define PDS_SEGWIRESETTINGS_HH
 
 #include "StreamParams.hh"
+#include "pds/service/PoolPolicy.hh"
 #include "pdsdata/psddl/alias.ddl.h"
 #include <list>
 
@@ -32,6 +33,8 @@ public:
   virtual unsigned channel        () const { return -1U; }
   virtual bool     has_fiducial   () const { return false; }
   virtual bool     is_unsynced    () const { return false; }
+  //  Pages of the event builder's datagram pool (see Eb::datagram_policy)
+  virtual PoolPolicy::Pages datagram_pages() const { return PoolPolicy::Normal; }
 };
 }
 #endif
@@ -1,6 +1,7 @@
 #include "SetOfStreams.hh"
 #include "InletWire.hh"
 #include "OutletWire.hh"
+#include "pds/service/Task.hh"
 //#include "VmonManager.hh"
 
 using namespace Pds;
@@ -32,6 +33,8 @@ void SetOfStreams::dump(int stream, int detail = 1)
 {  
   _inlet_wires[stream]->dump(detail);
   _outlets[stream]->dump(detail);
+  if (stream == StreamParams::FrameWork)
+    Task::dump();
 }
 
 void SetOfStreams::dumpCounters(int stream, int detail = 1) 
@@ -7,6 +7,7 @@
 #include "pds/utility/OutletWireHeader.hh"
 #include "pds/utility/StreamPorts.hh"
 #include "pds/utility/TrafficDst.hh"
+#include "pds/utility/TrafficBatch.hh"
 #include "pds/collection/CollectionManager.hh"
 #include "pds/xtc/Datagram.hh"
 #include "pds/xtc/InDatagram.hh"
@@ -29,13 +30,15 @@ static unsigned _maxscheduled = 4;
 static unsigned tbin_shift = 10; // 1<<tbin_shift microseconds/bin
 static unsigned tbin_range = 16; // 1<<tbin_range microseconds full range
 
+static unsigned sbin_range = 64; // system calls per event full range
+
 namespace Pds {
   class FlushRoutine : public Routine {
   public:
     FlushRoutine(LinkedList<TrafficDst>& list,
-     Client&                 client,
+     TrafficBatch&           batch,
      ToEventWireScheduler*   scheduler=0) :
-      _client   (client),
+      _batch    (batch),
       _scheduler(scheduler)
     {
       _list.insertList(&list);
@@ -48,12 +51,22 @@ namespace Pds {
       if (_scheduler)
         clock_gettime(CLOCK_REALTIME, &start);
 
+      unsigned sends  = _batch.sends();
+      unsigned events = 0;
+
+      //
+      //  Chunks are queued in the same round-robin order as before and
+      //  handed to the kernel a batch at a time.  Completed traffic is
+      //  retained until the last batch is flushed, since the queued
+      //  chunks still reference its payload.
+      //
+      LinkedList<TrafficDst> done;
       unsigned cnt=_maxscheduled;
       TrafficDst* t = _list.forward();
       while(t != _list.empty()) {
         //  Fill in
         while(cnt < _maxscheduled) {
-          t->send_copy(_client,StreamPorts::sink());
+          t->send_copy(_batch,StreamPorts::sink());
           cnt++;
         }
         cnt = 0;
@@ -61,23 +74,34 @@ namespace Pds {
           cnt++;
           TrafficDst* n = t->forward();
 
-          if (!t->send_next(_client))
-            delete t->disconnect();
+          if (!t->send_next(_batch)) {
+            done.insert(t->disconnect());
+            events++;
+          }
           t = n;
         } while( t != _list.empty());
         t = _list.forward();
       }
+      _batch.flush();
+
+      t = done.forward();
+      while(t != done.empty()) {
+        TrafficDst* n = t->forward();
+        delete t->disconnect();
+        t = n;
+      }
 
       if (_scheduler) {
         clock_gettime(CLOCK_REALTIME, &end);
         _scheduler->histo(start,end);
+        _scheduler->sends(_batch.sends()-sends, events);
       }
 
       delete this;
     }
   private:
     LinkedList<TrafficDst>  _list;
-    Client&                 _client;
+    TrafficBatch&           _batch;
     ToEventWireScheduler*   _scheduler;
   };
 };
@@ -122,7 +146,8 @@ ToEventWireScheduler::ToEventWireScheduler(Outlet& outlet,
   _nscheduled  (0),
   _scheduled   (0),
   _task        (new Task(TaskObject("TxScheduler"))),
-  _flush_task  (new Task(TaskObject("TxFlush")))
+  _flush_task  (new Task(TaskObject("TxFlush"))),
+  _batch       (new TrafficBatch(_client))
 {
   _flushCount = 0;
 
@@ -134,6 +159,11 @@ ToEventWireScheduler::ToEventWireScheduler(Outlet& outlet,
   _histo = new MonEntryTH1F(sendtime);
   group->add(_histo);
 
+  MonDescTH1F sendcalls("Sends per Event", "syscalls", "",
+                        sbin_range, 0., float(sbin_range));
+  _sends = new MonEntryTH1F(sendcalls);
+  group->add(_sends);
+
   if (::pipe(_schedfd) < 0)
     printf("ToEventWireScheduler pipe open error : %s\n",strerror(errno));
   else
@@ -145,6 +175,7 @@ ToEventWireScheduler::~ToEventWireScheduler()
   ::close(_schedfd[0]);
   ::close(_schedfd[1]);
   _task->destroy();
+  delete _batch;
 }
 
 Transition* ToEventWireScheduler::forward(Transition* tr)
@@ -185,7 +216,7 @@ void ToEventWireScheduler::_flush(InDatagram* dg)
   TrafficDst* n = dg->traffic(_bcast);
   _list.insert(n);
 
-  _flush_task->call( new FlushRoutine(_list,_client) );
+  _flush_task->call( new FlushRoutine(_list,*_batch) );
 }
 
 void ToEventWireScheduler::_flush()
@@ -199,7 +230,7 @@ void ToEventWireScheduler::_flush()
   timeval timeSleepMicro = {0, _phase*_interval};
   select( 0, NULL, NULL, NULL, &timeSleepMicro);
 
-  _flush_task->call( new FlushRoutine(_list,_client,this) );
+  _flush_task->call( new FlushRoutine(_list,*_batch,this) );
   _scheduled  = 0;
   _nscheduled = 0;
 }
@@ -296,10 +327,28 @@ void ToEventWireScheduler::histo(timespec& start, timespec& end)
   diff += double(end.tv_nsec)*1.e-9;
   diff -= double(start.tv_nsec)*1.e-9;
   unsigned udiff = unsigned(diff*1.e6);
+  //  Called from the flush task, while the monitoring server reads
+  MonShard& shard = _histo->shard();
   if (udiff >> tbin_range)
-    _histo->addinfo(1.,MonEntryTH1F::Overflow);
+    _histo->addinfo(1.,MonEntryTH1F::Overflow,shard);
+  else
+    _histo->addcontent(1.,udiff >> tbin_shift,shard);
+
+  shard.time(ClockTime(end.tv_sec,end.tv_nsec));
+}
+
+void ToEventWireScheduler::sends(unsigned calls, unsigned events)
+{
+  if (!events) return;
+
+  double n = double(calls)/double(events);
+  MonShard& shard = _sends->shard();
+  if (n >= double(sbin_range))
+    _sends->addinfo(double(events),MonEntryTH1F::Overflow,shard);
   else
-    _histo->addcontent(1.,udiff >> tbin_shift);
+    _sends->addcontent(double(events),unsigned(n),shard);
 
-  _histo ->time(ClockTime(end.tv_sec,end.tv_nsec));
+  timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  shard.time(ClockTime(now.tv_sec,now.tv_nsec));
 }
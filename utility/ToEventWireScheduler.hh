@@ -17,6 +17,7 @@ namespace Pds {
   class Task;
   class TrafficDst;
   class TrafficScheduler;
+  class TrafficBatch;
   class MonEntryTH1F;
 
   class ToEventWireScheduler : public OutletWire,
@@ -50,6 +51,7 @@ namespace Pds {
     void _flush();
   public:
     void histo(timespec&, timespec&);
+    void sends(unsigned calls, unsigned events);
   private:
     OutletWireInsList  _nodes;
     CollectionManager& _collection;
@@ -65,6 +67,8 @@ namespace Pds {
     int                    _schedfd[2];
     unsigned               _flushCount;
     MonEntryTH1F*          _histo;
+    TrafficBatch*          _batch;
+    MonEntryTH1F*          _sends;
   };
 }
 
@@ -0,0 +1,55 @@
+#include "TrafficBatch.hh"
+
+#include <string.h>
+
+using namespace Pds;
+
+TrafficBatch::TrafficBatch(Client& client) :
+  _client  (client),
+  _headers (new char[Client::MaxBatch*client.sizeofDatagram()]),
+  _depth   (0),
+  _sends   (0),
+  _messages(0)
+{
+}
+
+TrafficBatch::~TrafficBatch()
+{
+  delete[] _headers;
+}
+
+void TrafficBatch::queue(const char* header,
+                         const char* payload,
+                         int         sizeofPayload,
+                         const Ins&  dst,
+                         bool        copyHeader)
+{
+  Client::Message& m = _msg[_depth];
+  if (header && copyHeader) {
+    int size = _client.sizeofDatagram();
+    m.datagram = _headers + _depth*size;
+    memcpy(m.datagram, header, size);
+  }
+  else
+    m.datagram = const_cast<char*>(header);
+  m.payload       = const_cast<char*>(payload);
+  m.sizeofPayload = sizeofPayload;
+  m.dst           = dst;
+
+  if (++_depth == Client::MaxBatch)
+    flush();
+}
+
+void TrafficBatch::flush()
+{
+  if (!_depth) return;
+
+  unsigned batches = _client.batches();
+  int error;
+  if ((error = _client.send(_msg, _depth)))
+    ;
+  unsigned calls = _client.batches() - batches;
+  _sends    += calls ? calls : _depth;  // unbatched fallback: one call per datagram
+  _messages += _depth;
+  _depth     = 0;
+}
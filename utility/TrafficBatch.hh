@@ -0,0 +1,40 @@
+#ifndef TrafficBatch_hh
+#define TrafficBatch_hh
+
+#include "pds/service/Client.hh"
+
+namespace Pds {
+  //
+  //  Accumulates datagram chunks for transmission and hands them to
+  //  the client in groups of up to Client::MaxBatch per system call.
+  //  Chunk headers which are not stable until the batch is flushed
+  //  (e.g. DgChunkIterator's) are copied into local storage.
+  //
+  class TrafficBatch {
+  public:
+    TrafficBatch(Client&);
+    ~TrafficBatch();
+  public:
+    void queue(const char* header,
+               const char* payload,
+               int         sizeofPayload,
+               const Ins&  dst,
+               bool        copyHeader);
+    void flush();
+  public:
+    unsigned sends   () const;  // system calls issued
+    unsigned messages() const;  // datagrams transmitted
+  private:
+    Client&         _client;
+    Client::Message _msg[Client::MaxBatch];
+    char*           _headers;
+    unsigned        _depth;
+    unsigned        _sends;
+    unsigned        _messages;
+  };
+}
+
+inline unsigned Pds::TrafficBatch::sends   () const { return _sends; }
+inline unsigned Pds::TrafficBatch::messages() const { return _messages; }
+
+#endif
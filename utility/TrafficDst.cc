@@ -2,7 +2,7 @@
 
 #include "pds/xtc/CDatagram.hh"
 #include "pds/utility/ChunkIterator.hh"
-#include "pds/service/Client.hh"
+#include "pds/utility/TrafficBatch.hh"
 
 namespace Pds {
   class VirtualTraffic : public TrafficDst {
@@ -10,8 +10,8 @@ namespace Pds {
     VirtualTraffic(CDatagram*);
     ~VirtualTraffic();
   public:
-    bool send_next(Client&);
-    void send_copy(Client&,const Ins&) {}
+    bool send_next(TrafficBatch&);
+    void send_copy(TrafficBatch&,const Ins&) {}
   public:
     TrafficDst* clone() const;
   private:
@@ -41,49 +41,41 @@ CTraffic::~CTraffic()
   delete _dg; 
 }
 
-bool CTraffic::send_next(Client& client)
+bool CTraffic::send_next(TrafficBatch& batch)
 {
   if (_iter) {
-    int error;
-    if((error = client.send((char*)_iter->header(),
-			    (char*)_iter->payload(),
-			    _iter->payloadSize(),
-			    _dst)))
-      ;
+    batch.queue((const char*)_iter->header(),
+                _iter->payload(),
+                _iter->payloadSize(),
+                _dst, true);
     return _iter->next();
   }
   else {
     const Datagram& datagram = _dg->datagram();
     unsigned size = datagram.xtc.extent;
-    int error;
-    if ((error = client.send((char*)&datagram,
-			     (char*)&datagram.xtc,
-			     size,
-			     _dst)))
-      ;
+    batch.queue((const char*)&datagram,
+                (const char*)&datagram.xtc,
+                size,
+                _dst, false);
     return false;
   }
 }
 
-void CTraffic::send_copy(Client& client, const Ins& dst)
+void CTraffic::send_copy(TrafficBatch& batch, const Ins& dst)
 {
   if (_iter) {
-    int error;
-    if((error = client.send((char*)_iter->header(),
-			    (char*)_iter->payload(),
-			    _iter->payloadSize(),
-			    dst)))
-      ;
+    batch.queue((const char*)_iter->header(),
+                _iter->payload(),
+                _iter->payloadSize(),
+                dst, true);
   }
   else {
     const Datagram& datagram = _dg->datagram();
     unsigned size = datagram.xtc.extent;
-    int error;
-    if ((error = client.send((char*)&datagram,
-			     (char*)&datagram.xtc,
-			     size,
-			     dst)))
-      ;
+    batch.queue((const char*)&datagram,
+                (const char*)&datagram.xtc,
+                size,
+                dst, false);
   }
 }
 
@@ -111,26 +103,22 @@ VirtualTraffic::~VirtualTraffic()
   if (_iter) delete _iter; 
 }
 
-bool VirtualTraffic::send_next(Client& client)
+bool VirtualTraffic::send_next(TrafficBatch& batch)
 {
   if (_iter) {
-    int error;
-    if((error = client.send((char*)_iter->header(),
-			    (char*)_iter->payload(),
-			    _iter->payloadSize(),
-			    _dst)))
-      ;
+    batch.queue((const char*)_iter->header(),
+                _iter->payload(),
+                _iter->payloadSize(),
+                _dst, true);
     return _iter->next();
   }
   else {
     const Datagram& datagram = _dg->datagram();
     unsigned size = datagram.xtc.extent;
-    int error;
-    if ((error = client.send((char*)&datagram,
-			     (char*)&datagram.xtc,
-			     size,
-			     _dst)))
-      ;
+    batch.queue((const char*)&datagram,
+                (const char*)&datagram.xtc,
+                size,
+                _dst, false);
     return false;
   }
 }
@@ -5,15 +5,15 @@
 #include "pds/service/LinkedList.hh"
 
 namespace Pds {
-  class Client;
+  class TrafficBatch;
   class DgChunkIterator;
   class CDatagram;
 
   class TrafficDst : public LinkedList<TrafficDst> {
   public:
     virtual ~TrafficDst() {}
-    virtual bool send_next(Client&) = 0;
-    virtual void send_copy(Client&,const Ins&) = 0;
+    virtual bool send_next(TrafficBatch&) = 0;
+    virtual void send_copy(TrafficBatch&,const Ins&) = 0;
     virtual TrafficDst* clone() const = 0;
   };
 
@@ -22,8 +22,8 @@ namespace Pds {
     CTraffic(CDatagram*, const Ins&);
     ~CTraffic();
   public:
-    bool send_next(Client&);
-    void send_copy(Client&,const Ins&);
+    bool send_next(TrafficBatch&);
+    void send_copy(TrafficBatch&,const Ins&);
   public:
     TrafficDst* clone() const;
   private:
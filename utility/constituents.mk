@@ -8,5 +8,15 @@ libnames := utility
 #CXXFLAGS += -DBUILD_READOUT_GROUP -DBUILD_PRINCETON -DBUILD_PACKAGE_SPACE # for princeton camera and the switch problem
 #CXXFLAGS += -DBUILD_READOUT_GROUP  # for running devices with different readout rate
 
+ignore_src := ebindexbench.cc
+
 libsrcs_utility := $(filter-out $(ignore_src),$(wildcard *.cc))
-libincs_utility := pdsdata/include
\ No newline at end of file
+libincs_utility := pdsdata/include
+
+tgtnames := ebindexbench
+
+tgtsrcs_ebindexbench := ebindexbench.cc
+tgtlibs_ebindexbench := pds/utility pds/service pds/xtc pds/collection pds/vmon pds/mon
+tgtlibs_ebindexbench += pdsdata/xtcdata
+tgtslib_ebindexbench := $(USRLIBDIR)/rt
+tgtincs_ebindexbench := pdsdata/include
\ No newline at end of file
@@ -0,0 +1,185 @@
+//
+//  Microbenchmark of the event builder's contribution lookup ("_seek"):
+//  a traversal of the pending queue versus the key index (EbEventIndex).
+//  N synthetic events are kept pending and contributions are matched
+//  against them in random order, as happens with slow contributors or
+//  out-of-order delivery.
+//
+#include "pds/utility/EbEventBase.hh"
+#include "pds/utility/EbEventIndex.hh"
+#include "pds/utility/EbEventKey.hh"
+#include "pds/utility/EbCountSrv.hh"
+#include "pds/xtc/Datagram.hh"
+#include "pds/service/GenericPool.hh"
+#include "pdsdata/xtc/TypeId.hh"
+#include "pdsdata/xtc/ProcInfo.hh"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+
+namespace Pds {
+  class BenchSrv : public EbCountSrv {
+  public:
+    BenchSrv() : _count(0) {}
+  public:
+    unsigned count() const { return _count; }
+    void     count(unsigned c) { _count = c; }
+  private:
+    unsigned _count;
+  };
+
+  class BenchKey : public EbEventKey {
+  public:
+    BenchKey(Datagram& dg, unsigned key) : _key(key), _dg(dg) {}
+  public:
+    bool precedes (const EbCountSrv& s) { return _key <= s.count(); }
+    bool coincides(const EbCountSrv& s) { return _key == s.count(); }
+    void assign   (const EbCountSrv& s) { _key = s.count(); }
+    bool hash     (const EbCountSrv& s, unsigned& h) { h = s.count(); return true; }
+  public:
+    const Sequence& sequence() const { return _dg.seq; }
+    unsigned        value   () const { return _key; }
+  private:
+    unsigned  _key;
+    Datagram& _dg;
+  };
+
+  class BenchEvent : public EbEventBase {
+  public:
+    BenchEvent(EbBitMask creator, EbBitMask contract, Datagram* dg, EbEventKey* key) :
+      EbEventBase(creator, contract, dg, key) {}
+  public:
+    InDatagram* finalize() { return 0; }
+  };
+}
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+//  As EbBase::_seek without the index
+static EbEventBase* seek_list(LinkedList<EbEventBase>& pending,
+                              const BenchSrv& srv,
+                              const EbBitMask& serverId)
+{
+  EbEventBase* event = pending.forward();
+  while( event != pending.empty() ) {
+    if( event->key().coincides(srv) &&
+        (!(event->segments() & serverId).isZero() ||
+         event->allocated().insert(serverId).isZero()) )
+      return event;
+    event = event->forward();
+  }
+  return 0;
+}
+
+//  As EbBase::_seek with the index
+static EbEventBase* seek_index(const EbEventIndex& index,
+                               const BenchSrv& srv,
+                               const EbBitMask& serverId,
+                               EbEventKey& any)
+{
+  unsigned hash;
+  any.hash(srv, hash);
+  for(EbEventBase* event = index.lookup(hash); event; event = index.next(event)) {
+    if( event->key().coincides(srv) &&
+        (!(event->segments() & serverId).isZero() ||
+         event->allocated().insert(serverId).isZero()) )
+      return event;
+  }
+  return 0;
+}
+
+void usage(const char* p)
+{
+  printf("Usage: %s [-n <max pending events>] [-i <lookups per depth>]\n",p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned maxDepth = 1024;
+  unsigned nlookups = 1000000;
+
+  int c;
+  while ((c = getopt(argc, argv, "n:i:h")) != -1) {
+    switch(c) {
+    case 'n': maxDepth = strtoul(optarg,NULL,0); break;
+    case 'i': nlookups = strtoul(optarg,NULL,0); break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  const ProcInfo src(Level::Event, getpid(), 0);
+  const TypeId   ctns(TypeId::Id_Xtc, 0);
+
+  EbBitMask contract;
+  contract.setBit(0);
+  contract.setBit(1);
+  EbBitMask serverId;
+  serverId.setBit(1);
+
+  unsigned* keys = new unsigned[nlookups];
+
+  printf("%8s %12s %12s %8s\n","pending","list [ns]","index [ns]","ratio");
+  for(unsigned depth=4; depth<=maxDepth; depth<<=1) {
+    LinkedList<EbEventBase> pending;
+    EbEventIndex            index(depth);
+    GenericPool  dgpool(sizeof(Datagram), depth);
+    BenchEvent** events = new BenchEvent*[depth];
+
+    //  Events already started by server 0; server 1 is yet to contribute
+    for(unsigned i=0; i<depth; i++) {
+      Datagram* dg = new(&dgpool) Datagram(ctns, src);
+      EbBitMask creator;
+      creator.setBit(0);
+      events[i] = new BenchEvent(creator, contract, dg,
+                                 new BenchKey(*dg, 0x1000+i));
+      pending.insert(events[i]);
+      index.update(events[i]);
+    }
+
+    srand(depth);
+    for(unsigned i=0; i<nlookups; i++)
+      keys[i] = 0x1000 + (rand()%depth);
+
+    BenchSrv srv;
+    unsigned found = 0;
+
+    double t0 = now();
+    for(unsigned i=0; i<nlookups; i++) {
+      srv.count(keys[i]);
+      EbEventBase* event = seek_list(pending, srv, serverId);
+      if (event) { event->deallocate(serverId); found++; }
+    }
+    double t1 = now();
+    for(unsigned i=0; i<nlookups; i++) {
+      srv.count(keys[i]);
+      EbEventBase* event = seek_index(index, srv, serverId, events[0]->key());
+      if (event) { event->deallocate(serverId); found++; }
+    }
+    double t2 = now();
+
+    if (found != 2*nlookups)
+      printf("lookup mismatch: found %u of %u\n", found, 2*nlookups);
+
+    double tl = 1.e9*(t1-t0)/double(nlookups);
+    double ti = 1.e9*(t2-t1)/double(nlookups);
+    printf("%8u %12.1f %12.1f %8.1f\n", depth, tl, ti, tl/ti);
+
+    for(unsigned i=0; i<depth; i++) {
+      delete events[i]->datagram();
+      delete events[i];
+    }
+    delete[] events;
+  }
+
+  delete[] keys;
+  return 0;
+}
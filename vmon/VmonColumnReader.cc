@@ -0,0 +1,312 @@
+#include "pds/vmon/VmonColumnReader.hh"
+
+#include "pds/vmon/VmonReader.hh"
+#include "pds/vmon/VmonRecord.hh"
+#include "pds/mon/MonCds.hh"
+#include "pds/mon/MonGroup.hh"
+#include "pds/mon/MonEntry.hh"
+#include "pds/mon/MonDescEntry.hh"
+#include "pds/mon/MonUsage.hh"
+#include "pds/mon/MonStatsScalar.hh"
+#include "pds/mon/MonStats1D.hh"
+#include "pds/mon/MonStats2D.hh"
+
+#include <new>
+
+using namespace Pds;
+using namespace Pds::VmonColumns;
+
+bool VmonColumnReader::valid(FILE* file)
+{
+  FileHeader header;
+  fseek(file, 0, SEEK_SET);
+  bool result = fread(&header, sizeof(header), 1, file)==1 &&
+    header.magic == FileMagic && header.version == Version;
+  fseek(file, 0, SEEK_SET);
+  return result;
+}
+
+VmonColumnReader::VmonColumnReader(FILE* file) :
+  _file (file),
+  _buff (new char[VmonRecord::MaxLength]),
+  _begin(0,0),
+  _end  (0,0)
+{
+  FileHeader header;
+  fseek(_file, 0, SEEK_SET);
+  fread(&header, sizeof(header), 1, _file);
+  _chunkRecords = header.chunkRecords;
+
+  fread(_buff, sizeof(VmonRecord), 1, _file);
+  VmonRecord* record = new (_buff) VmonRecord;
+  unsigned size = record->len()-sizeof(VmonRecord);
+  record = new (_buff) VmonRecord;
+  fread(record+1, size, 1, _file);
+
+  vector<int*> offsets;
+  record->extract(_src, _cds, offsets);
+  unsigned base = 0;
+  for(unsigned i=0; i<_cds.size(); i++) {
+    _base.push_back(base);
+    base += _cds[i]->totalentries();
+    delete[] offsets[i];
+  }
+
+  unsigned offset = 0;
+  for(unsigned c=0; c<header.ncolumns; c++) {
+    uint32_t size;
+    fread(&size, sizeof(size), 1, _file);
+    _column.push_back(size);
+    _offset.push_back(offset);
+    offset += size;
+  }
+
+  _data = ftell(_file);
+  _time = new ClockTime[_chunkRecords];
+
+  if (!_read_index()) {
+    printf("VmonColumnReader: no index, scanning chunks\n");
+    _scan();
+  }
+
+  if (!_index.empty()) {
+    _begin = _index.front().first;
+    _end   = _index.back ().last;
+  }
+}
+
+VmonColumnReader::~VmonColumnReader()
+{
+  reset();
+
+  for(vector<MonCds*>::iterator it = _cds.begin(); it!=_cds.end(); it++)
+    delete *it;
+
+  delete[] _time;
+  delete[] _buff;
+}
+
+bool VmonColumnReader::_read_index()
+{
+  Trailer trailer;
+  if (fseek(_file, -long(sizeof(trailer)), SEEK_END) ||
+      fread(&trailer, sizeof(trailer), 1, _file)!=1 ||
+      trailer.magic != TrailerMagic)
+    return false;
+
+  //  Follow the index blocks from the last to the first
+  vector<IndexEntry> entries;
+  uint64_t position = trailer.index;
+  while(position) {
+    IndexHeader index;
+    fseek(_file, position, SEEK_SET);
+    if (fread(&index, sizeof(index), 1, _file)!=1 ||
+        index.magic != IndexMagic)
+      return false;
+    unsigned n = entries.size();
+    entries.resize(n+index.nchunks);
+    fread(&entries[n], sizeof(IndexEntry), index.nchunks, _file);
+    //  Reverse each block, to reverse the whole after
+    for(unsigned i=0; i<index.nchunks/2; i++) {
+      IndexEntry t = entries[n+i];
+      entries[n+i] = entries[n+index.nchunks-1-i];
+      entries[n+index.nchunks-1-i] = t;
+    }
+    position = index.previous;
+  }
+  if (entries.size() != trailer.nchunks)
+    return false;
+
+  _index.assign(entries.rbegin(), entries.rend());
+  return true;
+}
+
+void VmonColumnReader::_scan()
+{
+  fseek(_file, 0, SEEK_END);
+  long end = ftell(_file);
+
+  long position = _data;
+  while(position < end) {
+    ChunkHeader chunk;
+    fseek(_file, position, SEEK_SET);
+    if (fread(&chunk, sizeof(chunk), 1, _file)!=1)
+      break;
+    if (chunk.magic == ChunkMagic) {
+      if (position + long(chunk.length) > end ||
+          chunk.nrecords > _chunkRecords)
+        break;  // incomplete
+      IndexEntry entry;
+      entry.first    = chunk.first;
+      entry.last     = chunk.last;
+      entry.offset   = position;
+      entry.nrecords = chunk.nrecords;
+      entry.reserved = 0;
+      _index.push_back(entry);
+      position += chunk.length;
+    }
+    else if (chunk.magic == IndexMagic) {
+      //  The count of an index header is where that of a chunk is
+      position += sizeof(IndexHeader) + chunk.nrecords*sizeof(IndexEntry);
+    }
+    else
+      break;
+  }
+}
+
+const vector<Src>& VmonColumnReader::sources() const { return _src; }
+
+const MonCds* VmonColumnReader::cds(const Src& src) const
+{
+  int i=0;
+  for(vector<Src>::const_iterator it=_src.begin(); it!=_src.end(); it++, i++)
+    if (src == *it)
+      return _cds[i];
+  return 0;
+}
+
+const ClockTime& VmonColumnReader::begin() const { return _begin; }
+const ClockTime& VmonColumnReader::end  () const { return _end  ; }
+
+void VmonColumnReader::reset()
+{
+  for(unsigned i=0; i<_req_col.size(); i++) {
+    for(char** b=_req_buf[i]; *b; b++)
+      delete[] *b;
+    delete[] _req_buf[i];
+    delete[] _req_col[i];
+  }
+  _req_buf.clear();
+  _req_col.clear();
+  _req_use.clear();
+  _req_src.clear();
+}
+
+void VmonColumnReader::use(const Src& src, const MonUsage& usage)
+{
+  if (!usage.used()) return;
+
+  int i=0;
+  for(vector<Src>::iterator it=_src.begin(); it!=_src.end(); it++, i++) {
+    if (*it == src) {
+      const MonCds* cds = _cds[i];
+      unsigned* col = new unsigned[usage.used()];
+      char**    buf = new char*  [usage.used()+1];
+      for(unsigned short u=0; u<usage.used(); u++) {
+	int s = usage.signature(u);
+	int n=0;
+	for(unsigned short g = 0; g < (s>>16); g++)
+	  n += cds->group(g)->nentries();
+	n += s & 0xffff;
+	col[u] = _base[i]+n;
+	buf[u] = new char[_column[col[u]]*_chunkRecords];
+      }
+      buf[usage.used()] = 0;
+
+      _req_src.push_back(src);
+      _req_use.push_back(&usage);
+      _req_col.push_back(col);
+      _req_buf.push_back(buf);
+    }
+  }
+}
+
+//  The first chunk which ends at or after "begin"
+unsigned VmonColumnReader::_first(const ClockTime& begin) const
+{
+  unsigned lo=0, hi=_index.size();
+  while(lo < hi) {
+    unsigned mid = (lo+hi)/2;
+    if (begin > _index[mid].last)
+      lo = mid+1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+void VmonColumnReader::_times(const IndexEntry& entry) const
+{
+  fseek(_file, entry.offset+sizeof(ChunkHeader), SEEK_SET);
+  fread(_time, sizeof(ClockTime), entry.nrecords, _file);
+}
+
+void VmonColumnReader::process(VmonReaderCallback& callback,
+			       const ClockTime& begin,
+			       const ClockTime& end)
+{
+  for(unsigned k=_first(begin); k<_index.size(); k++) {
+    const IndexEntry& entry = _index[k];
+    if (entry.first > end)
+      break;
+
+    _times(entry);
+    unsigned n  = entry.nrecords;
+    unsigned r0 = 0;
+    while(r0 < n && begin > _time[r0]) r0++;
+    unsigned r1 = r0;
+    while(r1 < n && !(_time[r1] > end)) r1++;
+    if (k==0 && r0==0) r0++;  // first record is often incomplete/corrupt
+    if (r0 >= r1) continue;
+
+    //  Read the records in range of each column in use
+    long columns = entry.offset + sizeof(ChunkHeader) + n*sizeof(ClockTime);
+    for(unsigned i=0; i<_req_src.size(); i++) {
+      for(unsigned short u=0; u<_req_use[i]->used(); u++) {
+        unsigned c    = _req_col[i][u];
+        unsigned size = _column[c];
+        fseek(_file, columns + _offset[c]*n + r0*size, SEEK_SET);
+        fread(_req_buf[i][u], size, r1-r0, _file);
+      }
+    }
+
+    for(unsigned r=r0; r<r1; r++) {
+      const ClockTime& time = _time[r];
+      for(unsigned i=0; i<_req_src.size(); i++) {
+        const Src& src = _req_src[i];
+        const MonCds& cds = *this->cds(src);
+        const MonUsage& usage = *_req_use[i];
+        for(unsigned short u = 0; u < usage.used(); u++) {
+          const char* stats = _req_buf[i][u] + (r-r0)*_column[_req_col[i][u]];
+          switch(cds.entry(usage.signature(u))->desc().type()) {
+          case MonDescEntry::Scalar:
+            callback.process(time, src, usage.signature(u),
+                             *reinterpret_cast<const MonStatsScalar*>(stats));
+            break;
+          case MonDescEntry::TH1F:
+            callback.process(time, src, usage.signature(u),
+                             *reinterpret_cast<const MonStats1D*>(stats));
+            break;
+          case MonDescEntry::TH2F:
+            callback.process(time, src, usage.signature(u),
+                             *reinterpret_cast<const MonStats2D*>(stats));
+            break;
+          default:
+            break;
+          }
+        }
+      }
+      callback.end_record();
+    }
+  }
+}
+
+unsigned VmonColumnReader::nrecords(const ClockTime& begin,
+				    const ClockTime& end) const
+{
+  unsigned n=0;
+  for(unsigned k=_first(begin); k<_index.size(); k++) {
+    const IndexEntry& entry = _index[k];
+    if (entry.first > end)
+      break;
+    if (!(begin > entry.first) && !(entry.last > end)) {
+      n += entry.nrecords;
+      continue;
+    }
+    _times(entry);
+    for(unsigned r=0; r<entry.nrecords; r++)
+      if (!(begin > _time[r]) && !(_time[r] > end))
+        n++;
+  }
+  return n;
+}
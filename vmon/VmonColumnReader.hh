@@ -0,0 +1,76 @@
+#ifndef Pds_VmonColumnReader_hh
+#define Pds_VmonColumnReader_hh
+
+#include "pds/vmon/VmonColumns.hh"
+#include "pdsdata/xtc/ClockTime.hh"
+#include "pdsdata/xtc/Src.hh"
+
+#include <stdio.h>
+
+#include <vector>
+using std::vector;
+
+namespace Pds {
+
+  class MonCds;
+  class MonUsage;
+  class VmonReaderCallback;
+
+  //
+  //  Reads vmon records in the indexed format (see VmonColumns.hh).  A
+  //  time range is found from the index, and only the columns of the
+  //  entries in use are read, within the range.
+  //
+  class VmonColumnReader {
+  public:
+    VmonColumnReader(FILE*);
+    ~VmonColumnReader();
+  public:
+    //  The file is in this format
+    static bool valid(FILE*);
+  public:
+    const vector<Src>& sources() const;
+    const MonCds* cds(const Src&) const;
+    const ClockTime& begin() const;
+    const ClockTime& end  () const;
+    unsigned nrecords(const ClockTime& begin,
+		      const ClockTime& end) const;
+  public:
+    void reset();
+    void use  (const Src&, const MonUsage&);
+  public:
+    void process(VmonReaderCallback&,
+		 const ClockTime& begin,
+		 const ClockTime& end);
+  private:
+    bool     _read_index();
+    void     _scan      ();
+    unsigned _first     (const ClockTime& begin) const;
+    void     _times     (const VmonColumns::IndexEntry&) const;
+  private:
+    FILE*                _file;
+    char*                _buff;
+    //  contents
+    std::vector<Src>       _src;
+    std::vector<MonCds*>   _cds;
+    std::vector<unsigned>  _base;     // first column of each source
+    std::vector<unsigned>  _column;   // size of each column
+    std::vector<unsigned>  _offset;   // offset of each column in a record
+    unsigned             _chunkRecords;
+    long                 _data;       // start of the chunks
+    std::vector<VmonColumns::IndexEntry> _index;
+    mutable ClockTime*   _time;
+
+    ClockTime            _begin;
+    ClockTime            _end;
+
+    //  requests
+    std::vector<Src>             _req_src;
+    std::vector<const MonUsage*> _req_use;
+    std::vector<unsigned*>       _req_col;
+    std::vector<char**>          _req_buf;  // a chunk of each column
+  };
+
+};
+
+#endif
@@ -0,0 +1,189 @@
+#include "pds/vmon/VmonColumnWriter.hh"
+
+#include "pds/vmon/VmonRecord.hh"
+#include "pds/mon/MonCds.hh"
+#include "pdsdata/xtc/Src.hh"
+
+#include <string.h>
+#include <new>
+
+using namespace Pds;
+using namespace Pds::VmonColumns;
+
+VmonColumnWriter::VmonColumnWriter(FILE* file, VmonRecord& description) :
+  _file     (file),
+  _size     (0),
+  _nrecords (0),
+  _lastIndex(0),
+  _nchunks  (0)
+{
+  //  The columns are the entries, in the order of their offsets
+  vector<Src    > src;
+  vector<MonCds*> cds;
+  vector<int*   > offsets;
+  unsigned end = description.extract(src, cds, offsets);
+
+  vector<unsigned> offset;
+  for(unsigned i=0; i<cds.size(); i++) {
+    for(unsigned e=0; e<cds[i]->totalentries(); e++)
+      offset.push_back(offsets[i][e]);
+    delete cds[i];
+    delete[] offsets[i];
+  }
+  offset.push_back(end);
+  for(unsigned c=0; c+1<offset.size(); c++)
+    _column.push_back(offset[c+1]-offset[c]);
+
+  _rowLength    = end - sizeof(VmonRecord);
+  _chunkRecords = _rowLength ? ChunkBytes/_rowLength : MaxChunkRecords;
+  if (_chunkRecords < 1              ) _chunkRecords = 1;
+  if (_chunkRecords > MaxChunkRecords) _chunkRecords = MaxChunkRecords;
+
+  _rows    = new char[(_chunkRecords+1)*_rowLength];
+  _columns = new char[_chunkRecords*_rowLength];
+  _times   = new ClockTime[_chunkRecords];
+  memset(_rows, 0, (_chunkRecords+1)*_rowLength);
+
+  FileHeader header;
+  header.magic        = FileMagic;
+  header.version      = Version;
+  header.chunkRecords = _chunkRecords;
+  header.ncolumns     = _column.size();
+  _write(&header, sizeof(header));
+  _write(&description, description.len());
+  for(unsigned c=0; c<_column.size(); c++) {
+    uint32_t size = _column[c];
+    _write(&size, sizeof(size));
+  }
+}
+
+VmonColumnWriter::~VmonColumnWriter()
+{
+  delete[] _rows;
+  delete[] _columns;
+  delete[] _times;
+}
+
+void VmonColumnWriter::append(const VmonRecord& payload)
+{
+  if (_nrecords == _chunkRecords)
+    _chunk();
+
+  //  A record missing some clients' payloads keeps their last stats, as
+  //  the flat format does.  The last row is kept past the chunk's rows.
+  char* last = _rows + _chunkRecords*_rowLength;
+  unsigned len = payload.len() - sizeof(VmonRecord);
+  memcpy(last, &payload+1, len < _rowLength ? len : _rowLength);
+  memcpy(_rows + _nrecords*_rowLength, last, _rowLength);
+  _times[_nrecords++] = payload.time();
+}
+
+void VmonColumnWriter::close()
+{
+  _chunk();
+  if (!_entries.empty())
+    _index();
+
+  Trailer trailer;
+  trailer.index   = _lastIndex;
+  trailer.nchunks = _nchunks;
+  trailer.magic   = TrailerMagic;
+  _write(&trailer, sizeof(trailer));
+  fflush(_file);
+}
+
+void VmonColumnWriter::_write(const void* p, unsigned len)
+{
+  ::fwrite(p, len, 1, _file);
+  _size += len;
+}
+
+void VmonColumnWriter::_chunk()
+{
+  if (!_nrecords) return;
+
+  //  Column c of the rows starts at its row offset times the records
+  unsigned offset = 0;
+  for(unsigned c=0; c<_column.size(); c++) {
+    unsigned size = _column[c];
+    char*       dst = _columns + offset*_nrecords;
+    const char* src = _rows    + offset;
+    for(unsigned r=0; r<_nrecords; r++, dst+=size, src+=_rowLength)
+      memcpy(dst, src, size);
+    offset += size;
+  }
+
+  ChunkHeader header;
+  header.magic    = ChunkMagic;
+  header.nrecords = _nrecords;
+  header.length   = sizeof(header) + _nrecords*(sizeof(ClockTime)+_rowLength);
+  header.first    = _times[0];
+  header.last     = _times[_nrecords-1];
+
+  IndexEntry entry;
+  entry.first    = header.first;
+  entry.last     = header.last;
+  entry.offset   = _size;
+  entry.nrecords = _nrecords;
+  entry.reserved = 0;
+  _entries.push_back(entry);
+
+  _write(&header, sizeof(header));
+  _write(_times, _nrecords*sizeof(ClockTime));
+  _write(_columns, _nrecords*_rowLength);
+
+  _nrecords = 0;
+  _nchunks++;
+
+  if (_entries.size() == IndexInterval)
+    _index();
+}
+
+void VmonColumnWriter::_index()
+{
+  IndexHeader header;
+  header.magic    = IndexMagic;
+  header.nchunks  = _entries.size();
+  header.previous = _lastIndex;
+
+  _lastIndex = _size;
+  _write(&header, sizeof(header));
+  _write(&_entries[0], _entries.size()*sizeof(IndexEntry));
+  _entries.clear();
+  fflush(_file);
+}
+
+int VmonColumnWriter::convert(FILE* input, FILE* output)
+{
+  char* buff = new char[VmonRecord::MaxLength];
+  VmonRecord* record = new (buff) VmonRecord;
+  if (fread(buff, sizeof(VmonRecord), 1, input)!=1 ||
+      record->len() <= int(sizeof(VmonRecord)) ||
+      record->len() > VmonRecord::MaxLength ||
+      fread(record+1, record->len()-sizeof(VmonRecord), 1, input)!=1) {
+    delete[] buff;
+    return -1;
+  }
+
+  VmonColumnWriter writer(output, *record);
+
+  int n=0;
+  while(fread(buff, sizeof(VmonRecord), 1, input)==1) {
+    if (record->len() < int(sizeof(VmonRecord)) ||
+        record->len() > VmonRecord::MaxLength) {
+      printf("VmonColumnWriter: bad record length %d after %d records\n", record->len(), n);
+      break;
+    }
+    unsigned remaining = record->len()-sizeof(VmonRecord);
+    if (remaining && fread(record+1, remaining, 1, input)!=1) {
+      printf("VmonColumnWriter: incomplete record after %d records\n", n);
+      break;
+    }
+    writer.append(*record);
+    n++;
+  }
+
+  writer.close();
+  delete[] buff;
+  return n;
+}
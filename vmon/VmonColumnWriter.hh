@@ -0,0 +1,56 @@
+#ifndef Pds_VmonColumnWriter_hh
+#define Pds_VmonColumnWriter_hh
+
+#include "pds/vmon/VmonColumns.hh"
+
+#include <stdio.h>
+
+#include <vector>
+
+namespace Pds {
+
+  class VmonRecord;
+
+  //
+  //  Writes vmon records in the indexed format (see VmonColumns.hh).
+  //  Payload records are gathered into a chunk, which is transposed into
+  //  columns when full.
+  //
+  class VmonColumnWriter {
+  public:
+    //  Writes the file header and the description
+    VmonColumnWriter(FILE*, VmonRecord& description);
+    ~VmonColumnWriter();
+  public:
+    void append(const VmonRecord& payload);
+    //  Writes the last chunk, its index and the trailer; the file is left open
+    void close ();
+  public:
+    unsigned long long size() const { return _size; }
+  public:
+    //  Rewrites a recording of the flat format; returns the number of
+    //  payload records, or -1 if the input has no description
+    static int convert(FILE* flat, FILE* indexed);
+  private:
+    void _write(const void*, unsigned);
+    void _chunk();
+    void _index();
+  private:
+    FILE*                 _file;
+    unsigned long long    _size;
+    std::vector<unsigned> _column;    // size of each column
+    unsigned              _rowLength;
+    unsigned              _chunkRecords;
+    //  the chunk under construction
+    char*                 _rows;
+    ClockTime*            _times;
+    unsigned              _nrecords;
+    char*                 _columns;
+    //  the chunks since the last index
+    std::vector<VmonColumns::IndexEntry> _entries;
+    unsigned long long    _lastIndex;
+    unsigned              _nchunks;
+  };
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef Pds_VmonColumns_hh
+#define Pds_VmonColumns_hh
+
+#include "pdsdata/xtc/ClockTime.hh"
+
+#include <stdint.h>
+
+namespace Pds {
+
+  //
+  //  The indexed (columnar) vmon recording format.  The file holds
+  //
+  //    FileHeader
+  //    the description record (VmonRecord::Description), as in the flat format
+  //    uint32_t size[ncolumns]           // of each entry's stats
+  //    { Chunk | Index }...
+  //    Trailer                           // if the file was closed
+  //
+  //  A chunk holds up to chunkRecords payload records, by column:
+  //
+  //    ChunkHeader
+  //    ClockTime time[nrecords]
+  //    nrecords x stats of column 0, nrecords x stats of column 1, ...
+  //
+  //  where the columns are the entries in the order of the payload record.
+  //  An index block follows every IndexInterval chunks, and the last chunk;
+  //  each lists the chunks since the previous one, which it points to, and
+  //  the trailer points to the last.  A file which was not closed is read
+  //  by stepping from chunk header to chunk header.
+  //
+  namespace VmonColumns {
+    enum { FileMagic    = 0x31434d56,   // "VMC1"
+           ChunkMagic   = 0x4b434d56,   // "VMCK"
+           IndexMagic   = 0x58434d56,   // "VMCX"
+           TrailerMagic = 0x54434d56 }; // "VMCT"
+    enum { Version = 1 };
+    enum { IndexInterval = 64 };
+    enum { ChunkBytes = 0x400000, MaxChunkRecords = 1024 };
+
+    class FileHeader {
+    public:
+      uint32_t magic;
+      uint32_t version;
+      uint32_t chunkRecords;
+      uint32_t ncolumns;
+    };
+
+    class ChunkHeader {
+    public:
+      uint32_t  magic;
+      uint32_t  nrecords;
+      uint64_t  length;     // including this header
+      ClockTime first;
+      ClockTime last;
+    };
+
+    class IndexHeader {
+    public:
+      uint32_t magic;
+      uint32_t nchunks;
+      uint64_t previous;    // file offset of the previous index, or 0
+    };
+
+    class IndexEntry {
+    public:
+      ClockTime first;
+      ClockTime last;
+      uint64_t  offset;     // file offset of the chunk
+      uint32_t  nrecords;
+      uint32_t  reserved;
+    };
+
+    class Trailer {
+    public:
+      uint64_t index;       // file offset of the last index
+      uint32_t nchunks;
+      uint32_t magic;
+    };
+  };
+};
+
+#endif
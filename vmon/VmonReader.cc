@@ -1,6 +1,7 @@
 #include "VmonReader.hh"
 
 #include "pds/vmon/VmonRecord.hh"
+#include "pds/vmon/VmonColumnReader.hh"
 #include "pds/mon/MonGroup.hh"
 #include "pds/mon/MonEntry.hh"
 #include "pds/mon/MonDescEntry.hh"
@@ -13,10 +14,16 @@
 using namespace Pds;
 
 VmonReader::VmonReader(const char* name) :
-  _buff(new char[VmonRecord::MaxLength])
+  _buff(new char[VmonRecord::MaxLength]),
+  _columns(0)
 {
   _file = fopen(name,"r");
 
+  if (VmonColumnReader::valid(_file)) {
+    _columns = new VmonColumnReader(_file);
+    return;
+  }
+
   fread(_buff,sizeof(VmonRecord),1,_file);
   VmonRecord* record = new (_buff) VmonRecord;
   unsigned size = record->len()-sizeof(VmonRecord);
@@ -58,6 +65,7 @@ VmonReader::VmonReader(const char* name) :
 VmonReader::~VmonReader()
 {
   reset();
+  delete _columns;
 
   for(vector<MonCds*>::iterator it = _cds.begin(); it!=_cds.end(); it++)
     delete *it;
@@ -66,10 +74,15 @@ VmonReader::~VmonReader()
     delete[] *it;
 }
 
-const vector<Src>& VmonReader::sources() const { return _src; }
+const vector<Src>& VmonReader::sources() const 
+{
+  return _columns ? _columns->sources() : _src; 
+}
 
 const MonCds* VmonReader::cds(const Src& src) const
 {
+  if (_columns) return _columns->cds(src);
+
   int i=0;
   for(vector<Src>::const_iterator it=_src.begin(); it!=_src.end(); it++, i++)
     if (src == *it) 
@@ -77,11 +90,13 @@ const MonCds* VmonReader::cds(const Src& src) const
   return 0;
 }
 
-const ClockTime& VmonReader::begin() const { return _begin; }
-const ClockTime& VmonReader::end  () const { return _end  ; }
+const ClockTime& VmonReader::begin() const { return _columns ? _columns->begin() : _begin; }
+const ClockTime& VmonReader::end  () const { return _columns ? _columns->end  () : _end  ; }
 
 void VmonReader::reset()
 {
+  if (_columns) _columns->reset();
+
   for(vector<int*>::iterator it=_req_off.begin(); it!=_req_off.end(); it++)
     delete[] *it;
   _req_off.clear();
@@ -91,6 +106,11 @@ void VmonReader::reset()
 
 void VmonReader::use(const Src& src, const MonUsage& usage)
 {
+  if (_columns) {
+    _columns->use(src, usage);
+    return;
+  }
+
   if (!usage.used()) return;
 
   int i=0;
@@ -125,10 +145,16 @@ void VmonReader::process(VmonReaderCallback& callback,
 			 const ClockTime& begin,
 			 const ClockTime& end)
 {
+  if (_columns) {
+    _columns->process(callback, begin, end);
+    return;
+  }
+
   bool lfirst = true;  // first record is often incomplete/corrupt
   fseek(_file, _seek_pos, SEEK_SET);
   while( !feof(_file) ) {
-    fread(_buff, sizeof(VmonRecord), 1, _file);
+    if (fread(_buff, sizeof(VmonRecord), 1, _file)!=1)
+      break;  // else the last record is processed again
     VmonRecord& record = *new(_buff) VmonRecord;
     int remaining = record.len() - sizeof(record);
     if (record.time() > end)
@@ -169,6 +195,8 @@ void VmonReader::process(VmonReaderCallback& callback,
 unsigned         VmonReader::nrecords(const ClockTime& begin,
 				      const ClockTime& end) const
 {
+  if (_columns) return _columns->nrecords(begin, end);
+
   unsigned n=0;
   unsigned nbytes = _seek_pos;
   fseek(_file, _seek_pos, SEEK_SET);
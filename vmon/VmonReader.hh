@@ -17,6 +17,7 @@ namespace Pds {
   class MonStats2D;
   class MonUsage;
   class MonCds;
+  class VmonColumnReader;
 
   class VmonReaderCallback {
   public:
@@ -37,6 +38,10 @@ namespace Pds {
     virtual void end_record() {}
   };
 
+  //
+  //  Reads vmon records of the flat format, which are scanned from the
+  //  start of the file, or of the indexed format (see VmonColumns.hh).
+  //
   class VmonReader {
   public:
     VmonReader(const char* name);
@@ -59,6 +64,7 @@ namespace Pds {
   private:
     char*                _buff;
     FILE*                _file;
+    VmonColumnReader*    _columns;  // the indexed format
     //  contents
     std::vector<Src>       _src;
     std::vector<MonCds*>   _cds;
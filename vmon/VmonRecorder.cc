@@ -1,6 +1,7 @@
 #include "pds/vmon/VmonRecorder.hh"
 
 #include "pds/vmon/VmonRecord.hh"
+#include "pds/vmon/VmonColumnWriter.hh"
 #include "pds/mon/MonClient.hh"
 
 #include <stdio.h>
@@ -10,7 +11,8 @@
 using namespace Pds;
 
 VmonRecorder::VmonRecorder(const char* root, 
-                           const char* base) :
+                           const char* base,
+                           Format      format) :
   _state  (Disabled),
   _dbuff  (new char[VmonRecord::MaxLength]),
   _pbuff  (new char[VmonRecord::MaxLength]),
@@ -19,7 +21,9 @@ VmonRecorder::VmonRecorder(const char* root,
   _root   (root),
   _base   (base),
   _size   (0),
-  _output (0)
+  _output (0),
+  _format (format),
+  _writer (0)
 {
   sprintf(_path,"%s/",root);
 }
@@ -111,6 +115,11 @@ void VmonRecorder::flush()
 
 void VmonRecorder::_flush(const VmonRecord* record)
 {
+  if (_writer) {
+    _writer->append(*record);
+    _size = _writer->size();
+    return;
+  }
   ::fwrite(record,record->len(),1,_output);
   _size += record->len();
 }
@@ -136,10 +145,21 @@ void VmonRecorder::_open(int n)
 
   
   _drecord->time(ctime);
-  _flush(_drecord);
+  if (_format==Indexed) {
+    _writer = new VmonColumnWriter(_output, *_drecord);
+    _size   = _writer->size();
+  }
+  else
+    _flush(_drecord);
 }
 
 void VmonRecorder::_close()
 {
+  if (_writer) {
+    _writer->close();
+    _size = _writer->size();
+    delete _writer;
+    _writer = 0;
+  }
   ::fclose(_output);
 }
@@ -10,11 +10,16 @@ namespace Pds {
 
   class MonClient;
   class VmonRecord;
+  class VmonColumnWriter;
 
   class VmonRecorder {
   public:
+    //  Indexed files are read by time range or entry without scanning
+    //  (see VmonColumns.hh); VmonReader reads either.
+    enum Format { Flat, Indexed };
     VmonRecorder(const char* root=".",
-                 const char* base="vmon");
+                 const char* base="vmon",
+                 Format      format=Flat);
     ~VmonRecorder();
   public:
     void enable();
@@ -51,6 +56,8 @@ namespace Pds {
     unsigned _size;
     FILE*    _output;
     bool     _persistent;
+    Format            _format;
+    VmonColumnWriter* _writer;
   };
 };
 
@@ -1,12 +1,24 @@
 libnames := vmon
 
-libsrcs_vmon := $(filter-out vmonreaderdump.cc, $(wildcard *.cc))
+libsrcs_vmon := $(filter-out vmonreaderdump.cc vmonconvert.cc vmonreadbench.cc, $(wildcard *.cc))
 libincs_vmon := pdsdata/include ndarray/include boost/include
 
-tgtnames := vmonreaderdump
+tgtnames := vmonreaderdump vmonconvert vmonreadbench
 
 tgtsrcs_vmonreaderdump += vmonreaderdump.cc
 tgtlibs_vmonreaderdump := pds/vmon pds/mon pds/service pds/collection 
 tgtlibs_vmonreaderdump += pdsdata/xtcdata
 tgtslib_vmonreaderdump := $(USRLIBDIR)/rt
 tgtincs_vmonreaderdump := pdsdata/include
+
+tgtsrcs_vmonconvert := vmonconvert.cc
+tgtlibs_vmonconvert := pds/vmon pds/mon pds/service pds/collection
+tgtlibs_vmonconvert += pdsdata/xtcdata
+tgtslib_vmonconvert := $(USRLIBDIR)/rt
+tgtincs_vmonconvert := pdsdata/include
+
+tgtsrcs_vmonreadbench := vmonreadbench.cc
+tgtlibs_vmonreadbench := pds/vmon pds/mon pds/service pds/collection
+tgtlibs_vmonreadbench += pdsdata/xtcdata
+tgtslib_vmonreadbench := $(USRLIBDIR)/rt $(USRLIBDIR)/pthread
+tgtincs_vmonreadbench := pdsdata/include
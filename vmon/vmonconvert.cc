@@ -0,0 +1,62 @@
+//
+//  Converts a vmon recording of the flat format into the indexed format
+//  (see VmonColumns.hh).
+//
+#include "pds/vmon/VmonColumnWriter.hh"
+#include "pds/vmon/VmonColumnReader.hh"
+
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+using namespace Pds;
+
+static void usage(const char* p)
+{
+  printf("Usage: %s -f <flat input> -o <indexed output>\n", p);
+}
+
+int main(int argc, char** argv)
+{
+  const char* iname=0;
+  const char* oname=0;
+  int c;
+  while ((c = getopt(argc, argv, "f:o:h")) != -1) {
+    switch(c) {
+    case 'f': iname = optarg; break;
+    case 'o': oname = optarg; break;
+    default : usage(argv[0]); exit(1);
+    }
+  }
+
+  if (!iname || !oname) {
+    usage(argv[0]);
+    exit(1);
+  }
+
+  FILE* input = fopen(iname,"r");
+  if (!input) {
+    perror("Opening input");
+    exit(1);
+  }
+  if (VmonColumnReader::valid(input)) {
+    printf("%s is already indexed\n", iname);
+    exit(1);
+  }
+
+  FILE* output = fopen(oname,"w");
+  if (!output) {
+    perror("Opening output");
+    exit(1);
+  }
+
+  int n = VmonColumnWriter::convert(input, output);
+  if (n < 0)
+    printf("%s has no description\n", iname);
+  else
+    printf("Wrote %d records, %ld bytes\n", n, ftell(output));
+
+  fclose(output);
+  fclose(input);
+  return n < 0 ? 1 : 0;
+}
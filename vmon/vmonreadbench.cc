@@ -0,0 +1,190 @@
+//
+//  Time to read one entry over a time window from a vmon recording, in
+//  the flat and the indexed formats.  A run of synthetic clients is
+//  recorded with VmonRecorder and converted to the indexed format, and
+//  the same window is read from each with VmonReader; the stats read are
+//  compared.
+//
+#include "pds/vmon/VmonRecorder.hh"
+#include "pds/vmon/VmonReader.hh"
+#include "pds/vmon/VmonColumnWriter.hh"
+#include "pds/mon/MonClient.hh"
+#include "pds/mon/MonConsumerClient.hh"
+#include "pds/mon/MonSocket.hh"
+#include "pds/mon/MonCds.hh"
+#include "pds/mon/MonGroup.hh"
+#include "pds/mon/MonUsage.hh"
+#include "pds/mon/MonEntryTH1F.hh"
+#include "pds/mon/MonEntryScalar.hh"
+#include "pds/mon/MonDescTH1F.hh"
+#include "pds/mon/MonDescScalar.hh"
+#include "pds/mon/MonStats1D.hh"
+#include "pds/mon/MonStats2D.hh"
+#include "pds/mon/MonStatsScalar.hh"
+#include "pdsdata/xtc/ProcInfo.hh"
+
+#include <sys/stat.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+#include <string>
+#include <vector>
+
+using namespace Pds;
+
+static double now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return double(ts.tv_sec) + 1.e-9*double(ts.tv_nsec);
+}
+
+namespace Pds {
+  class NoConsumer : public MonConsumerClient {
+  public:
+    void process(MonClient&, Type, int) {}
+  };
+
+  class NoSocket : public MonSocket {
+  public:
+    int readv(const iovec*, int) { return 0; }
+  };
+
+  //  Sums what is read
+  class Summer : public VmonReaderCallback {
+  public:
+    Summer() : records(0), sum(0) {}
+    void process(const ClockTime& t, const Src&, int, const MonStatsScalar& s)
+    { sum += t.seconds() + 1.e-9*t.nanoseconds() + s.values()[0]; }
+    void process(const ClockTime& t, const Src&, int, const MonStats1D& s)
+    { sum += t.seconds() + 1.e-9*t.nanoseconds() + s.sum() + s.sumx(); }
+    void process(const ClockTime& t, const Src&, int, const MonStats2D& s)
+    { sum += t.seconds() + 1.e-9*t.nanoseconds() + s.sum(); }
+    void end_record() { records++; }
+  public:
+    unsigned records;
+    double   sum;
+  };
+};
+
+static void usage(const char* p)
+{
+  printf("Usage: %s [-n <records>] [-s <sources>] [-e <entries per source>] [-w <window fraction>] [-d <directory>]\n", p);
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned nrecords = 20000;
+  unsigned nsources = 8;
+  unsigned nentries = 40;
+  double   window   = 0.01;
+  const char* dir   = "/tmp";
+
+  int c;
+  while ((c = getopt(argc, argv, "n:s:e:w:d:h")) != -1) {
+    switch(c) {
+    case 'n': nrecords = strtoul(optarg,NULL,0); break;
+    case 's': nsources = strtoul(optarg,NULL,0); break;
+    case 'e': nentries = strtoul(optarg,NULL,0); break;
+    case 'w': window   = strtod (optarg,NULL);   break;
+    case 'd': dir      = optarg; break;
+    default : usage(argv[0]); return 1;
+    }
+  }
+
+  NoConsumer consumer;
+  NoSocket   socket;
+  std::vector<MonClient*>      clients;
+  std::vector<MonEntryTH1F*>   th1f;
+  std::vector<MonEntryScalar*> scalars;
+  for(unsigned s=0; s<nsources; s++) {
+    MonCds* cds = new MonCds("bench");
+    MonGroup* group = new MonGroup("group");
+    cds->add(group);
+    for(unsigned e=0; e<nentries; e++) {
+      char name[32];
+      sprintf(name,"entry%u",e);
+      if (e&1) {
+        scalars.push_back(new MonEntryScalar(MonDescScalar(name)));
+        group->add(scalars.back());
+      }
+      else {
+        th1f.push_back(new MonEntryTH1F(MonDescTH1F(name,"x","y",100,0.,100.)));
+        group->add(th1f.back());
+      }
+    }
+    clients.push_back(new MonClient(consumer, cds, socket, ProcInfo(Level::Source, 0, s)));
+  }
+
+  VmonRecorder recorder(dir, "vmonbench");
+  recorder.enable();
+  recorder.flush();
+  for(unsigned s=0; s<nsources; s++)
+    recorder.description(*clients[s]);
+  recorder.begin(-1);
+
+  for(unsigned r=0; r<nrecords; r++) {
+    for(unsigned i=0; i<th1f.size(); i++)
+      th1f[i]->addcontent(1., unsigned(random()%100));
+    for(unsigned i=0; i<scalars.size(); i++)
+      scalars[i]->addvalue(1.);
+    recorder.flush();
+    for(unsigned s=0; s<nsources; s++)
+      recorder.payload(*clients[s]);
+  }
+  recorder.flush();
+  recorder.end();
+
+  std::string path[2];
+  path[0] = std::string(dir) + "/" + recorder.filename();
+  path[1] = path[0] + ".indexed";
+  { FILE* input  = fopen(path[0].c_str(),"r");
+    FILE* output = fopen(path[1].c_str(),"w");
+    double t0 = now();
+    VmonColumnWriter::convert(input, output);
+    printf("converted in %.3f s\n", now()-t0);
+    fclose(output);
+    fclose(input); }
+
+  //  One entry of a source in the middle, over the last part of the run
+  MonUsage usage;
+  usage.use(2);
+  Src src = clients[nsources/2]->src();
+
+  bool lsame = true;
+  double sum[2];
+  unsigned records[2];
+  for(unsigned f=0; f<2; f++) {
+    struct stat64 st;
+    stat64(path[f].c_str(), &st);
+
+    double t0 = now();
+    VmonReader reader(path[f].c_str());
+    double t1 = now();
+    double b = reader.begin().seconds() + 1.e-9*reader.begin().nanoseconds();
+    double e = reader.end  ().seconds() + 1.e-9*reader.end  ().nanoseconds();
+    double w = e - window*(e-b);
+    ClockTime begin(unsigned(w), unsigned((w-unsigned(w))*1.e9));
+
+    reader.use(src, usage);
+    Summer summer;
+    reader.process(summer, begin, reader.end());
+    double t2 = now();
+    sum    [f] = summer.sum;
+    records[f] = summer.records;
+
+    printf("%-7s %10lld bytes: open %8.3f ms  window of %u records %8.3f ms\n",
+           f ? "indexed" : "flat", (long long)st.st_size,
+           1.e3*(t1-t0), summer.records, 1.e3*(t2-t1));
+  }
+  lsame = (sum[0]==sum[1] && records[0]==records[1]);
+  printf("%s\n", lsame ? "identical" : "DIFFERENT");
+
+  for(unsigned f=0; f<2; f++)
+    unlink(path[f].c_str());
+  for(unsigned s=0; s<nsources; s++)
+    delete clients[s];
+
+  return lsame ? 0 : 1;
+}